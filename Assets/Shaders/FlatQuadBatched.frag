@@ -1,4 +1,5 @@
 #version 450
+#extension GL_EXT_nonuniform_qualifier : require
 
 layout(location = 0) in vec3 fragColor;
 layout(location = 1) in vec2 texCoords;
@@ -6,6 +7,6 @@ layout(location = 2) in flat uint textureNumber;
 
 layout(location = 0) out vec4 outColor;
 
-layout(set = 1, binding = 0) uniform sampler2DArray textureArray;
+layout(set = 1, binding = 0) uniform sampler2D textures[];
 
-void main() { outColor = texture(textureArray, vec3(texCoords.xy, textureNumber)); }
\ No newline at end of file
+void main() { outColor = texture(textures[nonuniformEXT(textureNumber)], texCoords); }
\ No newline at end of file
@@ -0,0 +1,81 @@
+#version 450 core
+
+layout(location = 0) out vec3 fragColor;
+layout(location = 1) out vec2 outTexCoords;
+layout(location = 2) out flat uint textureNumber;
+
+layout(set = 0, binding = 0) uniform UniformBuffer
+{
+    mat4 model;
+    mat4 view;
+    mat4 projection;
+    float zoom;
+    float time;
+}
+
+ubo;
+
+layout(set = 0, binding = 1) readonly buffer positionBuffer { vec4 positions[]; };
+
+layout(set = 0, binding = 2) readonly buffer sizeBuffer { vec2 sizes[]; };
+
+layout(set = 0, binding = 3) readonly buffer textureIndexBuffer { uint textureIndices[]; };
+
+struct Animation
+{
+    uint startFrame;
+    uint frameCount;
+    float fps;
+    float startTime;
+};
+
+layout(set = 0, binding = 4) readonly buffer animationBuffer { Animation animations[]; };
+
+layout(set = 0, binding = 5) readonly buffer visibleIndexBuffer { uint visibleIndices[]; };
+
+uint getVertexID() { return gl_VertexIndex % 6u; }
+
+uint getCurrentQuadIndex() { return visibleIndices[gl_InstanceIndex]; }
+
+vec2 getVertex(uint vertexID, uint quadIndex)
+{
+    vec2 coords;
+    vec2 pos = positions[quadIndex].xy;
+    vec2 size = sizes[quadIndex];
+
+    vec2 vertices[6] = {vec2(pos.x, pos.y),
+                        vec2(pos.x + size.x, pos.y),
+                        vec2(pos.x + size.x, pos.y + size.y),
+                        vec2(pos.x + size.x, pos.y + size.y),
+                        vec2(pos.x, pos.y + size.y),
+                        vec2(pos.x, pos.y)};
+
+    return vec2(vertices[vertexID]);
+}
+
+vec2 getTextureCoord(uint vertexID)
+{
+    vec2 vertices[6] = {vec2(0, 0), vec2(1.0, 0), vec2(1.0, 1.0), vec2(1.0, 1.0), vec2(0, 1.0), vec2(0, 0)};
+
+    return vertices[vertexID];
+}
+
+uint getTextureNumber(uint quadIndex)
+{
+    Animation animation = animations[quadIndex];
+    if (animation.frameCount == 0u) { return textureIndices[quadIndex]; }
+
+    // Frames sit in consecutive texture slots, before its start time the animation holds the first one
+    uint frame = uint(max(ubo.time - animation.startTime, 0.0) * animation.fps);
+    return animation.startFrame + frame % animation.frameCount;
+}
+
+void main()
+{
+    uint index = getCurrentQuadIndex();
+    vec4 outPosition = ubo.projection * ubo.view * ubo.model * vec4(getVertex(getVertexID(), index), 0.0, 1.0);
+    gl_Position = outPosition;
+    fragColor = vec3(0, 0, 0);
+    outTexCoords = getTextureCoord(getVertexID());
+    textureNumber = getTextureNumber(index);
+}
\ No newline at end of file
@@ -0,0 +1,18 @@
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout(location = 0) in vec3 fragColor;
+layout(location = 1) in vec2 texCoords;
+layout(location = 2) in flat uint textureNumber;
+
+layout(location = 0) out vec4 outColor;
+
+layout(set = 1, binding = 0) uniform sampler2D textures[];
+
+void main()
+{
+    vec4 color = texture(textures[nonuniformEXT(textureNumber)], texCoords);
+    // Alpha tested texels either cover the quad behind them or leave no trace in the depth buffer
+    if (color.a < 0.5) { discard; }
+    outColor = vec4(color.rgb, 1.0);
+}
\ No newline at end of file
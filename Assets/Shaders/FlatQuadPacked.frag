@@ -0,0 +1,12 @@
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout(location = 0) in vec4 fragTint;
+layout(location = 1) in vec2 texCoords;
+layout(location = 2) in flat uint textureNumber;
+
+layout(location = 0) out vec4 outColor;
+
+layout(set = 1, binding = 0) uniform sampler2D textures[];
+
+void main() { outColor = fragTint * texture(textures[nonuniformEXT(textureNumber)], texCoords); }
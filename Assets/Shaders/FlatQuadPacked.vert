@@ -0,0 +1,65 @@
+#version 450 core
+
+layout(location = 0) out vec4 fragTint;
+layout(location = 1) out vec2 outTexCoords;
+layout(location = 2) out flat uint textureNumber;
+
+layout(set = 0, binding = 0) uniform UniformBuffer
+{
+    mat4 model;
+    mat4 view;
+    mat4 projection;
+    float zoom;
+}
+
+ubo;
+
+// position.xy, half2 size, texture slot in the low half and RGBA4444 tint in the high half of the last word
+struct PackedQuad {
+    vec2 position;
+    uint size;
+    uint textureTint;
+};
+
+layout(set = 0, binding = 1) readonly buffer instanceBuffer { PackedQuad instances[]; };
+
+uint getVertexID() { return gl_VertexIndex % 6u; }
+
+uint getCurrentQuadIndex() { return gl_InstanceIndex; }
+
+vec2 getVertex(uint vertexID, PackedQuad quad)
+{
+    vec2 pos = quad.position;
+    vec2 size = unpackHalf2x16(quad.size);
+
+    vec2 vertices[6] = {vec2(pos.x, pos.y),
+                        vec2(pos.x + size.x, pos.y),
+                        vec2(pos.x + size.x, pos.y + size.y),
+                        vec2(pos.x + size.x, pos.y + size.y),
+                        vec2(pos.x, pos.y + size.y),
+                        vec2(pos.x, pos.y)};
+
+    return vec2(vertices[vertexID]);
+}
+
+vec2 getTextureCoord(uint vertexID)
+{
+    vec2 vertices[6] = {vec2(0, 0), vec2(1.0, 0), vec2(1.0, 1.0), vec2(1.0, 1.0), vec2(0, 1.0), vec2(0, 0)};
+
+    return vertices[vertexID];
+}
+
+vec4 unpackTint(uint tint)
+{
+    return vec4(tint & 0xFu, (tint >> 4) & 0xFu, (tint >> 8) & 0xFu, (tint >> 12) & 0xFu) / 15.0;
+}
+
+void main()
+{
+    PackedQuad quad = instances[getCurrentQuadIndex()];
+    vec4 outPosition = ubo.projection * ubo.view * ubo.model * vec4(getVertex(getVertexID(), quad), 0.0, 1.0);
+    gl_Position = outPosition;
+    fragTint = unpackTint(quad.textureTint >> 16);
+    outTexCoords = getTextureCoord(getVertexID());
+    textureNumber = quad.textureTint & 0xFFFFu;
+}
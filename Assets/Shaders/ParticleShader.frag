@@ -6,7 +6,7 @@ layout(location = 2) in flat float life;
 
 layout(location = 0) out vec4 outColor;
 
-layout(set = 0, binding = 4) uniform sampler2D particleTexture;
+layout(set = 1, binding = 0) uniform sampler2D particleTexture;
 
 void main()
 {
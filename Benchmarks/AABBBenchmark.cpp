@@ -0,0 +1,169 @@
+#include <LunaraEngine/Physics/BatchCollisions.hpp>
+#include <glm/glm.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace LunaraEngine;
+
+namespace
+{
+    constexpr size_t BOX_COUNT = 100'000;
+    constexpr size_t QUERY_COUNT = 64;
+    constexpr size_t PAIR_COUNT = 1'000'000;
+    constexpr size_t ITERATIONS = 16;
+    constexpr float WORLD_SIZE = 4096.0f;
+
+    template <typename F>
+    double Measure(F&& function)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < ITERATIONS; i++) { function(); }
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - begin).count() / (double) ITERATIONS;
+    }
+
+    // The per pair test RectCollisions::AABB does, boxes as a position with a size and a z threshold
+    bool RectAABB(const glm::vec3& a, float aWidth, float aHeight, const glm::vec3& b, float bWidth, float bHeight)
+    {
+        const float Z_THRESHOLD = 0.1f;
+        return (a.x < b.x + bWidth && a.x + aWidth > b.x && a.y < b.y + bHeight && a.y + aHeight > b.y) &&
+               std::fabs(a.z - b.z) < Z_THRESHOLD;
+    }
+
+    struct Scene {
+        std::vector<glm::vec3> positions;
+        std::vector<glm::vec2> sizes;
+        AABBBatch batch;
+        std::vector<AABB> queries;
+        std::vector<BroadphasePair> pairs;
+    };
+
+    // Boxes are created row by row so pairs of close indices overlap about as often as broadphase candidates do
+    Scene CreateScene()
+    {
+        std::mt19937 random(42);
+        std::uniform_real_distribution<float> jitter(-16.0f, 16.0f);
+        std::uniform_real_distribution<float> size(8.0f, 64.0f);
+        std::uniform_real_distribution<float> position(0.0f, WORLD_SIZE);
+        std::uniform_int_distribution<uint32_t> neighbour(1, 8);
+
+        Scene scene;
+        const size_t columns = (size_t) std::sqrt((double) BOX_COUNT);
+        const float spacing = WORLD_SIZE / (float) columns;
+        for (size_t i = 0; i < BOX_COUNT; i++)
+        {
+            glm::vec2 min{(float) (i % columns) * spacing + jitter(random),
+                          (float) (i / columns) * spacing + jitter(random)};
+            glm::vec2 extent{size(random), size(random)};
+            scene.positions.push_back({min.x, min.y, 0.0f});
+            scene.sizes.push_back(extent);
+            scene.batch.Push({min, min + extent});
+        }
+        for (size_t i = 0; i < QUERY_COUNT; i++)
+        {
+            glm::vec2 min{position(random), position(random)};
+            scene.queries.push_back({min, min + glm::vec2{256.0f, 256.0f}});
+        }
+        for (size_t i = 0; i < PAIR_COUNT; i++)
+        {
+            auto a = (uint32_t) (i % (BOX_COUNT - 8));
+            scene.pairs.push_back({a, a + neighbour(random)});
+        }
+        return scene;
+    }
+
+    struct Result {
+        double oneMs{};
+        double pairsMs{};
+        size_t hits{};
+        size_t pairHits{};
+    };
+
+    Result RunPerPair(const Scene& scene)
+    {
+        Result result;
+        std::vector<uint32_t> hits;
+        result.oneMs = Measure([&]() {
+            result.hits = 0;
+            for (const AABB& query: scene.queries)
+            {
+                hits.clear();
+                glm::vec3 position{query.min.x, query.min.y, 0.0f};
+                glm::vec2 size = query.max - query.min;
+                for (size_t i = 0; i < BOX_COUNT; i++)
+                {
+                    if (RectAABB(position, size.x, size.y, scene.positions[i], scene.sizes[i].x, scene.sizes[i].y))
+                    {
+                        hits.push_back((uint32_t) i);
+                    }
+                }
+                result.hits += hits.size();
+            }
+        });
+
+        std::vector<BroadphasePair> pairHits;
+        result.pairsMs = Measure([&]() {
+            pairHits.clear();
+            for (const BroadphasePair& pair: scene.pairs)
+            {
+                if (RectAABB(scene.positions[pair.a], scene.sizes[pair.a].x, scene.sizes[pair.a].y,
+                             scene.positions[pair.b], scene.sizes[pair.b].x, scene.sizes[pair.b].y))
+                {
+                    pairHits.push_back(pair);
+                }
+            }
+            result.pairHits = pairHits.size();
+        });
+        return result;
+    }
+
+    Result RunBatch(const Scene& scene, SimdLevel level)
+    {
+        BatchCollisions::SetSimdLevel(level);
+
+        Result result;
+        std::vector<uint32_t> hits;
+        result.oneMs = Measure([&]() {
+            result.hits = 0;
+            for (const AABB& query: scene.queries) { result.hits += BatchCollisions::Overlap(query, scene.batch, hits); }
+        });
+
+        std::vector<BroadphasePair> pairHits;
+        result.pairsMs = Measure(
+                [&]() { result.pairHits = BatchCollisions::OverlapPairs(scene.batch, scene.pairs, pairHits); });
+        return result;
+    }
+
+    void Report(const char* name, const Result& result, const Result& baseline)
+    {
+        std::printf("%-10s one vs N %8.3f ms (%.2fx) | pairs %8.3f ms (%.2fx) | %zu and %zu hits\n", name,
+                    result.oneMs, baseline.oneMs / result.oneMs, result.pairsMs, baseline.pairsMs / result.pairsMs,
+                    result.hits, result.pairHits);
+    }
+}// namespace
+
+int main()
+{
+    std::printf("%zu queries against %zu boxes and %zu candidate pairs, average of %zu runs\n", QUERY_COUNT, BOX_COUNT,
+                PAIR_COUNT, ITERATIONS);
+
+    Scene scene = CreateScene();
+    Result perPair = RunPerPair(scene);
+    Report("Per pair", perPair, perPair);
+
+    const SimdLevel supported = BatchCollisions::GetSupportedSimdLevel();
+    const char* names[] = {"Scalar", "SSE", "AVX2"};
+    for (SimdLevel level: {SimdLevel::Scalar, SimdLevel::SSE, SimdLevel::AVX2})
+    {
+        if (level > supported)
+        {
+            std::printf("%-10s not supported\n", names[(size_t) level]);
+            continue;
+        }
+        Report(names[(size_t) level], RunBatch(scene, level), perPair);
+    }
+    return 0;
+}
@@ -0,0 +1,132 @@
+#include <LunaraEngine/Renderer/ParticlePool.hpp>
+#include <glm/glm.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace LunaraEngine;
+
+namespace
+{
+    constexpr size_t CAPACITY = size_t{1} << 17;
+    constexpr size_t ALIVE = 100'000;
+    constexpr size_t ITERATIONS = 256;
+    constexpr size_t EMITS = 16;
+    constexpr float DT = 1.0f / 60.0f;
+    constexpr ParticleForces FORCES{.wind = {1.5f, -1.0f}, .drag = 0.0004f, .speed = 350.0f};
+
+    template <typename F>
+    double Measure(F&& function)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < ITERATIONS; i++) { function(); }
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - begin).count() / (double) ITERATIONS;
+    }
+
+    // Lifes are spread so particles keep dying throughout the measured frames
+    std::vector<float> CreateLifes()
+    {
+        std::mt19937 random(42);
+        std::uniform_real_distribution<float> life(1.0f, 8.0f);
+        std::vector<float> lifes(ALIVE);
+        for (auto& value: lifes) { value = life(random); }
+        return lifes;
+    }
+
+    // The previous layout, slots are scanned for a dead one on every emission and the update visits all of them
+    struct SlotParticles {
+        std::vector<glm::vec2> positions = std::vector<glm::vec2>(CAPACITY);
+        std::vector<glm::vec2> velocities = std::vector<glm::vec2>(CAPACITY);
+        std::vector<float> lifes = std::vector<float>(CAPACITY);
+        std::vector<uint32_t> aliveIndices = std::vector<uint32_t>(CAPACITY);
+
+        void Emit(glm::vec2 position, glm::vec2 velocity, float life)
+        {
+            auto slot = std::ranges::find_if(lifes, [](float value) { return value <= 0.0f; });
+            if (slot == lifes.end()) { return; }
+            auto index = (size_t) std::distance(lifes.begin(), slot);
+            positions[index] = position;
+            velocities[index] = velocity;
+            lifes[index] = life;
+        }
+
+        size_t Update()
+        {
+            for (size_t id = 0; id < CAPACITY; id++)
+            {
+                if (lifes[id] <= 0.0f) { continue; }
+                positions[id] += velocities[id] * FORCES.speed * DT;
+                velocities[id] += FORCES.wind * DT;
+                velocities[id] *= 1.0f - FORCES.drag;
+                lifes[id] -= DT;
+            }
+            size_t alive = 0;
+            for (size_t id = 0; id < CAPACITY; id++)
+            {
+                if (lifes[id] > 0.0f) { aliveIndices[alive++] = (uint32_t) id; }
+            }
+            return alive;
+        }
+    };
+
+    struct Result {
+        double updateMs{};
+        double emitMs{};
+        size_t alive{};
+    };
+
+    Result RunSlots(const std::vector<float>& lifes)
+    {
+        SlotParticles particles;
+        for (float life: lifes) { particles.Emit({0.0f, 0.0f}, {0.0f, -1.0f}, life); }
+
+        // Emission cost grows with the number of occupied slots in front of the first free one
+        Result result;
+        result.emitMs = Measure([&]() {
+            for (size_t i = 0; i < EMITS; i++) { particles.Emit({0.0f, 0.0f}, {0.0f, -1.0f}, 1.0f); }
+        });
+        result.updateMs = Measure([&]() { result.alive = particles.Update(); });
+        return result;
+    }
+
+    Result RunPool(const std::vector<float>& lifes)
+    {
+        ParticlePool pool(CAPACITY);
+        for (float life: lifes) { pool.Emit({0.0f, 0.0f}, {0.0f, -1.0f}, life); }
+
+        Result result;
+        result.emitMs = Measure([&]() {
+            for (size_t i = 0; i < EMITS; i++) { pool.Emit({0.0f, 0.0f}, {0.0f, -1.0f}, 1.0f); }
+        });
+        result.updateMs = Measure([&]() {
+            pool.Integrate(DT, FORCES);
+            pool.RemoveDead();
+            result.alive = pool.GetCount();
+        });
+        return result;
+    }
+
+    void Report(const char* name, const Result& result)
+    {
+        std::printf("%-12s update %7.3f ms | %zu emits %8.4f ms | %zu alive after the last frame\n", name,
+                    result.updateMs, EMITS, result.emitMs, result.alive);
+    }
+}// namespace
+
+int main()
+{
+    std::printf("Particle update, %zu alive of %zu, average of %zu frames\n", ALIVE, CAPACITY, ITERATIONS);
+
+    auto lifes = CreateLifes();
+    Result slots = RunSlots(lifes);
+    Result pool = RunPool(lifes);
+
+    Report("Slot scan", slots);
+    Report("Dense pool", pool);
+    std::printf("Dense pool update %.2fx, emission %.2fx\n", slots.updateMs / pool.updateMs,
+                slots.emitMs / pool.emitMs);
+    return 0;
+}
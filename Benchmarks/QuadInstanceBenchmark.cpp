@@ -0,0 +1,154 @@
+#include <LunaraEngine/Renderer/QuadInstance.hpp>
+#include <glm/glm.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include <random>
+
+using namespace LunaraEngine;
+
+namespace
+{
+    constexpr size_t QUAD_COUNT = size_t{1} << 20;
+    constexpr size_t ITERATIONS = 32;
+
+    struct SeparateQuads {
+        std::vector<glm::vec4> positions;
+        std::vector<glm::vec2> sizes;
+        std::vector<uint32_t> textureIndices;
+    };
+
+    struct Source {
+        std::vector<glm::vec3> positions;
+        std::vector<glm::vec2> sizes;
+        std::vector<uint32_t> textureIndices;
+    };
+
+    struct Result {
+        double buildMs{};
+        double uploadMs{};
+        double fetchMs{};
+        float checksum{};
+    };
+
+    template <typename F>
+    double Measure(F&& function)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < ITERATIONS; i++) { function(); }
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - begin).count() / (double) ITERATIONS;
+    }
+
+    Source CreateSource()
+    {
+        std::mt19937 random(42);
+        std::uniform_real_distribution<float> position(0.0f, 8192.0f);
+        std::uniform_int_distribution<uint32_t> texture(0, 63);
+
+        Source source;
+        source.positions.resize(QUAD_COUNT);
+        source.sizes.resize(QUAD_COUNT);
+        source.textureIndices.resize(QUAD_COUNT);
+        for (size_t i = 0; i < QUAD_COUNT; i++)
+        {
+            source.positions[i] = glm::vec3{position(random), position(random), 0.0f};
+            source.sizes[i] = glm::vec2{32.0f, 32.0f};
+            source.textureIndices[i] = texture(random);
+        }
+        return source;
+    }
+
+    // Reads every instance the way the vertex shader does and reduces the quad corners,
+    // the checksum keeps the loop from being optimized away
+    Result RunSeparate(const Source& source, std::vector<uint8_t>& mapped)
+    {
+        SeparateQuads quads;
+        quads.positions.resize(QUAD_COUNT);
+        quads.sizes.resize(QUAD_COUNT);
+        quads.textureIndices.resize(QUAD_COUNT);
+
+        Result result;
+        result.buildMs = Measure([&]() {
+            for (size_t i = 0; i < QUAD_COUNT; i++)
+            {
+                quads.positions[i] = glm::vec4{source.positions[i], 0.0f};
+                quads.sizes[i] = source.sizes[i];
+                quads.textureIndices[i] = source.textureIndices[i];
+            }
+        });
+        result.uploadMs = Measure([&]() {
+            uint8_t* dst = mapped.data();
+            std::memcpy(dst, quads.positions.data(), QUAD_COUNT * sizeof(glm::vec4));
+            dst += QUAD_COUNT * sizeof(glm::vec4);
+            std::memcpy(dst, quads.sizes.data(), QUAD_COUNT * sizeof(glm::vec2));
+            dst += QUAD_COUNT * sizeof(glm::vec2);
+            std::memcpy(dst, quads.textureIndices.data(), QUAD_COUNT * sizeof(uint32_t));
+        });
+        result.fetchMs = Measure([&]() {
+            float sum = 0.0f;
+            for (size_t i = 0; i < QUAD_COUNT; i++)
+            {
+                glm::vec2 corner = glm::vec2(quads.positions[i]) + quads.sizes[i];
+                sum += corner.x + corner.y + (float) quads.textureIndices[i];
+            }
+            result.checksum += sum;
+        });
+        return result;
+    }
+
+    Result RunPacked(const Source& source, std::vector<uint8_t>& mapped)
+    {
+        std::vector<PackedQuadInstance> quads(QUAD_COUNT);
+
+        Result result;
+        result.buildMs = Measure([&]() {
+            for (size_t i = 0; i < QUAD_COUNT; i++)
+            {
+                quads[i] = PackedQuadInstance::Pack(source.positions[i], source.sizes[i], source.textureIndices[i]);
+            }
+        });
+        result.uploadMs = Measure(
+                [&]() { std::memcpy(mapped.data(), quads.data(), QUAD_COUNT * sizeof(PackedQuadInstance)); });
+        result.fetchMs = Measure([&]() {
+            float sum = 0.0f;
+            for (size_t i = 0; i < QUAD_COUNT; i++)
+            {
+                glm::vec2 corner = quads[i].position + quads[i].GetSize();
+                sum += corner.x + corner.y + (float) quads[i].GetTextureIndex();
+            }
+            result.checksum += sum;
+        });
+        return result;
+    }
+
+    void Report(const char* name, size_t bytesPerQuad, size_t streams, const Result& result)
+    {
+        double megabytes = (double) (bytesPerQuad * QUAD_COUNT) / (1024.0 * 1024.0);
+        std::printf("%-9s %2zu bytes/quad, %zu stream(s), %7.2f MiB/frame | build %7.3f ms | upload %7.3f ms "
+                    "(%6.2f GiB/s) | fetch %7.3f ms (%6.2f GiB/s) | checksum %g\n",
+                    name, bytesPerQuad, streams, megabytes, result.buildMs, result.uploadMs,
+                    megabytes / 1024.0 / (result.uploadMs / 1000.0), result.fetchMs,
+                    megabytes / 1024.0 / (result.fetchMs / 1000.0), (double) result.checksum);
+    }
+}// namespace
+
+int main()
+{
+    std::printf("Quad instance layouts, %zu quads, average of %zu iterations\n", QUAD_COUNT, ITERATIONS);
+
+    Source source = CreateSource();
+    constexpr size_t separateBytes = sizeof(glm::vec4) + sizeof(glm::vec2) + sizeof(uint32_t);
+    std::vector<uint8_t> mapped(QUAD_COUNT * separateBytes);
+
+    Result separate = RunSeparate(source, mapped);
+    Result packed = RunPacked(source, mapped);
+
+    Report("Separate", separateBytes, 3, separate);
+    Report("Packed", sizeof(PackedQuadInstance), 1, packed);
+    std::printf("Packed moves %.1f%% of the separate bytes, upload %.2fx, fetch %.2fx\n",
+                100.0 * (double) sizeof(PackedQuadInstance) / (double) separateBytes,
+                separate.uploadMs / packed.uploadMs, separate.fetchMs / packed.fetchMs);
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include <LunaraEngine/Renderer/RadixSort.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace LunaraEngine;
+
+namespace
+{
+    constexpr size_t KEY_COUNT = 100'000;
+    constexpr size_t ITERATIONS = 64;
+    constexpr double TARGET_MS = 1.0;
+
+    template <typename F>
+    double Measure(F&& function)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < ITERATIONS; i++) { function(); }
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::milli>(end - begin).count() / (double) ITERATIONS;
+    }
+
+    // The sort BatchRenderer used before, four 8 bit passes over the whole key
+    void ByteRadixSort(std::span<const uint32_t> keys, std::vector<uint32_t>& indices)
+    {
+        static std::vector<uint64_t> scratch;
+        constexpr size_t BUCKETS = 256;
+        const size_t count = keys.size();
+        scratch.resize(count * 2);
+        std::span<uint64_t> src(scratch.data(), count);
+        std::span<uint64_t> dst(scratch.data() + count, count);
+
+        std::array<std::array<uint32_t, BUCKETS>, 4> histograms{};
+        for (size_t i = 0; i < count; i++)
+        {
+            src[i] = (uint64_t{keys[i]} << 32) | i;
+            for (size_t pass = 0; pass < 4; pass++) { ++histograms[pass][(keys[i] >> (pass * 8)) & (BUCKETS - 1)]; }
+        }
+
+        for (size_t pass = 0; pass < 4; pass++)
+        {
+            auto& histogram = histograms[pass];
+            if (std::ranges::find(histogram, (uint32_t) count) != histogram.end()) { continue; }
+
+            uint32_t sum = 0;
+            for (auto& bucket: histogram)
+            {
+                uint32_t bucketCount = bucket;
+                bucket = sum;
+                sum += bucketCount;
+            }
+
+            const size_t shift = 32 + pass * 8;
+            for (uint64_t entry: src) { dst[histogram[(entry >> shift) & (BUCKETS - 1)]++] = entry; }
+            std::swap(src, dst);
+        }
+
+        indices.resize(count);
+        for (size_t i = 0; i < count; i++) { indices[i] = (uint32_t) src[i]; }
+    }
+
+    // Keys laid out like BatchRenderer::MakeSortKey, the layer above 16 bits of depth
+    std::vector<uint32_t> CreateKeys(uint32_t layers, uint32_t depthBits)
+    {
+        std::mt19937 random(42);
+        std::uniform_int_distribution<uint32_t> layer(0, layers - 1);
+        std::uniform_int_distribution<uint32_t> depth(0, (1u << depthBits) - 1);
+
+        std::vector<uint32_t> keys(KEY_COUNT);
+        for (uint32_t& key: keys) { key = (layer(random) << 16) | depth(random); }
+        return keys;
+    }
+
+    bool IsStableOrder(std::span<const uint32_t> keys, std::span<const uint32_t> indices)
+    {
+        for (size_t i = 1; i < indices.size(); i++)
+        {
+            uint32_t a = keys[indices[i - 1]];
+            uint32_t b = keys[indices[i]];
+            if (a > b || (a == b && indices[i - 1] > indices[i])) { return false; }
+        }
+        return true;
+    }
+
+    void Run(const char* name, const std::vector<uint32_t>& keys)
+    {
+        std::vector<uint32_t> indices;
+        std::vector<uint32_t> scratch;
+
+        double stableMs = Measure([&]() {
+            indices.resize(keys.size());
+            std::iota(indices.begin(), indices.end(), 0u);
+            std::ranges::stable_sort(indices, [&keys](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+        });
+        double byteMs = Measure([&]() { ByteRadixSort(keys, indices); });
+        double radixMs = Measure([&]() { RadixSort(keys, indices, scratch); });
+
+        std::printf("%-22s stable_sort %7.3f ms | 8 bit radix %7.3f ms | radix %7.3f ms (%.2fx) %s%s\n", name,
+                    stableMs, byteMs, radixMs, byteMs / radixMs, radixMs < TARGET_MS ? "" : "above target",
+                    IsStableOrder(keys, indices) ? "" : " WRONG ORDER");
+    }
+}// namespace
+
+int main()
+{
+    std::printf("%zu sort keys, average of %zu runs, target %.1f ms\n", KEY_COUNT, ITERATIONS, TARGET_MS);
+
+    Run("256 layers, full depth", CreateKeys(256, 16));
+    Run("16 layers, full depth", CreateKeys(16, 16));
+    Run("4 layers, full depth", CreateKeys(4, 16));
+    Run("1 layer, full depth", CreateKeys(1, 16));
+    Run("1 layer, 8 bit depth", CreateKeys(1, 8));
+    Run("1 layer, flat", CreateKeys(1, 0));
+    return 0;
+}
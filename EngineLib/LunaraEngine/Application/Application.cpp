@@ -1,6 +1,7 @@
 #include "Application.hpp"
 #include <LunaraEngine/Engine.hpp>
 #include <LunaraEngine/Core/Timer.hpp>
+#include <cmath>
 
 namespace LunaraEngine
 {
@@ -11,6 +12,9 @@ namespace LunaraEngine
 
         s_Config = std::move(config);
 
+        // Started first, asset loading already schedules work on it
+        JobSystem::Init();
+
         auto renderer_result = Renderer::Init(s_Config.windowName, s_Config.initialWidth, s_Config.initialHeight);
         if (renderer_result != LunaraEngine::RendererResultType::Renderer_Result_Success)
         {
@@ -26,22 +30,40 @@ namespace LunaraEngine
     void Application::Run()
     {
         LayerStack::InitLayers(s_Config);
-        Event event{};
+        EventQueue events;
         double dt = 0.0f;
+        double accumulator = 0.0;
+        const double step = s_Config.fixedTickRate > 0 ? 1.0 / (double) s_Config.fixedTickRate : 0.0;
+        s_FixedTimestep = (float) step;
+        s_InterpolationAlpha = step > 0.0 ? 0.0f : 1.0f;
         Timer timer;
         while (true)
         {
-            if (PollEvents(&event))
-            {
-                if (event.type == EVENT_QUIT) { break; }
-
-                LayerStack::OnEvent(&event);
-            }
+            // Everything that arrived since the last frame is handled now, not one event per frame
+            events.Pump();
+            if (events.Contains(EVENT_QUIT)) { break; }
+            LayerStack::OnEvents(events);
             Renderer::BeginFrame();
             LayerStack::Begin();
+            if (step > 0.0)
+            {
+                accumulator += dt;
+                uint32_t steps = 0;
+                while (accumulator >= step && steps < s_Config.maxFixedSteps)
+                {
+                    LayerStack::OnFixedUpdate((float) step);
+                    accumulator -= step;
+                    steps++;
+                }
+                // A frame that took longer than the catch up budget drops the rest instead of spiraling
+                if (accumulator >= step) { accumulator = std::fmod(accumulator, step); }
+                s_InterpolationAlpha = (float) (accumulator / step);
+            }
             LayerStack::OnUpdate((float) dt);
             LayerStack::OnImGuiDraw();
             LayerStack::End();
+            // Deferred gameplay events of this frame
+            EventBus::Flush();
 
             //Present to screen
             Renderer::Present();
@@ -54,8 +76,10 @@ namespace LunaraEngine
     void Application::Close()
     {
         LayerStack::DestroyLayers();
+        EventBus::Destroy();
         AudioManager::Destroy();
         Renderer::Destroy();
+        JobSystem::Destroy();
     }
 
     bool Application::ValidateConfig(ApplicationConfig&& config)
@@ -68,6 +92,8 @@ namespace LunaraEngine
         LOG_DEBUG("Window name: %s", config.windowName.data());
         LOG_DEBUG("\tInitial width: %d", config.initialWidth);
         LOG_DEBUG("\tInitial height: %d", config.initialHeight);
+        LOG_DEBUG("Fixed tick rate: %u", config.fixedTickRate);
+        LOG_DEBUG("\tMax fixed steps: %u", config.maxFixedSteps);
 
         if (config.workingDirectory.empty()) { return false; }
         if (config.assetsDirectory.empty()) { return false; }
@@ -76,6 +102,7 @@ namespace LunaraEngine
         if (config.windowName.empty()) { return false; }
         if (config.initialWidth == 0) { return false; }
         if (config.initialHeight == 0) { return false; }
+        if (config.fixedTickRate > 0 && config.maxFixedSteps == 0) { return false; }
 
         LOG_INFO("Application config is valid");
         return true;
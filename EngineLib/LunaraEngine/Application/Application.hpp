@@ -24,10 +24,18 @@ namespace LunaraEngine
 
         static void Close();
 
+        // How far the current frame is between the last fixed step and the next one, in [0, 1). Always one
+        // without a fixed step, the state of the last update is drawn as is
+        [[nodiscard]] static float GetInterpolationAlpha() { return s_InterpolationAlpha; }
+
+        [[nodiscard]] static float GetFixedTimestep() { return s_FixedTimestep; }
+
     private:
         static bool ValidateConfig(ApplicationConfig&& config);
 
     private:
         inline static ApplicationConfig s_Config;
+        inline static float s_InterpolationAlpha{};
+        inline static float s_FixedTimestep{};
     };
 }// namespace LunaraEngine
\ No newline at end of file
@@ -18,5 +18,9 @@ namespace LunaraEngine
         std::string_view windowName;
         uint32_t initialWidth;
         uint32_t initialHeight;
+        // Simulation ticks per second for OnFixedUpdate, zero disables the fixed step
+        uint32_t fixedTickRate{};
+        // Fixed steps a single frame may catch up on, the remaining time is dropped
+        uint32_t maxFixedSteps{5};
     };
 }// namespace LunaraEngine
\ No newline at end of file
@@ -0,0 +1,32 @@
+#include "EventBus.hpp"
+
+namespace LunaraEngine
+{
+    void EventBus::Unsubscribe(EventSubscription& subscription)
+    {
+        if (!subscription.IsValid()) { return; }
+
+        auto channel = s_Channels.find(subscription.eventId);
+        if (channel != s_Channels.end()) { channel->second->Unsubscribe(subscription.id); }
+        subscription.id = EventSubscription::INVALID_ID;
+    }
+
+    void EventBus::Flush()
+    {
+        // Listeners may queue further events, those wait for the next frame
+        std::swap(s_QueuedChannels, s_FlushingChannels);
+        for (auto* channel: s_FlushingChannels)
+        {
+            channel->m_InFlushList = false;
+            channel->Flush();
+        }
+        s_FlushingChannels.clear();
+    }
+
+    void EventBus::Destroy()
+    {
+        s_QueuedChannels.clear();
+        s_FlushingChannels.clear();
+        s_Channels.clear();
+    }
+}// namespace LunaraEngine
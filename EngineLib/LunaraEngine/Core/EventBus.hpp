@@ -0,0 +1,242 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <source_location>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace LunaraEngine
+{
+    namespace Detail
+    {
+        // The function name spells out the template argument, hashing it gives every type a stable id
+        template <typename T>
+        consteval uint32_t HashEventType()
+        {
+            std::string_view name = std::source_location::current().function_name();
+            uint32_t hash = 2166136261u;
+            for (char c: name)
+            {
+                hash ^= (uint8_t) c;
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+
+        // One object per type, its address tells the channels of types with colliding ids apart
+        template <typename T>
+        inline constexpr char EventTypeTag{};
+    }// namespace Detail
+
+    template <typename T>
+    inline constexpr uint32_t EventId = Detail::HashEventType<T>();
+
+    struct EventSubscription {
+        static constexpr uint32_t INVALID_ID = 0;
+
+        uint32_t eventId{};
+        uint32_t id{INVALID_ID};
+
+        [[nodiscard]] bool IsValid() const { return id != INVALID_ID; }
+    };
+
+    class EventChannelBase
+    {
+    public:
+        explicit EventChannelBase(const void* typeTag) : m_TypeTag(typeTag) {}
+
+        virtual ~EventChannelBase() = default;
+
+    public:
+        virtual void Flush() = 0;
+        virtual void Unsubscribe(uint32_t id) = 0;
+        virtual void Clear() = 0;
+
+    private:
+        friend class EventBus;
+        const void* m_TypeTag{};
+        // Set while the channel waits in the flush list so it is added only once per frame
+        bool m_InFlushList{};
+    };
+
+    // Subscribers and queued events of one event type, each kept in a contiguous array
+    template <typename T>
+    class EventChannel: public EventChannelBase
+    {
+    public:
+        using Callback = std::function<void(const T&)>;
+        using BatchCallback = std::function<void(std::span<const T>)>;
+
+    public:
+        EventChannel() : EventChannelBase(&Detail::EventTypeTag<T>) {}
+
+    public:
+        void Subscribe(uint32_t id, Callback callback, BatchCallback batchCallback)
+        {
+            // Growing the list while it is dispatched would move the callback that is running
+            auto& listeners = m_Dispatching > 0 ? m_AddedListeners : m_Listeners;
+            listeners.push_back({id, std::move(callback), std::move(batchCallback)});
+        }
+
+        void Unsubscribe(uint32_t id) override
+        {
+            for (auto* listeners: {&m_Listeners, &m_AddedListeners})
+            {
+                for (auto& listener: *listeners)
+                {
+                    if (listener.id == id) { listener.id = EventSubscription::INVALID_ID; }
+                }
+            }
+            m_HasRemoved = true;
+            if (m_Dispatching == 0) { Compact(); }
+        }
+
+        void Publish(const T& event)
+        {
+            m_Dispatching++;
+            for (size_t i = 0; i < m_Listeners.size(); i++)
+            {
+                auto& listener = m_Listeners[i];
+                if (listener.id == EventSubscription::INVALID_ID) { continue; }
+                if (listener.batchCallback) { listener.batchCallback(std::span<const T>(&event, 1)); }
+                else { listener.callback(event); }
+            }
+            m_Dispatching--;
+            if (m_Dispatching == 0) { Compact(); }
+        }
+
+        void Enqueue(T&& event) { m_Queued.push_back(std::move(event)); }
+
+        void Flush() override
+        {
+            // Events queued by the listeners are delivered on the next flush
+            std::swap(m_Queued, m_Processing);
+            std::span<const T> events(m_Processing);
+
+            m_Dispatching++;
+            for (size_t i = 0; i < m_Listeners.size(); i++)
+            {
+                auto& listener = m_Listeners[i];
+                if (listener.id == EventSubscription::INVALID_ID) { continue; }
+                if (listener.batchCallback) { listener.batchCallback(events); }
+                else
+                {
+                    for (const T& event: events) { listener.callback(event); }
+                }
+            }
+            m_Dispatching--;
+            m_Processing.clear();
+            if (m_Dispatching == 0) { Compact(); }
+        }
+
+        void Clear() override
+        {
+            m_Queued.clear();
+            m_Processing.clear();
+        }
+
+        [[nodiscard]] size_t GetQueuedCount() const { return m_Queued.size(); }
+
+    private:
+        struct Listener {
+            uint32_t id{};
+            Callback callback;
+            BatchCallback batchCallback;
+        };
+
+        void Compact()
+        {
+            if (m_HasRemoved)
+            {
+                std::erase_if(m_Listeners,
+                              [](const Listener& listener) { return listener.id == EventSubscription::INVALID_ID; });
+                m_HasRemoved = false;
+            }
+            for (auto& listener: m_AddedListeners)
+            {
+                if (listener.id != EventSubscription::INVALID_ID) { m_Listeners.push_back(std::move(listener)); }
+            }
+            m_AddedListeners.clear();
+        }
+
+    private:
+        std::vector<Listener> m_Listeners;
+        std::vector<Listener> m_AddedListeners;
+        std::vector<T> m_Queued;
+        std::vector<T> m_Processing;
+        uint32_t m_Dispatching{};
+        bool m_HasRemoved{};
+    };
+
+    // Typed publish and subscribe for engine and gameplay events. Publish delivers immediately, Enqueue stores the
+    // event until Flush at the end of the frame. Only used from the main thread
+    class EventBus
+    {
+    public:
+        template <typename T>
+        static EventSubscription Subscribe(typename EventChannel<T>::Callback callback)
+        {
+            uint32_t id = s_NextSubscription++;
+            GetChannel<T>().Subscribe(id, std::move(callback), nullptr);
+            return {EventId<T>, id};
+        }
+
+        // The callback receives all events of the type queued during the frame at once
+        template <typename T>
+        static EventSubscription SubscribeBatch(typename EventChannel<T>::BatchCallback callback)
+        {
+            uint32_t id = s_NextSubscription++;
+            GetChannel<T>().Subscribe(id, nullptr, std::move(callback));
+            return {EventId<T>, id};
+        }
+
+        static void Unsubscribe(EventSubscription& subscription);
+
+        template <typename T>
+        static void Publish(const T& event)
+        {
+            GetChannel<T>().Publish(event);
+        }
+
+        template <typename T>
+        static void Enqueue(T event)
+        {
+            auto& channel = GetChannel<T>();
+            channel.Enqueue(std::move(event));
+            if (!channel.m_InFlushList)
+            {
+                channel.m_InFlushList = true;
+                s_QueuedChannels.push_back(&channel);
+            }
+        }
+
+        // Delivers the deferred events type by type in the order the types were first queued
+        static void Flush();
+
+        static void Destroy();
+
+    private:
+        template <typename T>
+        static EventChannel<T>& GetChannel()
+        {
+            auto& channel = s_Channels[EventId<T>];
+            if (!channel) { channel = std::make_unique<EventChannel<T>>(); }
+            if (channel->m_TypeTag != &Detail::EventTypeTag<T>)
+            {
+                throw std::runtime_error("Event type id collides with another event type!");
+            }
+            return static_cast<EventChannel<T>&>(*channel);
+        }
+
+    private:
+        inline static std::unordered_map<uint32_t, std::unique_ptr<EventChannelBase>> s_Channels;
+        inline static std::vector<EventChannelBase*> s_QueuedChannels;
+        inline static std::vector<EventChannelBase*> s_FlushingChannels;
+        inline static uint32_t s_NextSubscription = 1;
+    };
+}// namespace LunaraEngine
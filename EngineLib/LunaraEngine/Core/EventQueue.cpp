@@ -0,0 +1,140 @@
+#include "EventQueue.hpp"
+#include <LunaraEngine/Core/Log.h>
+
+namespace LunaraEngine
+{
+    namespace
+    {
+        // Lower ranks are dropped first. Releases, quits and resizes change state the game would never see again
+        constexpr int NEVER_DROP = 2;
+
+        int GetDropRank(const Event& event)
+        {
+            switch (event.type)
+            {
+                case EVENT_MOUSE_MOTION:
+                case EVENT_SCROLL_MOTION:
+                    return 0;
+                case EVENT_KEYBOARD:
+                    return event.keyEvent.type == KEY_PRESSED ? 1 : NEVER_DROP;
+                case EVENT_MOUSE_BUTTON:
+                    return event.mouseButtonEvent.type == MOUSE_BUTTON_PRESSED ? 1 : NEVER_DROP;
+                default:
+                    return NEVER_DROP;
+            }
+        }
+
+        // The run keeps the latest position and the summed relative motion
+        void CoalesceMotion(Event& target, const Event& event)
+        {
+            target.timestamp = event.timestamp;
+            target.mouseMotionEvent.x = event.mouseMotionEvent.x;
+            target.mouseMotionEvent.y = event.mouseMotionEvent.y;
+            target.mouseMotionEvent.xrel += event.mouseMotionEvent.xrel;
+            target.mouseMotionEvent.yrel += event.mouseMotionEvent.yrel;
+        }
+    }// namespace
+
+    uint32_t EventQueue::Pump()
+    {
+        Clear();
+        uint32_t read = 0;
+        Event event{};
+        while (PollEvents(&event))
+        {
+            read++;
+            if (event.type != EVENT_NONE) { Push(event); }
+        }
+        return read;
+    }
+
+    void EventQueue::Push(const Event& event)
+    {
+        if (event.type == EVENT_MOUSE_MOTION && m_Count > 0)
+        {
+            Event& last = At(m_Count - 1);
+            if (last.type == EVENT_MOUSE_MOTION)
+            {
+                CoalesceMotion(last, event);
+                return;
+            }
+        }
+
+        if (m_Count == CAPACITY && !MakeRoom(event)) { return; }
+        m_Events[(m_Head + m_Count) & MASK] = event;
+        m_Count++;
+    }
+
+    bool EventQueue::Contains(EventType type) const
+    {
+        for (size_t i = 0; i < m_Count; i++)
+        {
+            if ((*this)[i].type == type) { return true; }
+        }
+        return false;
+    }
+
+    bool EventQueue::MakeRoom(const Event& event)
+    {
+        if (!m_OverflowLogged)
+        {
+            LOG_WARNING("Event queue is full, dropping motion and press events of this frame");
+            m_OverflowLogged = true;
+        }
+
+        // New motion folds into the newest queued motion, only its order against the events in between is lost
+        if (event.type == EVENT_MOUSE_MOTION)
+        {
+            for (size_t i = m_Count; i-- > 0;)
+            {
+                if (At(i).type != EVENT_MOUSE_MOTION) { continue; }
+                CoalesceMotion(At(i), event);
+                return false;
+            }
+        }
+
+        // The oldest event of the lowest rank makes room, never one that ranks above the new event
+        size_t victim = m_Count;
+        int victimRank = NEVER_DROP;
+        for (size_t i = 0; i < m_Count && victimRank > 0; i++)
+        {
+            int rank = GetDropRank(At(i));
+            if (rank < victimRank)
+            {
+                victim = i;
+                victimRank = rank;
+            }
+        }
+
+        const int rank = GetDropRank(event);
+        if (victim == m_Count || victimRank > rank)
+        {
+            // Releases cannot outnumber the keys and buttons, a ring holding nothing else cannot happen in practice
+            if (rank == NEVER_DROP) { LOG_ERROR("Event queue is full of state changes, event %d dropped", event.type); }
+            m_Dropped++;
+            return false;
+        }
+
+        // Relative motion carries over to the next queued motion so the accumulated delta stays intact
+        const Event& dropped = At(victim);
+        bool coalesced = false;
+        for (size_t i = victim + 1; i < m_Count && dropped.type == EVENT_MOUSE_MOTION; i++)
+        {
+            if (At(i).type != EVENT_MOUSE_MOTION) { continue; }
+            At(i).mouseMotionEvent.xrel += dropped.mouseMotionEvent.xrel;
+            At(i).mouseMotionEvent.yrel += dropped.mouseMotionEvent.yrel;
+            coalesced = true;
+            break;
+        }
+        if (!coalesced) { m_Dropped++; }
+
+        Erase(victim);
+        return true;
+    }
+
+    void EventQueue::Erase(size_t index)
+    {
+        for (size_t i = index + 1; i < m_Count; i++) { At(i - 1) = At(i); }
+        m_Count--;
+    }
+}// namespace LunaraEngine
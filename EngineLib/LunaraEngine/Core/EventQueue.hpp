@@ -0,0 +1,57 @@
+#pragma once
+#include <LunaraEngine/Core/Events.hpp>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace LunaraEngine
+{
+    // Fixed capacity ring of the events collected during one frame. Consecutive mouse motion is coalesced into a
+    // single event, so a flood of motion cannot push key presses into later frames. Once the ring is full motion is
+    // coalesced or dropped first and presses after it, releases, quits and resizes are never dropped
+    class EventQueue
+    {
+    public:
+        static constexpr size_t CAPACITY = 256;
+
+    public:
+        // Drains every pending window event, returns the number of events read from the window
+        uint32_t Pump();
+        void Push(const Event& event);
+
+        void Clear()
+        {
+            m_Head = 0;
+            m_Count = 0;
+            m_OverflowLogged = false;
+        }
+
+        [[nodiscard]] const Event& operator[](size_t index) const { return m_Events[(m_Head + index) & MASK]; }
+
+        [[nodiscard]] size_t GetCount() const { return m_Count; }
+
+        [[nodiscard]] bool IsEmpty() const { return m_Count == 0; }
+
+        [[nodiscard]] bool Contains(EventType type) const;
+
+        // Events dropped because the ring was full, counted since creation
+        [[nodiscard]] uint64_t GetDroppedCount() const { return m_Dropped; }
+
+    private:
+        [[nodiscard]] Event& At(size_t index) { return m_Events[(m_Head + index) & MASK]; }
+
+        // Frees a slot for the event, returns false when the event was coalesced or dropped instead
+        bool MakeRoom(const Event& event);
+        void Erase(size_t index);
+
+    private:
+        static_assert((CAPACITY & (CAPACITY - 1)) == 0, "event queue capacity has to be a power of two");
+        static constexpr size_t MASK = CAPACITY - 1;
+
+        std::array<Event, CAPACITY> m_Events{};
+        size_t m_Head{};
+        size_t m_Count{};
+        uint64_t m_Dropped{};
+        bool m_OverflowLogged{};
+    };
+}// namespace LunaraEngine
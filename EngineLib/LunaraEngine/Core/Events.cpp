@@ -56,6 +56,9 @@ int PollEvents(Event* event)
 
     if (result != 0)
     {
+        // Events that are not translated must not repeat the previous one
+        event->type = EVENT_NONE;
+        event->timestamp = ev.common.timestamp;
         switch (ev.type)
         {
             case SDL_EVENT_QUIT:
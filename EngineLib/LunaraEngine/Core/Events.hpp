@@ -360,8 +360,13 @@ typedef struct {
     uint32_t height;
 } ResizeWindowEvent;
 
+typedef struct {
+    uint64_t timestamp;
+} QuitEvent;
+
 typedef struct {
     EventType type;
+    uint64_t timestamp; /**< Nanoseconds since SDL was initialized */
 
     KeyEvent keyEvent;
     MouseButtonEvent mouseButtonEvent;
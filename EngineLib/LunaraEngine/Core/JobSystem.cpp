@@ -0,0 +1,273 @@
+#include "JobSystem.hpp"
+#include <LunaraEngine/Core/Log.h>
+#include <algorithm>
+#include <utility>
+
+namespace LunaraEngine
+{
+    JobCounter::~JobCounter()
+    {
+        // Jobs still waiting on a counter that goes away never run
+        for (Job* job: m_ParkedJobs) { delete job; }
+    }
+
+    bool JobCounter::IsDone() const
+    {
+        if (m_Value.load(std::memory_order_acquire) != 0) { return false; }
+
+        // The job that brought the counter to zero may still be taking the parked jobs, the counter must not be
+        // destroyed before it let go of the mutex
+        std::lock_guard lock(m_ParkedMutex);
+        return m_Value.load(std::memory_order_relaxed) == 0;
+    }
+
+    bool JobCounter::Park(Job* job) const
+    {
+        std::lock_guard lock(m_ParkedMutex);
+        if (m_Value.load(std::memory_order_acquire) == 0) { return false; }
+
+        m_ParkedJobs.push_back(job);
+        return true;
+    }
+
+    std::vector<Job*> JobCounter::Decrement()
+    {
+        // Only the drop to zero takes the lock, it is what releases the parked jobs
+        uint32_t value = m_Value.load(std::memory_order_relaxed);
+        while (value > 1)
+        {
+            if (m_Value.compare_exchange_weak(value, value - 1, std::memory_order_acq_rel, std::memory_order_relaxed))
+            {
+                return {};
+            }
+        }
+
+        std::lock_guard lock(m_ParkedMutex);
+        if (m_Value.fetch_sub(1, std::memory_order_acq_rel) != 1) { return {}; }
+        return std::exchange(m_ParkedJobs, {});
+    }
+
+    bool JobDeque::Push(Job* job)
+    {
+        int64_t bottom = m_Bottom.load(std::memory_order_relaxed);
+        int64_t top = m_Top.load(std::memory_order_acquire);
+        if (bottom - top >= CAPACITY) { return false; }
+
+        // Publishes the job to thieves that read the new bottom
+        m_Jobs[bottom & MASK].store(job, std::memory_order_relaxed);
+        m_Bottom.store(bottom + 1, std::memory_order_release);
+        return true;
+    }
+
+    Job* JobDeque::Pop()
+    {
+        int64_t bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+        m_Bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = m_Top.load(std::memory_order_relaxed);
+
+        if (top > bottom)
+        {
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        Job* job = m_Jobs[bottom & MASK].load(std::memory_order_relaxed);
+        if (top == bottom)
+        {
+            // Last job, a thief may be taking it at the same time
+            if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                job = nullptr;
+            }
+            m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return job;
+    }
+
+    Job* JobDeque::Steal()
+    {
+        int64_t top = m_Top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t bottom = m_Bottom.load(std::memory_order_acquire);
+        if (top >= bottom) { return nullptr; }
+
+        Job* job = m_Jobs[top & MASK].load(std::memory_order_relaxed);
+        if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            return nullptr;
+        }
+        return job;
+    }
+
+    void JobSystem::Init(uint32_t workerCount)
+    {
+        if (s_JobSystem != nullptr) { return; }
+
+        // The calling thread counts as a worker
+        if (workerCount == 0) { workerCount = std::max(std::thread::hardware_concurrency(), 1u); }
+
+        s_JobSystem = new JobSystem();
+        s_JobSystem->m_Running = true;
+        s_JobSystem->m_Workers.resize(workerCount);
+        for (auto& worker: s_JobSystem->m_Workers) { worker = std::make_unique<Worker>(); }
+
+        t_WorkerIndex = 0;
+        for (uint32_t i = 1; i < workerCount; i++)
+        {
+            s_JobSystem->m_Workers[i]->thread = std::thread(&JobSystem::WorkerLoop, i);
+        }
+        LOG_INFO("Job system started with %u workers", workerCount);
+    }
+
+    void JobSystem::Destroy()
+    {
+        if (s_JobSystem == nullptr) { return; }
+
+        {
+            std::lock_guard lock(s_JobSystem->m_SleepMutex);
+            s_JobSystem->m_Running = false;
+        }
+        s_JobSystem->m_SleepCondition.notify_all();
+        for (auto& worker: s_JobSystem->m_Workers)
+        {
+            if (worker->thread.joinable()) { worker->thread.join(); }
+        }
+
+        // Jobs nobody waited for are dropped with their counters left pending
+        for (auto& worker: s_JobSystem->m_Workers)
+        {
+            while (Job* job = worker->deque.Steal()) { delete job; }
+        }
+
+        t_WorkerIndex = INVALID_WORKER;
+        delete s_JobSystem;
+        s_JobSystem = nullptr;
+    }
+
+    void JobSystem::Run(std::function<void()> function, JobCounter* counter, const JobCounter* dependency)
+    {
+        if (counter != nullptr) { counter->m_Value.fetch_add(1, std::memory_order_relaxed); }
+
+        Schedule(new Job{std::move(function), counter, dependency});
+    }
+
+    void JobSystem::Wait(const JobCounter& counter)
+    {
+        uint32_t index = t_WorkerIndex;
+        while (!counter.IsDone())
+        {
+            // Waiting threads help out instead of blocking
+            Job* job = s_JobSystem != nullptr && index != INVALID_WORKER ? FindJob(index) : nullptr;
+            if (job != nullptr) { Execute(job); }
+            else { std::this_thread::yield(); }
+        }
+    }
+
+    void JobSystem::ParallelFor(size_t count, const std::function<void(size_t begin, size_t end)>& function,
+                                size_t chunkSize)
+    {
+        if (count == 0) { return; }
+
+        size_t workerCount = GetWorkerCount();
+        if (chunkSize == 0) { chunkSize = std::max<size_t>(1, count / (workerCount * CHUNKS_PER_WORKER)); }
+        if (workerCount <= 1 || count <= chunkSize || t_WorkerIndex == INVALID_WORKER)
+        {
+            function(0, count);
+            return;
+        }
+
+        // The caller keeps the first chunk for itself
+        JobCounter counter;
+        for (size_t begin = chunkSize; begin < count; begin += chunkSize)
+        {
+            size_t end = std::min(begin + chunkSize, count);
+            Run([&function, begin, end]() { function(begin, end); }, &counter);
+        }
+        function(0, chunkSize);
+        Wait(counter);
+    }
+
+    uint32_t JobSystem::GetWorkerCount()
+    {
+        return s_JobSystem != nullptr ? (uint32_t) s_JobSystem->m_Workers.size() : 1;
+    }
+
+    void JobSystem::WorkerLoop(uint32_t index)
+    {
+        t_WorkerIndex = index;
+        auto* system = s_JobSystem;
+        uint32_t idleSpins = 0;
+        while (system->m_Running.load(std::memory_order_acquire))
+        {
+            if (Job* job = FindJob(index))
+            {
+                Execute(job);
+                idleSpins = 0;
+                continue;
+            }
+
+            if (++idleSpins < IDLE_SPINS)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            std::unique_lock lock(system->m_SleepMutex);
+            system->m_SleepCondition.wait(lock, [system]() {
+                return system->m_QueuedJobs.load(std::memory_order_acquire) > 0 ||
+                       !system->m_Running.load(std::memory_order_acquire);
+            });
+            idleSpins = 0;
+        }
+    }
+
+    Job* JobSystem::FindJob(uint32_t index)
+    {
+        auto& workers = s_JobSystem->m_Workers;
+        Job* job = workers[index]->deque.Pop();
+
+        // Victims are visited round robin starting after the thief so they are not all drained in the same order
+        for (size_t i = 1; job == nullptr && i < workers.size(); i++)
+        {
+            job = workers[(index + i) % workers.size()]->deque.Steal();
+        }
+
+        if (job != nullptr) { s_JobSystem->m_QueuedJobs.fetch_sub(1, std::memory_order_acq_rel); }
+        return job;
+    }
+
+    void JobSystem::Schedule(Job* job)
+    {
+        // A job that cannot start yet waits on its dependency instead of occupying a worker
+        if (job->dependency != nullptr && job->dependency->Park(job)) { return; }
+
+        // Without a deque of its own the calling thread does the work immediately
+        uint32_t index = t_WorkerIndex;
+        if (s_JobSystem == nullptr || index == INVALID_WORKER || !s_JobSystem->m_Workers[index]->deque.Push(job))
+        {
+            Execute(job);
+            return;
+        }
+
+        s_JobSystem->m_QueuedJobs.fetch_add(1, std::memory_order_release);
+        // Taking the lock orders the wake up after a worker that is about to sleep checked the queue
+        {
+            std::lock_guard lock(s_JobSystem->m_SleepMutex);
+        }
+        s_JobSystem->m_SleepCondition.notify_one();
+    }
+
+    void JobSystem::Execute(Job* job)
+    {
+        // The dependency can have been raised again since the job was scheduled, it goes back to waiting
+        if (job->dependency != nullptr && job->dependency->Park(job)) { return; }
+
+        job->function();
+        JobCounter* counter = job->counter;
+        delete job;
+
+        if (counter == nullptr) { return; }
+        for (Job* released: counter->Decrement()) { Schedule(released); }
+    }
+}// namespace LunaraEngine
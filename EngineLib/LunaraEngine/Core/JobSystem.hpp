@@ -0,0 +1,127 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace LunaraEngine
+{
+    struct Job;
+
+    // Number of jobs that still have to finish, a counter is done once it drops back to zero. Jobs that depend
+    // on a counter are parked on it and scheduled by whichever job brings it to zero
+    class JobCounter
+    {
+    public:
+        JobCounter() = default;
+        ~JobCounter();
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+    public:
+        [[nodiscard]] bool IsDone() const;
+
+        [[nodiscard]] uint32_t GetValue() const { return m_Value.load(std::memory_order_acquire); }
+
+    private:
+        friend class JobSystem;
+
+        // Parks the job unless the counter is already done, returns false when the caller has to schedule it
+        bool Park(Job* job) const;
+        // Returns the parked jobs when this was the last pending job
+        std::vector<Job*> Decrement();
+
+    private:
+        std::atomic<uint32_t> m_Value{};
+        // Dropping to zero happens under the mutex, so a waiter that saw zero knows the parked jobs were taken
+        mutable std::mutex m_ParkedMutex;
+        mutable std::vector<Job*> m_ParkedJobs;
+    };
+
+    struct Job {
+        std::function<void()> function;
+        // Decremented once the function returned
+        JobCounter* counter{};
+        // The job is not started before this counter is done
+        const JobCounter* dependency{};
+    };
+
+    // Chase-Lev work stealing deque. The owning thread pushes and pops at the bottom, any thread steals from the top
+    class JobDeque
+    {
+    public:
+        static constexpr int64_t CAPACITY = 4096;
+
+    public:
+        bool Push(Job* job);
+        Job* Pop();
+        Job* Steal();
+
+        [[nodiscard]] bool IsEmpty() const
+        {
+            return m_Bottom.load(std::memory_order_relaxed) <= m_Top.load(std::memory_order_relaxed);
+        }
+
+    private:
+        static_assert((CAPACITY & (CAPACITY - 1)) == 0, "deque capacity has to be a power of two");
+        static constexpr int64_t MASK = CAPACITY - 1;
+
+        alignas(64) std::atomic<int64_t> m_Top{};
+        alignas(64) std::atomic<int64_t> m_Bottom{};
+        std::atomic<Job*> m_Jobs[CAPACITY]{};
+    };
+
+    // Fixed worker pool shared by the whole engine. The thread that calls Init becomes worker zero and executes
+    // jobs while it waits, threads that are not part of the pool run their jobs inline
+    class JobSystem
+    {
+    public:
+        static void Init(uint32_t workerCount = 0);
+        static void Destroy();
+
+    public:
+        static void Run(std::function<void()> function, JobCounter* counter = nullptr,
+                        const JobCounter* dependency = nullptr);
+        static void Wait(const JobCounter& counter);
+
+        // Splits [0, count) into chunks of at least chunkSize elements and returns once all of them ran,
+        // a chunk size of zero spreads the range evenly over the workers
+        static void ParallelFor(size_t count, const std::function<void(size_t begin, size_t end)>& function,
+                                size_t chunkSize = 0);
+
+        [[nodiscard]] static uint32_t GetWorkerCount();
+
+        [[nodiscard]] static bool IsInitialized() { return s_JobSystem != nullptr; }
+
+    private:
+        static constexpr uint32_t INVALID_WORKER = std::numeric_limits<uint32_t>::max();
+        static constexpr uint32_t CHUNKS_PER_WORKER = 4;
+        static constexpr uint32_t IDLE_SPINS = 64;
+
+        struct Worker {
+            JobDeque deque;
+            std::thread thread;
+        };
+
+        static void WorkerLoop(uint32_t index);
+        static Job* FindJob(uint32_t index);
+        // Queues the job on the calling worker, or parks it on its dependency while that is not done
+        static void Schedule(Job* job);
+        static void Execute(Job* job);
+
+    private:
+        inline static JobSystem* s_JobSystem = nullptr;
+        inline static thread_local uint32_t t_WorkerIndex = INVALID_WORKER;
+
+        std::vector<std::unique_ptr<Worker>> m_Workers;
+        std::atomic<bool> m_Running{};
+        std::atomic<uint32_t> m_QueuedJobs{};
+        std::mutex m_SleepMutex;
+        std::condition_variable m_SleepCondition;
+    };
+}// namespace LunaraEngine
@@ -0,0 +1,46 @@
+#pragma once
+#include <LunaraEngine/Renderer/QuadInstance.hpp>
+#include <LunaraEngine/Math/Rect.h>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+namespace LunaraEngine
+{
+    struct Transform {
+        // Top left corner in world units, z is the draw depth
+        glm::vec3 position{};
+    };
+
+    // Transform before the last fixed step, drawn positions are blended from it to Transform
+    struct PreviousTransform {
+        glm::vec3 position{};
+    };
+
+    struct Velocity {
+        // World units per second
+        glm::vec2 value{};
+    };
+
+    struct Sprite {
+        glm::vec2 size{};
+        uint32_t textureIndex{};
+        // Drawn as a flipbook instead of textureIndex when it has frames
+        SpriteAnimation animation{};
+    };
+
+    struct Collider {
+        static constexpr uint32_t ALL_LAYERS = 0xFFFFFFFF;
+
+        // Box relative to the transform position
+        glm::vec2 offset{};
+        glm::vec2 size{};
+        // Layers this collider is on and the layers it collides with
+        uint32_t layer{1};
+        uint32_t mask{ALL_LAYERS};
+
+        [[nodiscard]] FRect GetBounds(const Transform& transform) const
+        {
+            return {transform.position.x + offset.x, transform.position.y + offset.y, size.x, size.y};
+        }
+    };
+}// namespace LunaraEngine
@@ -0,0 +1,46 @@
+#include "Systems.hpp"
+#include <LunaraEngine/Renderer/BatchRenderer.hpp>
+
+namespace LunaraEngine
+{
+    void Systems::Move(World& world, float dt)
+    {
+        world.ParallelForEach<Transform, const Velocity>([dt](Entity, Transform& transform, const Velocity& velocity) {
+            transform.position += glm::vec3(velocity.value * dt, 0.0f);
+        });
+    }
+
+    void Systems::StorePreviousTransforms(World& world)
+    {
+        world.ForEachChunk<const Transform, PreviousTransform>(
+                [](size_t count, const Entity*, const Transform* transforms, PreviousTransform* previous) {
+                    for (size_t i = 0; i < count; i++) { previous[i].position = transforms[i].position; }
+                });
+    }
+
+    void Systems::DrawSprites(World& world, BatchRenderer& renderer, float alpha)
+    {
+        renderer.Reserve(renderer.GetQuadCount() + world.Count(ComponentRegistry::GetMask<Transform, Sprite>()));
+        world.ForEachChunk<const Transform, const Sprite>(
+                [&](size_t count, const Entity* entities, const Transform* transforms, const Sprite* sprites) {
+                    if (count == 0) { return; }
+
+                    // A chunk holds a single archetype, the first entity tells whether the whole chunk is
+                    // interpolated and its component is the start of the chunk's column
+                    const PreviousTransform* previous =
+                            alpha < 1.0f ? world.GetComponent<PreviousTransform>(entities[0]) : nullptr;
+                    for (size_t i = 0; i < count; i++)
+                    {
+                        const Sprite& sprite = sprites[i];
+                        glm::vec3 position = transforms[i].position;
+                        if (previous != nullptr) { position = glm::mix(previous[i].position, position, alpha); }
+
+                        if (sprite.animation.IsAnimated())
+                        {
+                            renderer.AddAnimatedQuad(position, sprite.size, sprite.animation);
+                        }
+                        else { renderer.AddQuad(glm::vec3(position), glm::vec2(sprite.size), sprite.textureIndex); }
+                    }
+                });
+    }
+}// namespace LunaraEngine
@@ -0,0 +1,21 @@
+#pragma once
+#include <LunaraEngine/ECS/World.hpp>
+#include <LunaraEngine/ECS/Components.hpp>
+
+namespace LunaraEngine
+{
+    class BatchRenderer;
+
+    // Built in systems over the engine components
+    class Systems
+    {
+    public:
+        // Transform += Velocity * dt, spread over the job system
+        static void Move(World& world, float dt);
+        // PreviousTransform = Transform, called at the start of every fixed step
+        static void StorePreviousTransforms(World& world);
+        // Submits every entity with a Transform and a Sprite to the batch renderer. Entities that also have a
+        // PreviousTransform are drawn alpha of the way from it to their Transform
+        static void DrawSprites(World& world, BatchRenderer& renderer, float alpha = 1.0f);
+    };
+}// namespace LunaraEngine
@@ -0,0 +1,189 @@
+#include "World.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace LunaraEngine
+{
+    namespace
+    {
+        size_t AlignUp(size_t value, size_t alignment) { return (value + alignment - 1) & ~(alignment - 1); }
+    }// namespace
+
+    ComponentId ComponentRegistry::Register(size_t size, size_t alignment)
+    {
+        if (s_Components.size() == MAX_COMPONENTS) { throw std::runtime_error("Too many component types!"); }
+
+        s_Components.push_back({size, alignment});
+        return (ComponentId) (s_Components.size() - 1);
+    }
+
+    Archetype::Archetype(ComponentMask mask) : m_Mask(mask)
+    {
+        size_t entityBytes = sizeof(Entity);
+        for (ComponentMask bits = mask; bits != 0; bits &= bits - 1)
+        {
+            auto id = (ComponentId) std::countr_zero(bits);
+            m_Components.push_back(id);
+            entityBytes += ComponentRegistry::GetInfo(id).size;
+        }
+
+        // Every array may need up to one alignment of padding in front of it
+        size_t padding = (m_Components.size() + 1) * alignof(std::max_align_t);
+        m_ChunkCapacity = (uint32_t) std::max<size_t>(1, (CHUNK_BYTES - padding) / entityBytes);
+
+        size_t offset = AlignUp(sizeof(Entity) * m_ChunkCapacity, alignof(std::max_align_t));
+        for (ComponentId id: m_Components)
+        {
+            const ComponentInfo& info = ComponentRegistry::GetInfo(id);
+            offset = AlignUp(offset, info.alignment);
+            m_Offsets[id] = (uint32_t) offset;
+            offset += info.size * m_ChunkCapacity;
+        }
+        m_ChunkBytes = offset;
+    }
+
+    Archetype::Location Archetype::Allocate(Entity entity)
+    {
+        if (m_Chunks.empty() || m_Chunks.back().count == m_ChunkCapacity)
+        {
+            m_Chunks.push_back({std::make_unique<std::byte[]>(m_ChunkBytes), 0});
+        }
+
+        auto chunkIndex = (uint32_t) (m_Chunks.size() - 1);
+        Chunk& chunk = m_Chunks.back();
+        uint32_t row = chunk.count++;
+        GetEntities(chunk)[row] = entity;
+        for (ComponentId id: m_Components)
+        {
+            size_t size = ComponentRegistry::GetInfo(id).size;
+            std::memset(static_cast<std::byte*>(GetColumn(chunk, id)) + row * size, 0, size);
+        }
+        return {chunkIndex, row};
+    }
+
+    Entity Archetype::Remove(Location location)
+    {
+        Chunk& last = m_Chunks.back();
+        auto lastChunk = (uint32_t) (m_Chunks.size() - 1);
+        uint32_t lastRow = last.count - 1;
+
+        Entity moved{};
+        if (location.chunk != lastChunk || location.row != lastRow)
+        {
+            Chunk& chunk = m_Chunks[location.chunk];
+            moved = GetEntities(last)[lastRow];
+            GetEntities(chunk)[location.row] = moved;
+            for (ComponentId id: m_Components)
+            {
+                size_t size = ComponentRegistry::GetInfo(id).size;
+                std::memcpy(static_cast<std::byte*>(GetColumn(chunk, id)) + location.row * size,
+                            static_cast<std::byte*>(GetColumn(last, id)) + lastRow * size, size);
+            }
+        }
+
+        if (--last.count == 0) { m_Chunks.pop_back(); }
+        return moved;
+    }
+
+    World::World() { GetArchetype(0); }
+
+    void World::DestroyEntity(Entity entity)
+    {
+        if (!IsAlive(entity)) { return; }
+
+        RemoveFromArchetype(entity);
+        EntityRecord& record = m_Records[entity.index];
+        record.archetype = nullptr;
+        record.generation++;
+        m_FreeEntities.push_back(entity.index);
+    }
+
+    void World::Clear()
+    {
+        m_Records.clear();
+        m_FreeEntities.clear();
+        m_Queries.clear();
+        m_ArchetypeList.clear();
+        m_Archetypes.clear();
+        GetArchetype(0);
+    }
+
+    size_t World::Count(ComponentMask mask)
+    {
+        size_t count = 0;
+        for (Archetype* archetype: GetMatchingArchetypes(mask)) { count += archetype->GetEntityCount(); }
+        return count;
+    }
+
+    Archetype& World::GetArchetype(ComponentMask mask)
+    {
+        auto& archetype = m_Archetypes[mask];
+        if (!archetype)
+        {
+            archetype = std::make_unique<Archetype>(mask);
+            m_ArchetypeList.push_back(archetype.get());
+        }
+        return *archetype;
+    }
+
+    const std::vector<Archetype*>& World::GetMatchingArchetypes(ComponentMask mask)
+    {
+        QueryCache& query = m_Queries[mask];
+        for (; query.checkedArchetypes < m_ArchetypeList.size(); query.checkedArchetypes++)
+        {
+            Archetype* archetype = m_ArchetypeList[query.checkedArchetypes];
+            if ((archetype->GetMask() & mask) == mask) { query.archetypes.push_back(archetype); }
+        }
+        return query.archetypes;
+    }
+
+    std::pair<Entity, Archetype::Location> World::CreateEntityInArchetype(Archetype& archetype)
+    {
+        Entity entity;
+        if (!m_FreeEntities.empty())
+        {
+            entity.index = m_FreeEntities.back();
+            m_FreeEntities.pop_back();
+        }
+        else
+        {
+            entity.index = (uint32_t) m_Records.size();
+            m_Records.emplace_back();
+        }
+
+        EntityRecord& record = m_Records[entity.index];
+        entity.generation = record.generation;
+        record.archetype = &archetype;
+        record.location = archetype.Allocate(entity);
+        return {entity, record.location};
+    }
+
+    void World::MoveEntity(Entity entity, Archetype& target)
+    {
+        EntityRecord& record = m_Records[entity.index];
+        Archetype& source = *record.archetype;
+        Archetype::Location location = target.Allocate(entity);
+
+        // Components both archetypes share keep their values
+        Archetype::Chunk& from = source.GetChunk(record.location.chunk);
+        Archetype::Chunk& to = target.GetChunk(location.chunk);
+        for (ComponentId id: source.GetComponents())
+        {
+            if (!target.HasComponent(id)) { continue; }
+            size_t size = ComponentRegistry::GetInfo(id).size;
+            std::memcpy(static_cast<std::byte*>(target.GetColumn(to, id)) + location.row * size,
+                        static_cast<std::byte*>(source.GetColumn(from, id)) + record.location.row * size, size);
+        }
+
+        RemoveFromArchetype(entity);
+        record.archetype = &target;
+        record.location = location;
+    }
+
+    void World::RemoveFromArchetype(Entity entity)
+    {
+        EntityRecord& record = m_Records[entity.index];
+        Entity moved = record.archetype->Remove(record.location);
+        if (moved.IsValid()) { m_Records[moved.index].location = record.location; }
+    }
+}// namespace LunaraEngine
@@ -0,0 +1,313 @@
+#pragma once
+#include <LunaraEngine/Core/JobSystem.hpp>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace LunaraEngine
+{
+    struct Entity {
+        static constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+        uint32_t index{INVALID_INDEX};
+        // Bumped whenever the index is reused so stale handles are detected
+        uint32_t generation{};
+
+        [[nodiscard]] bool IsValid() const { return index != INVALID_INDEX; }
+
+        bool operator==(const Entity&) const = default;
+    };
+
+    using ComponentId = uint32_t;
+    using ComponentMask = uint64_t;
+
+    inline constexpr uint32_t MAX_COMPONENTS = 64;
+
+    struct ComponentInfo {
+        size_t size{};
+        size_t alignment{};
+    };
+
+    // Components are plain data that chunks move around with memcpy, each type gets a bit in the archetype mask
+    class ComponentRegistry
+    {
+    public:
+        template <typename T>
+        static ComponentId GetId()
+        {
+            // Queries may ask for read only access, the component is the same
+            if constexpr (std::is_const_v<T>) { return GetId<std::remove_const_t<T>>(); }
+            else
+            {
+                static_assert(std::is_trivially_copyable_v<T>, "components have to be trivially copyable");
+                static_assert(alignof(T) <= alignof(std::max_align_t), "over aligned components are not supported");
+                static const ComponentId id = Register(sizeof(T), alignof(T));
+                return id;
+            }
+        }
+
+        template <typename... Ts>
+        static ComponentMask GetMask()
+        {
+            return (ComponentMask{} | ... | (ComponentMask{1} << GetId<Ts>()));
+        }
+
+        [[nodiscard]] static const ComponentInfo& GetInfo(ComponentId id) { return s_Components[id]; }
+
+    private:
+        static ComponentId Register(size_t size, size_t alignment);
+
+    private:
+        inline static std::vector<ComponentInfo> s_Components;
+    };
+
+    // All entities with exactly the same set of components. They live in fixed size chunks that store every
+    // component in its own array, chunks are kept full except for the last one
+    class Archetype
+    {
+    public:
+        static constexpr size_t CHUNK_BYTES = 16 * 1024;
+
+        struct Chunk {
+            std::unique_ptr<std::byte[]> data;
+            uint32_t count{};
+        };
+
+        struct Location {
+            uint32_t chunk{};
+            uint32_t row{};
+        };
+
+    public:
+        explicit Archetype(ComponentMask mask);
+
+    public:
+        // Zero initialized components, the caller writes the actual values
+        Location Allocate(Entity entity);
+        // Fills the hole with the last entity of the archetype and returns it, invalid if nothing moved
+        Entity Remove(Location location);
+
+        [[nodiscard]] ComponentMask GetMask() const { return m_Mask; }
+
+        [[nodiscard]] const std::vector<ComponentId>& GetComponents() const { return m_Components; }
+
+        [[nodiscard]] bool HasComponent(ComponentId id) const { return (m_Mask >> id) & 1; }
+
+        [[nodiscard]] uint32_t GetChunkCapacity() const { return m_ChunkCapacity; }
+
+        [[nodiscard]] size_t GetChunkCount() const { return m_Chunks.size(); }
+
+        [[nodiscard]] Chunk& GetChunk(size_t index) { return m_Chunks[index]; }
+
+        [[nodiscard]] size_t GetEntityCount() const
+        {
+            return m_Chunks.empty() ? 0 : (m_Chunks.size() - 1) * m_ChunkCapacity + m_Chunks.back().count;
+        }
+
+        [[nodiscard]] Entity* GetEntities(Chunk& chunk) const { return reinterpret_cast<Entity*>(chunk.data.get()); }
+
+        [[nodiscard]] void* GetColumn(Chunk& chunk, ComponentId id) const { return chunk.data.get() + m_Offsets[id]; }
+
+        template <typename T>
+        [[nodiscard]] T* GetColumn(Chunk& chunk) const
+        {
+            return static_cast<T*>(GetColumn(chunk, ComponentRegistry::GetId<T>()));
+        }
+
+    private:
+        ComponentMask m_Mask{};
+        std::vector<ComponentId> m_Components;
+        // Byte offset of each component array inside a chunk, indexed by component id
+        std::array<uint32_t, MAX_COMPONENTS> m_Offsets{};
+        uint32_t m_ChunkCapacity{};
+        size_t m_ChunkBytes{};
+        std::vector<Chunk> m_Chunks;
+    };
+
+    // Owns the entities and their components. Structural changes (creating, destroying, adding or removing
+    // components) must not happen while a query is being iterated
+    class World
+    {
+    public:
+        World();
+        ~World() = default;
+        World(const World&) = delete;
+        World& operator=(const World&) = delete;
+
+    public:
+        Entity CreateEntity() { return CreateEntityInArchetype(*m_Archetypes.at(0)).first; }
+
+        template <typename... Ts>
+        Entity CreateEntity(const Ts&... components);
+
+        void DestroyEntity(Entity entity);
+        void Clear();
+
+        [[nodiscard]] bool IsAlive(Entity entity) const
+        {
+            return entity.index < m_Records.size() && m_Records[entity.index].archetype != nullptr &&
+                   m_Records[entity.index].generation == entity.generation;
+        }
+
+        [[nodiscard]] size_t GetEntityCount() const { return m_Records.size() - m_FreeEntities.size(); }
+
+        [[nodiscard]] size_t GetArchetypeCount() const { return m_ArchetypeList.size(); }
+
+    public:
+        template <typename T>
+        void AddComponent(Entity entity, const T& component);
+
+        template <typename T>
+        void RemoveComponent(Entity entity);
+
+        template <typename T>
+        [[nodiscard]] bool HasComponent(Entity entity) const
+        {
+            return IsAlive(entity) && m_Records[entity.index].archetype->HasComponent(ComponentRegistry::GetId<T>());
+        }
+
+        // Valid until the next structural change
+        template <typename T>
+        [[nodiscard]] T* GetComponent(Entity entity);
+
+    public:
+        // function(Entity, Ts&...) for every entity that has all of Ts
+        template <typename... Ts, typename F>
+        void ForEach(F&& function);
+
+        // function(size_t count, const Entity*, Ts*...) once per chunk, the arrays are count elements long
+        template <typename... Ts, typename F>
+        void ForEachChunk(F&& function);
+
+        // Like ForEach but chunks are spread over the job system, the function must be safe to run concurrently
+        template <typename... Ts, typename F>
+        void ParallelForEach(F&& function);
+
+        [[nodiscard]] size_t Count(ComponentMask mask);
+
+    private:
+        struct EntityRecord {
+            Archetype* archetype{};
+            Archetype::Location location{};
+            uint32_t generation{};
+        };
+
+        // Archetypes matching a component mask, extended lazily when new archetypes appear
+        struct QueryCache {
+            std::vector<Archetype*> archetypes;
+            size_t checkedArchetypes{};
+        };
+
+        Archetype& GetArchetype(ComponentMask mask);
+        const std::vector<Archetype*>& GetMatchingArchetypes(ComponentMask mask);
+        std::pair<Entity, Archetype::Location> CreateEntityInArchetype(Archetype& archetype);
+        void MoveEntity(Entity entity, Archetype& target);
+        void RemoveFromArchetype(Entity entity);
+
+    private:
+        std::vector<EntityRecord> m_Records;
+        std::vector<uint32_t> m_FreeEntities;
+        std::unordered_map<ComponentMask, std::unique_ptr<Archetype>> m_Archetypes;
+        std::vector<Archetype*> m_ArchetypeList;
+        std::unordered_map<ComponentMask, QueryCache> m_Queries;
+    };
+
+    template <typename... Ts>
+    Entity World::CreateEntity(const Ts&... components)
+    {
+        Archetype& archetype = GetArchetype(ComponentRegistry::GetMask<Ts...>());
+        auto [entity, location] = CreateEntityInArchetype(archetype);
+        Archetype::Chunk& chunk = archetype.GetChunk(location.chunk);
+        ((archetype.GetColumn<Ts>(chunk)[location.row] = components), ...);
+        return entity;
+    }
+
+    template <typename T>
+    void World::AddComponent(Entity entity, const T& component)
+    {
+        if (!IsAlive(entity)) { return; }
+
+        ComponentId id = ComponentRegistry::GetId<T>();
+        if (!m_Records[entity.index].archetype->HasComponent(id))
+        {
+            MoveEntity(entity, GetArchetype(m_Records[entity.index].archetype->GetMask() | (ComponentMask{1} << id)));
+        }
+        *GetComponent<T>(entity) = component;
+    }
+
+    template <typename T>
+    void World::RemoveComponent(Entity entity)
+    {
+        if (!HasComponent<T>(entity)) { return; }
+
+        ComponentMask mask = m_Records[entity.index].archetype->GetMask();
+        MoveEntity(entity, GetArchetype(mask & ~(ComponentMask{1} << ComponentRegistry::GetId<T>())));
+    }
+
+    template <typename T>
+    T* World::GetComponent(Entity entity)
+    {
+        if (!HasComponent<T>(entity)) { return nullptr; }
+
+        EntityRecord& record = m_Records[entity.index];
+        Archetype::Chunk& chunk = record.archetype->GetChunk(record.location.chunk);
+        return record.archetype->template GetColumn<T>(chunk) + record.location.row;
+    }
+
+    template <typename... Ts, typename F>
+    void World::ForEach(F&& function)
+    {
+        ForEachChunk<Ts...>([&function](size_t count, const Entity* entities, Ts*... columns) {
+            for (size_t i = 0; i < count; i++) { function(entities[i], columns[i]...); }
+        });
+    }
+
+    template <typename... Ts, typename F>
+    void World::ForEachChunk(F&& function)
+    {
+        for (Archetype* archetype: GetMatchingArchetypes(ComponentRegistry::GetMask<Ts...>()))
+        {
+            for (size_t c = 0; c < archetype->GetChunkCount(); c++)
+            {
+                Archetype::Chunk& chunk = archetype->GetChunk(c);
+                function((size_t) chunk.count, archetype->GetEntities(chunk),
+                         archetype->template GetColumn<Ts>(chunk)...);
+            }
+        }
+    }
+
+    template <typename... Ts, typename F>
+    void World::ParallelForEach(F&& function)
+    {
+        std::vector<std::pair<Archetype*, size_t>> chunks;
+        for (Archetype* archetype: GetMatchingArchetypes(ComponentRegistry::GetMask<Ts...>()))
+        {
+            for (size_t c = 0; c < archetype->GetChunkCount(); c++) { chunks.emplace_back(archetype, c); }
+        }
+
+        JobSystem::ParallelFor(
+                chunks.size(),
+                [&](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; i++)
+                    {
+                        auto [archetype, c] = chunks[i];
+                        Archetype::Chunk& chunk = archetype->GetChunk(c);
+                        const Entity* entities = archetype->GetEntities(chunk);
+                        std::tuple<Ts*...> columns{archetype->template GetColumn<Ts>(chunk)...};
+                        for (size_t row = 0; row < chunk.count; row++)
+                        {
+                            function(entities[row], std::get<Ts*>(columns)[row]...);
+                        }
+                    }
+                },
+                1);
+    }
+}// namespace LunaraEngine
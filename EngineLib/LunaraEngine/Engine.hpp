@@ -3,6 +3,9 @@
 #include <LunaraEngine/Core/Memory.h>
 #include <LunaraEngine/Core/Timer.hpp>
 #include <LunaraEngine/Core/Events.hpp>
+#include <LunaraEngine/Core/EventQueue.hpp>
+#include <LunaraEngine/Core/EventBus.hpp>
+#include <LunaraEngine/Core/JobSystem.hpp>
 #include <LunaraEngine/Math/Color.h>
 #include <LunaraEngine/Math/Rect.h>
 #include <LunaraEngine/Renderer/Window.hpp>
@@ -13,8 +16,17 @@
 #include <LunaraEngine/Renderer/Buffer/IndexBuffer.hpp>
 #include <LunaraEngine/Renderer/Buffer/VertexBuffer.hpp>
 #include <LunaraEngine/Renderer/BatchRenderer.hpp>
+#include <LunaraEngine/Renderer/TileMap.hpp>
 #include <LunaraEngine/Layer/Layer.hpp>
 #include <LunaraEngine/Layer/LayerStack.hpp>
 #include <LunaraEngine/Application/Application.hpp>
 #include <LunaraEngine/Audio/AudioManager.hpp>
-#include <LunaraEngine/Physics/RectCollisions.hpp>
\ No newline at end of file
+#include <LunaraEngine/Physics/RectCollisions.hpp>
+#include <LunaraEngine/Physics/SpatialHash.hpp>
+#include <LunaraEngine/Physics/AABB.hpp>
+#include <LunaraEngine/Physics/AABBTree.hpp>
+#include <LunaraEngine/Physics/BatchCollisions.hpp>
+#include <LunaraEngine/Physics/TileCollisionLayer.hpp>
+#include <LunaraEngine/ECS/World.hpp>
+#include <LunaraEngine/ECS/Components.hpp>
+#include <LunaraEngine/ECS/Systems.hpp>
\ No newline at end of file
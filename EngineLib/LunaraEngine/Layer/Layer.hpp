@@ -1,5 +1,6 @@
 #pragma once
 #include <LunaraEngine/Core/Events.hpp>
+#include <LunaraEngine/Core/EventQueue.hpp>
 #include <LunaraEngine/Core/CommonTypes.hpp>
 #include <string_view>
 #include <memory>
@@ -24,6 +25,9 @@ namespace LunaraEngine
 
         virtual void OnUpdate(float dt) = 0;
 
+        // Called zero or more times per frame with the configured fixed step before OnUpdate
+        virtual void OnFixedUpdate(float dt) { (void) dt; }
+
         virtual void OnDetach() = 0;
 
         virtual void Destroy() = 0;
@@ -40,6 +44,9 @@ namespace LunaraEngine
 
         virtual void OnWindowShouldCloseEvent() = 0;
 
+        // Receives the whole frame batch in order before the bus delivers it to the handlers above
+        virtual void OnEvents(const EventQueue& events) { (void) events; }
+
         virtual void Begin() = 0;
 
         virtual void End() = 0;
@@ -13,6 +13,7 @@ namespace LunaraEngine
         {
             LayerStack::m_Layers.push_back(layer);
             LayerStack::m_LayersKeys.push_back(name);
+            LayerStack::m_LayersSubscriptions.push_back(_SubscribeLayer(layer));
             layer->OnAttach();
         }
     }
@@ -22,10 +23,12 @@ namespace LunaraEngine
         if (LayerStack::_ContainsLayer(name))
         {
             uint32_t index = _FindLayerIndex(name);
+            _UnsubscribeLayer(index);
             LayerStack::m_Layers[index]->OnDetach();
 
             LayerStack::m_Layers.erase(LayerStack::m_Layers.begin() + index);
             LayerStack::m_LayersKeys.erase(LayerStack::m_LayersKeys.begin() + index);
+            LayerStack::m_LayersSubscriptions.erase(LayerStack::m_LayersSubscriptions.begin() + index);
         }
     }
 
@@ -33,23 +36,27 @@ namespace LunaraEngine
     {
         for (uint32_t index = 0; index < m_Layers.size(); ++index)
         {
+            _UnsubscribeLayer(index);
             LayerStack::m_Layers[index]->OnDetach();
             LayerStack::m_Layers[index]->Destroy();
             delete LayerStack::m_Layers[index];
         }
         m_Layers.clear();
         m_LayersKeys.clear();
+        m_LayersSubscriptions.clear();
     }
 
     void LayerStack::DestroyLayers()
     {
         for (uint32_t index = 0; index < m_Layers.size(); ++index)
         {
+            _UnsubscribeLayer(index);
             LayerStack::m_Layers[index]->OnDetach();
             LayerStack::m_Layers[index]->Destroy();
             delete LayerStack::m_Layers[index];
             LayerStack::m_Layers.erase(LayerStack::m_Layers.begin() + index);
             LayerStack::m_LayersKeys.erase(LayerStack::m_LayersKeys.begin() + index);
+            LayerStack::m_LayersSubscriptions.erase(LayerStack::m_LayersSubscriptions.begin() + index);
         }
     }
 
@@ -76,41 +83,74 @@ namespace LunaraEngine
         for (auto& layer: LayerStack::m_Layers) { layer->OnUpdate(dt); }
     }
 
+    void LayerStack::OnFixedUpdate(float dt)
+    {
+        for (auto& layer: LayerStack::m_Layers) { layer->OnFixedUpdate(dt); }
+    }
+
     void LayerStack::OnImGuiDraw()
     {
         for (auto& layer: LayerStack::m_Layers) { layer->OnImGuiDraw(); }
     }
 
-    void LayerStack::OnEvent(Event* event)
+    void LayerStack::OnEvent(Event* event) { _PublishEvent(*event); }
+
+    void LayerStack::OnEvents(const EventQueue& events)
     {
+        if (events.IsEmpty()) { return; }
 
-        for (auto& layer: LayerStack::m_Layers)
+        for (auto& layer: LayerStack::m_Layers) { layer->OnEvents(events); }
+        for (size_t i = 0; i < events.GetCount(); i++) { _PublishEvent(events[i]); }
+    }
+
+    void LayerStack::_PublishEvent(const Event& event)
+    {
+        // Window events are translated once, the bus delivers them to the layers in stack order
+        switch (event.type)
         {
-            switch (event->type)
-            {
-                case EVENT_KEYBOARD:
-                    layer->OnKeyboardEvent(event->keyEvent.key, event->keyEvent.type);
-                    break;
-                case EVENT_MOUSE_MOTION:
-                    layer->OnMouseMoveEvent((uint32_t) event->mouseMotionEvent.x, (uint32_t) event->mouseMotionEvent.y);
-                    break;
-                case EVENT_MOUSE_BUTTON:
-                    layer->OnMouseButtonEvent(event->mouseButtonEvent.x, event->mouseButtonEvent.y,
-                                              event->mouseButtonEvent.type, event->mouseButtonEvent.button);
-                    break;
-                case EVENT_RESIZE_WINDOW:
-                    layer->OnWindowResizeEvent(
-                            (uint32_t) event->resizeWindowEvent.width, (uint32_t) event->resizeWindowEvent.height);
-                    break;
-                case EVENT_QUIT:
-                    layer->OnWindowShouldCloseEvent();
-                    break;
-                default:
-                    break;
-            }
+            case EVENT_KEYBOARD:
+                EventBus::Publish(event.keyEvent);
+                break;
+            case EVENT_MOUSE_MOTION:
+                EventBus::Publish(event.mouseMotionEvent);
+                break;
+            case EVENT_MOUSE_BUTTON:
+                EventBus::Publish(event.mouseButtonEvent);
+                break;
+            case EVENT_RESIZE_WINDOW:
+                EventBus::Publish(event.resizeWindowEvent);
+                break;
+            case EVENT_QUIT:
+                EventBus::Publish(QuitEvent{event.timestamp});
+                break;
+            default:
+                break;
         }
     }
 
+    LayerStack::LayerSubscriptions LayerStack::_SubscribeLayer(Layer* layer)
+    {
+        return {
+                EventBus::Subscribe<KeyEvent>(
+                        [layer](const KeyEvent& event) { layer->OnKeyboardEvent(event.key, event.type); }),
+                EventBus::Subscribe<MouseMotionEvent>([layer](const MouseMotionEvent& event) {
+                    layer->OnMouseMoveEvent((uint32_t) event.x, (uint32_t) event.y);
+                }),
+                EventBus::Subscribe<MouseButtonEvent>([layer](const MouseButtonEvent& event) {
+                    layer->OnMouseButtonEvent(event.x, event.y, event.type, event.button);
+                }),
+                EventBus::Subscribe<ResizeWindowEvent>([layer](const ResizeWindowEvent& event) {
+                    layer->OnWindowResizeEvent(event.width, event.height);
+                }),
+                EventBus::Subscribe<QuitEvent>([layer](const QuitEvent&) { layer->OnWindowShouldCloseEvent(); }),
+        };
+    }
+
+    void LayerStack::_UnsubscribeLayer(uint32_t index)
+    {
+        for (auto& subscription: LayerStack::m_LayersSubscriptions[index]) { EventBus::Unsubscribe(subscription); }
+    }
+
     uint32_t LayerStack::_FindLayerIndex(std::string_view name)
     {
 
@@ -1,7 +1,10 @@
 #pragma once
 #include "Layer.hpp"
 #include <LunaraEngine/Core/Events.hpp>
+#include <LunaraEngine/Core/EventQueue.hpp>
+#include <LunaraEngine/Core/EventBus.hpp>
 #include <LunaraEngine/Core/CommonTypes.hpp>
+#include <array>
 #include <unordered_map>
 #include <vector>
 #include <utility>
@@ -47,11 +50,20 @@ namespace LunaraEngine
 
         static void OnUpdate(float dt);
 
+        static void OnFixedUpdate(float dt);
+
         static void OnImGuiDraw();
 
         static void OnEvent(Event* event);
 
+        static void OnEvents(const EventQueue& events);
+
     private:
+        using LayerSubscriptions = std::array<EventSubscription, 5>;
+
+        static void _PublishEvent(const Event& event);
+        static LayerSubscriptions _SubscribeLayer(Layer* layer);
+        static void _UnsubscribeLayer(uint32_t index);
         static uint32_t _FindLayerIndex(std::string_view name);
         static bool _ContainsLayer(std::string_view name);
         static void _PushLayer(Layer* layer, std::string_view name = "");
@@ -59,5 +71,6 @@ namespace LunaraEngine
     private:
         inline static std::vector<std::string_view> m_LayersKeys;
         inline static std::vector<Layer*> m_Layers;
+        inline static std::vector<LayerSubscriptions> m_LayersSubscriptions;
     };
 }// namespace LunaraEngine
\ No newline at end of file
@@ -0,0 +1,43 @@
+#pragma once
+#include <LunaraEngine/Math/Rect.h>
+#include <algorithm>
+#include <glm/glm.hpp>
+
+namespace LunaraEngine
+{
+    // Axis aligned box stored as its two corners
+    struct AABB {
+        glm::vec2 min{};
+        glm::vec2 max{};
+
+        [[nodiscard]] static AABB FromRect(const FRect& rect)
+        {
+            return {{rect.x, rect.y}, {rect.x + rect.w, rect.y + rect.h}};
+        }
+
+        [[nodiscard]] static AABB Union(const AABB& a, const AABB& b)
+        {
+            return {glm::min(a.min, b.min), glm::max(a.max, b.max)};
+        }
+
+        [[nodiscard]] FRect ToRect() const { return {min.x, min.y, max.x - min.x, max.y - min.y}; }
+
+        [[nodiscard]] glm::vec2 GetCenter() const { return (min + max) * 0.5f; }
+
+        [[nodiscard]] glm::vec2 GetExtents() const { return (max - min) * 0.5f; }
+
+        [[nodiscard]] float GetPerimeter() const { return 2.0f * ((max.x - min.x) + (max.y - min.y)); }
+
+        [[nodiscard]] bool Overlaps(const AABB& other) const
+        {
+            return min.x < other.max.x && other.min.x < max.x && min.y < other.max.y && other.min.y < max.y;
+        }
+
+        [[nodiscard]] bool Contains(const AABB& other) const
+        {
+            return min.x <= other.min.x && min.y <= other.min.y && other.max.x <= max.x && other.max.y <= max.y;
+        }
+
+        [[nodiscard]] AABB Expanded(glm::vec2 amount) const { return {min - amount, max + amount}; }
+    };
+}// namespace LunaraEngine
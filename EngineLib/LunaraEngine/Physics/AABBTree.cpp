@@ -0,0 +1,235 @@
+#include "AABBTree.hpp"
+#include <cstdlib>
+
+namespace LunaraEngine
+{
+    uint32_t AABBTree::CreateProxy(const AABB& bounds, uint32_t userData)
+    {
+        uint32_t proxy = AllocateNode();
+        Node& node = m_Nodes[proxy];
+        node.bounds = bounds.Expanded(glm::vec2(m_Margin));
+        node.userData = userData;
+        node.height = 0;
+        InsertLeaf(proxy);
+        m_ProxyCount++;
+        return proxy;
+    }
+
+    void AABBTree::DestroyProxy(uint32_t proxy)
+    {
+        ValidateProxy(proxy);
+        RemoveLeaf(proxy);
+        FreeNode(proxy);
+        m_ProxyCount--;
+    }
+
+    bool AABBTree::MoveProxy(uint32_t proxy, const AABB& bounds, glm::vec2 displacement)
+    {
+        ValidateProxy(proxy);
+        Node& node = m_Nodes[proxy];
+        if (node.bounds.Contains(bounds))
+        {
+            // A fat box that became far too large for a slowed down proxy is shrunk again
+            AABB largest = bounds.Expanded(glm::vec2(m_Margin * 4.0f));
+            largest.min -= glm::abs(displacement) * 4.0f;
+            largest.max += glm::abs(displacement) * 4.0f;
+            if (largest.Contains(node.bounds)) { return false; }
+        }
+
+        RemoveLeaf(proxy);
+
+        // Predict the motion so a steadily moving proxy is not reinserted every frame
+        AABB fat = bounds.Expanded(glm::vec2(m_Margin));
+        glm::vec2 prediction = displacement * 2.0f;
+        fat.min += glm::min(prediction, glm::vec2(0.0f));
+        fat.max += glm::max(prediction, glm::vec2(0.0f));
+        m_Nodes[proxy].bounds = fat;
+
+        InsertLeaf(proxy);
+        return true;
+    }
+
+    void AABBTree::ValidateProxy(uint32_t proxy) const
+    {
+        if (proxy >= m_Nodes.size() || !m_Nodes[proxy].IsLeaf() || m_Nodes[proxy].height != 0)
+        {
+            throw std::runtime_error("Invalid AABB tree proxy!");
+        }
+    }
+
+    void AABBTree::Clear()
+    {
+        m_Nodes.clear();
+        m_Root = NULL_NODE;
+        m_FreeList = NULL_NODE;
+        m_ProxyCount = 0;
+    }
+
+    uint32_t AABBTree::AllocateNode()
+    {
+        if (m_FreeList == NULL_NODE)
+        {
+            m_Nodes.emplace_back();
+            return (uint32_t) (m_Nodes.size() - 1);
+        }
+
+        uint32_t node = m_FreeList;
+        m_FreeList = m_Nodes[node].parent;
+        m_Nodes[node] = Node{};
+        return node;
+    }
+
+    void AABBTree::FreeNode(uint32_t node)
+    {
+        m_Nodes[node] = Node{};
+        m_Nodes[node].parent = m_FreeList;
+        m_FreeList = node;
+    }
+
+    void AABBTree::InsertLeaf(uint32_t leaf)
+    {
+        if (m_Root == NULL_NODE)
+        {
+            m_Root = leaf;
+            m_Nodes[leaf].parent = NULL_NODE;
+            return;
+        }
+
+        // Walk down to the sibling that grows the total perimeter the least
+        const AABB bounds = m_Nodes[leaf].bounds;
+        uint32_t index = m_Root;
+        while (!m_Nodes[index].IsLeaf())
+        {
+            const Node& node = m_Nodes[index];
+            float perimeter = node.bounds.GetPerimeter();
+            float combined = AABB::Union(node.bounds, bounds).GetPerimeter();
+
+            // Pairing with this node creates a new parent, descending moves the growth down to a child
+            float cost = 2.0f * combined;
+            float inheritance = 2.0f * (combined - perimeter);
+
+            auto descendCost = [&](uint32_t child) {
+                const Node& c = m_Nodes[child];
+                float grown = AABB::Union(c.bounds, bounds).GetPerimeter();
+                return c.IsLeaf() ? grown + inheritance : grown - c.bounds.GetPerimeter() + inheritance;
+            };
+            float cost1 = descendCost(node.child1);
+            float cost2 = descendCost(node.child2);
+
+            if (cost < cost1 && cost < cost2) { break; }
+            index = cost1 < cost2 ? node.child1 : node.child2;
+        }
+
+        uint32_t sibling = index;
+        uint32_t oldParent = m_Nodes[sibling].parent;
+        uint32_t newParent = AllocateNode();
+        Node& parent = m_Nodes[newParent];
+        parent.parent = oldParent;
+        parent.bounds = AABB::Union(bounds, m_Nodes[sibling].bounds);
+        parent.height = m_Nodes[sibling].height + 1;
+        parent.child1 = sibling;
+        parent.child2 = leaf;
+        m_Nodes[sibling].parent = newParent;
+        m_Nodes[leaf].parent = newParent;
+
+        if (oldParent == NULL_NODE) { m_Root = newParent; }
+        else if (m_Nodes[oldParent].child1 == sibling) { m_Nodes[oldParent].child1 = newParent; }
+        else { m_Nodes[oldParent].child2 = newParent; }
+
+        RefitAncestors(m_Nodes[leaf].parent);
+    }
+
+    void AABBTree::RemoveLeaf(uint32_t leaf)
+    {
+        if (leaf == m_Root)
+        {
+            m_Root = NULL_NODE;
+            return;
+        }
+
+        uint32_t parent = m_Nodes[leaf].parent;
+        uint32_t grandParent = m_Nodes[parent].parent;
+        uint32_t sibling = m_Nodes[parent].child1 == leaf ? m_Nodes[parent].child2 : m_Nodes[parent].child1;
+
+        // The sibling takes the place of the parent
+        if (grandParent == NULL_NODE)
+        {
+            m_Root = sibling;
+            m_Nodes[sibling].parent = NULL_NODE;
+        }
+        else
+        {
+            if (m_Nodes[grandParent].child1 == parent) { m_Nodes[grandParent].child1 = sibling; }
+            else { m_Nodes[grandParent].child2 = sibling; }
+            m_Nodes[sibling].parent = grandParent;
+        }
+        FreeNode(parent);
+        m_Nodes[leaf].parent = NULL_NODE;
+
+        RefitAncestors(grandParent);
+    }
+
+    void AABBTree::RefitAncestors(uint32_t node)
+    {
+        while (node != NULL_NODE)
+        {
+            node = Balance(node);
+
+            Node& current = m_Nodes[node];
+            const Node& child1 = m_Nodes[current.child1];
+            const Node& child2 = m_Nodes[current.child2];
+            current.height = 1 + std::max(child1.height, child2.height);
+            current.bounds = AABB::Union(child1.bounds, child2.bounds);
+
+            node = current.parent;
+        }
+    }
+
+    uint32_t AABBTree::Balance(uint32_t iA)
+    {
+        // When the children of A differ in height by more than one the taller child C takes the place of A, A keeps
+        // the shorter child of C and C keeps the taller one
+        Node& A = m_Nodes[iA];
+        if (A.IsLeaf() || A.height < 2) { return iA; }
+
+        uint32_t iB = A.child1;
+        uint32_t iC = A.child2;
+        int32_t balance = m_Nodes[iC].height - m_Nodes[iB].height;
+        if (std::abs(balance) <= 1) { return iA; }
+
+        // The taller child becomes the new subtree root
+        bool rotateRight = balance > 1;
+        uint32_t iUp = rotateRight ? iC : iB;
+        uint32_t iStay = rotateRight ? iB : iC;
+        Node& up = m_Nodes[iUp];
+        uint32_t iF = up.child1;
+        uint32_t iG = up.child2;
+        Node& F = m_Nodes[iF];
+        Node& G = m_Nodes[iG];
+
+        // Up replaces A under A's parent
+        up.child1 = iA;
+        up.parent = A.parent;
+        A.parent = iUp;
+        if (up.parent == NULL_NODE) { m_Root = iUp; }
+        else if (m_Nodes[up.parent].child1 == iA) { m_Nodes[up.parent].child1 = iUp; }
+        else { m_Nodes[up.parent].child2 = iUp; }
+
+        // The taller grandchild stays with Up, the shorter one moves under A
+        uint32_t iTall = F.height > G.height ? iF : iG;
+        uint32_t iShort = F.height > G.height ? iG : iF;
+        up.child2 = iTall;
+        if (rotateRight) { A.child2 = iShort; }
+        else { A.child1 = iShort; }
+        m_Nodes[iShort].parent = iA;
+
+        const Node& stay = m_Nodes[iStay];
+        const Node& shorter = m_Nodes[iShort];
+        const Node& taller = m_Nodes[iTall];
+        A.bounds = AABB::Union(stay.bounds, shorter.bounds);
+        A.height = 1 + std::max(stay.height, shorter.height);
+        up.bounds = AABB::Union(A.bounds, taller.bounds);
+        up.height = 1 + std::max(A.height, taller.height);
+        return iUp;
+    }
+}// namespace LunaraEngine
@@ -0,0 +1,224 @@
+#pragma once
+#include <LunaraEngine/Physics/AABB.hpp>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace LunaraEngine
+{
+    // Bounding volume hierarchy over fattened boxes. Leaves only move in the tree once their box leaves the fat
+    // one, so static colliders cost nothing after insertion. Nodes live in one array and are recycled through a
+    // free list, the tree is kept balanced with rotations
+    class AABBTree
+    {
+    public:
+        static constexpr uint32_t NULL_NODE = std::numeric_limits<uint32_t>::max();
+
+    public:
+        // Margin is added around every box so small movements do not touch the tree
+        explicit AABBTree(float margin = 4.0f) : m_Margin(margin) {}
+
+    public:
+        uint32_t CreateProxy(const AABB& bounds, uint32_t userData);
+        void DestroyProxy(uint32_t proxy);
+        // Returns true when the proxy had to be reinserted, the displacement extends the fat box along the motion
+        bool MoveProxy(uint32_t proxy, const AABB& bounds, glm::vec2 displacement = {});
+        void Clear();
+
+        [[nodiscard]] uint32_t GetUserData(uint32_t proxy) const { return m_Nodes[proxy].userData; }
+
+        [[nodiscard]] const AABB& GetFatBounds(uint32_t proxy) const { return m_Nodes[proxy].bounds; }
+
+        [[nodiscard]] uint32_t GetProxyCount() const { return m_ProxyCount; }
+
+        [[nodiscard]] int32_t GetHeight() const { return m_Root == NULL_NODE ? 0 : m_Nodes[m_Root].height; }
+
+    public:
+        // callback(proxy) for every fat box overlapping the bounds, returning false stops the query
+        template <typename F>
+        void Query(const AABB& bounds, F&& callback) const;
+
+        // callback(proxy, maxFraction) for every fat box the segment origin + t * translation, t in [0, maxFraction],
+        // passes through. The callback returns the new max fraction: zero stops, a smaller value clips the ray and
+        // a negative value ignores the proxy
+        template <typename F>
+        void RayCast(glm::vec2 origin, glm::vec2 translation, F&& callback, float maxFraction = 1.0f) const;
+
+        // Like RayCast for a box swept along the translation
+        template <typename F>
+        void BoxCast(const AABB& box, glm::vec2 translation, F&& callback, float maxFraction = 1.0f) const;
+
+        // Entry fraction of the segment into the box, or a negative value when it misses within maxFraction
+        [[nodiscard]] static float IntersectSegment(const AABB& box, glm::vec2 origin, glm::vec2 inverseTranslation,
+                                                    float maxFraction);
+
+    private:
+        struct Node {
+            AABB bounds{};
+            // Parent while in the tree, next free node while in the free list
+            uint32_t parent{NULL_NODE};
+            uint32_t child1{NULL_NODE};
+            uint32_t child2{NULL_NODE};
+            // Leaves are zero, free nodes minus one
+            int32_t height{-1};
+            uint32_t userData{};
+
+            [[nodiscard]] bool IsLeaf() const { return child1 == NULL_NODE; }
+        };
+
+        // Deep enough for a balanced tree of far more proxies than fit in memory
+        static constexpr size_t MAX_STACK = 128;
+
+        // Traversal stack on the stack frame, a tree deeper than expected spills to the heap instead of overflowing
+        class NodeStack
+        {
+        public:
+            void Push(uint32_t node)
+            {
+                if (m_Count < MAX_STACK) { m_Nodes[m_Count++] = node; }
+                else { m_Overflow.push_back(node); }
+            }
+
+            uint32_t Pop()
+            {
+                if (m_Overflow.empty()) { return m_Nodes[--m_Count]; }
+                uint32_t node = m_Overflow.back();
+                m_Overflow.pop_back();
+                return node;
+            }
+
+            [[nodiscard]] bool IsEmpty() const { return m_Count == 0; }
+
+        private:
+            std::array<uint32_t, MAX_STACK> m_Nodes;
+            size_t m_Count{};
+            std::vector<uint32_t> m_Overflow;
+        };
+
+        void ValidateProxy(uint32_t proxy) const;
+        uint32_t AllocateNode();
+        void FreeNode(uint32_t node);
+        void InsertLeaf(uint32_t leaf);
+        void RemoveLeaf(uint32_t leaf);
+        uint32_t Balance(uint32_t node);
+        void RefitAncestors(uint32_t node);
+
+    private:
+        std::vector<Node> m_Nodes;
+        uint32_t m_Root{NULL_NODE};
+        uint32_t m_FreeList{NULL_NODE};
+        uint32_t m_ProxyCount{};
+        float m_Margin{};
+    };
+
+    inline float AABBTree::IntersectSegment(const AABB& box, glm::vec2 origin, glm::vec2 inverseTranslation,
+                                            float maxFraction)
+    {
+        // Slab test per axis, an axis the segment does not move along only has to contain the origin
+        float enter = -std::numeric_limits<float>::infinity();
+        float exit = std::numeric_limits<float>::infinity();
+        for (int axis = 0; axis < 2; axis++)
+        {
+            if (std::isinf(inverseTranslation[axis]))
+            {
+                if (origin[axis] < box.min[axis] || origin[axis] > box.max[axis]) { return -1.0f; }
+                continue;
+            }
+            float t1 = (box.min[axis] - origin[axis]) * inverseTranslation[axis];
+            float t2 = (box.max[axis] - origin[axis]) * inverseTranslation[axis];
+            enter = std::max(enter, std::min(t1, t2));
+            exit = std::min(exit, std::max(t1, t2));
+        }
+
+        if (exit < std::max(enter, 0.0f) || enter > maxFraction) { return -1.0f; }
+        return std::max(enter, 0.0f);
+    }
+
+    template <typename F>
+    void AABBTree::Query(const AABB& bounds, F&& callback) const
+    {
+        if (m_Root == NULL_NODE) { return; }
+
+        NodeStack stack;
+        stack.Push(m_Root);
+        while (!stack.IsEmpty())
+        {
+            uint32_t index = stack.Pop();
+            const Node& node = m_Nodes[index];
+            if (!node.bounds.Overlaps(bounds)) { continue; }
+
+            if (node.IsLeaf())
+            {
+                if (!callback(index)) { return; }
+            }
+            else
+            {
+                stack.Push(node.child1);
+                stack.Push(node.child2);
+            }
+        }
+    }
+
+    template <typename F>
+    void AABBTree::RayCast(glm::vec2 origin, glm::vec2 translation, F&& callback, float maxFraction) const
+    {
+        if (m_Root == NULL_NODE) { return; }
+
+        glm::vec2 inverse = glm::vec2(1.0f) / translation;
+        NodeStack stack;
+        stack.Push(m_Root);
+        while (!stack.IsEmpty())
+        {
+            uint32_t index = stack.Pop();
+            const Node& node = m_Nodes[index];
+            if (IntersectSegment(node.bounds, origin, inverse, maxFraction) < 0.0f) { continue; }
+
+            if (node.IsLeaf())
+            {
+                float fraction = callback(index, maxFraction);
+                if (fraction == 0.0f) { return; }
+                if (fraction > 0.0f) { maxFraction = std::min(maxFraction, fraction); }
+            }
+            else
+            {
+                stack.Push(node.child1);
+                stack.Push(node.child2);
+            }
+        }
+    }
+
+    template <typename F>
+    void AABBTree::BoxCast(const AABB& box, glm::vec2 translation, F&& callback, float maxFraction) const
+    {
+        if (m_Root == NULL_NODE) { return; }
+
+        // The box against a node is its center against the node grown by the box extents
+        glm::vec2 extents = box.GetExtents();
+        glm::vec2 origin = box.GetCenter();
+        glm::vec2 inverse = glm::vec2(1.0f) / translation;
+        NodeStack stack;
+        stack.Push(m_Root);
+        while (!stack.IsEmpty())
+        {
+            uint32_t index = stack.Pop();
+            const Node& node = m_Nodes[index];
+            if (IntersectSegment(node.bounds.Expanded(extents), origin, inverse, maxFraction) < 0.0f) { continue; }
+
+            if (node.IsLeaf())
+            {
+                float fraction = callback(index, maxFraction);
+                if (fraction == 0.0f) { return; }
+                if (fraction > 0.0f) { maxFraction = std::min(maxFraction, fraction); }
+            }
+            else
+            {
+                stack.Push(node.child1);
+                stack.Push(node.child2);
+            }
+        }
+    }
+}// namespace LunaraEngine
@@ -0,0 +1,416 @@
+#pragma once
+#include <LunaraEngine/Physics/AABB.hpp>
+#include <LunaraEngine/Physics/SpatialHash.hpp>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#define LUNARA_BATCH_SSE
+#endif
+
+// GCC and Clang compile the AVX2 path for every x86 target and pick it at runtime, MSVC only when built for AVX2
+#if defined(LUNARA_BATCH_SSE) && (defined(__GNUC__) || defined(__clang__))
+#define LUNARA_BATCH_AVX2
+#define LUNARA_BATCH_AVX2_TARGET __attribute__((target("avx2")))
+#elif defined(LUNARA_BATCH_SSE) && defined(__AVX2__)
+#define LUNARA_BATCH_AVX2
+#define LUNARA_BATCH_AVX2_TARGET
+#endif
+
+namespace LunaraEngine
+{
+    // Boxes as four float arrays so a whole register of boxes is tested at once
+    class AABBBatch
+    {
+    public:
+        AABBBatch() = default;
+
+        explicit AABBBatch(size_t count) { Resize(count); }
+
+    public:
+        void Resize(size_t count)
+        {
+            m_MinX.resize(count);
+            m_MinY.resize(count);
+            m_MaxX.resize(count);
+            m_MaxY.resize(count);
+        }
+
+        void Reserve(size_t count)
+        {
+            m_MinX.reserve(count);
+            m_MinY.reserve(count);
+            m_MaxX.reserve(count);
+            m_MaxY.reserve(count);
+        }
+
+        void Clear() { Resize(0); }
+
+        void Push(const AABB& box)
+        {
+            m_MinX.push_back(box.min.x);
+            m_MinY.push_back(box.min.y);
+            m_MaxX.push_back(box.max.x);
+            m_MaxY.push_back(box.max.y);
+        }
+
+        void Set(size_t index, const AABB& box)
+        {
+            m_MinX[index] = box.min.x;
+            m_MinY[index] = box.min.y;
+            m_MaxX[index] = box.max.x;
+            m_MaxY[index] = box.max.y;
+        }
+
+        [[nodiscard]] AABB Get(size_t index) const
+        {
+            return {{m_MinX[index], m_MinY[index]}, {m_MaxX[index], m_MaxY[index]}};
+        }
+
+        [[nodiscard]] size_t GetCount() const { return m_MinX.size(); }
+
+        [[nodiscard]] const float* GetMinX() const { return m_MinX.data(); }
+
+        [[nodiscard]] const float* GetMinY() const { return m_MinY.data(); }
+
+        [[nodiscard]] const float* GetMaxX() const { return m_MaxX.data(); }
+
+        [[nodiscard]] const float* GetMaxY() const { return m_MaxY.data(); }
+
+    private:
+        std::vector<float> m_MinX;
+        std::vector<float> m_MinY;
+        std::vector<float> m_MaxX;
+        std::vector<float> m_MaxY;
+    };
+
+    enum class SimdLevel
+    {
+        Scalar = 0,
+        SSE,
+        AVX2
+    };
+
+    // Narrowphase overlap tests over many boxes at once, with the same strict comparison as AABB::Overlaps.
+    // Results are either a bitmask with one bit per tested box or pair, or the compacted list of hits. The
+    // instruction set is detected on first use
+    class BatchCollisions
+    {
+    public:
+        // Words a bitmask for count results needs
+        [[nodiscard]] static size_t GetMaskWords(size_t count) { return (count + 63) / 64; }
+
+        // The box against every box of the batch, returns the number of hits. Masks need GetMaskWords(count) words
+        static size_t Overlap(const AABB& box, const AABBBatch& batch, std::span<uint64_t> mask);
+        static size_t Overlap(const AABB& box, const AABBBatch& batch, std::vector<uint32_t>& hits);
+
+        // Candidate pairs of batch indices, usually from a broadphase, returns the number of overlapping ones
+        static size_t OverlapPairs(const AABBBatch& batch, std::span<const BroadphasePair> pairs,
+                                   std::span<uint64_t> mask);
+        static size_t OverlapPairs(const AABBBatch& batch, std::span<const BroadphasePair> pairs,
+                                   std::vector<BroadphasePair>& hits);
+
+        [[nodiscard]] static SimdLevel GetSupportedSimdLevel();
+
+        [[nodiscard]] static SimdLevel GetSimdLevel() { return GetLevel().load(std::memory_order_relaxed); }
+
+        // Forces a lower level, mostly to compare the paths. Levels the CPU lacks fall back to the supported one
+        static void SetSimdLevel(SimdLevel level)
+        {
+            GetLevel().store(std::min(level, GetSupportedSimdLevel()), std::memory_order_relaxed);
+        }
+
+    private:
+        // Every kernel reports its results as sink(first, bits), bit i standing for index first + i. A bits word
+        // never crosses a 64 index boundary
+        template <typename Sink>
+        static void OverlapScalar(const AABB& box, const AABBBatch& batch, size_t begin, Sink& sink);
+        template <typename Sink>
+        static void OverlapPairsScalar(const AABBBatch& batch, std::span<const BroadphasePair> pairs, size_t begin,
+                                       Sink& sink);
+#ifdef LUNARA_BATCH_SSE
+        template <typename Sink>
+        static size_t OverlapSSE(const AABB& box, const AABBBatch& batch, Sink& sink);
+#endif
+#ifdef LUNARA_BATCH_AVX2
+        template <typename Sink>
+        LUNARA_BATCH_AVX2_TARGET static size_t OverlapAVX2(const AABB& box, const AABBBatch& batch, Sink& sink);
+        template <typename Sink>
+        LUNARA_BATCH_AVX2_TARGET static size_t OverlapPairsAVX2(const AABBBatch& batch,
+                                                                std::span<const BroadphasePair> pairs, Sink& sink);
+#endif
+
+        template <typename Sink>
+        static void Dispatch(const AABB& box, const AABBBatch& batch, Sink& sink);
+        template <typename Sink>
+        static void DispatchPairs(const AABBBatch& batch, std::span<const BroadphasePair> pairs, Sink& sink);
+
+        // Detected by the first caller from any thread, the static initializer runs exactly once
+        static std::atomic<SimdLevel>& GetLevel()
+        {
+            static std::atomic<SimdLevel> level{GetSupportedSimdLevel()};
+            return level;
+        }
+    };
+
+    inline SimdLevel BatchCollisions::GetSupportedSimdLevel()
+    {
+#if defined(LUNARA_BATCH_AVX2) && (defined(__GNUC__) || defined(__clang__))
+        if (__builtin_cpu_supports("avx2")) { return SimdLevel::AVX2; }
+#elif defined(LUNARA_BATCH_AVX2)
+        return SimdLevel::AVX2;
+#endif
+#ifdef LUNARA_BATCH_SSE
+        return SimdLevel::SSE;
+#else
+        return SimdLevel::Scalar;
+#endif
+    }
+
+    template <typename Sink>
+    void BatchCollisions::OverlapScalar(const AABB& box, const AABBBatch& batch, size_t begin, Sink& sink)
+    {
+        const float* minX = batch.GetMinX();
+        const float* minY = batch.GetMinY();
+        const float* maxX = batch.GetMaxX();
+        const float* maxY = batch.GetMaxY();
+        const size_t count = batch.GetCount();
+        while (begin < count)
+        {
+            size_t end = std::min(count, (begin / 64 + 1) * 64);
+            uint64_t bits = 0;
+            for (size_t i = begin; i < end; i++)
+            {
+                if (minX[i] < box.max.x && box.min.x < maxX[i] && minY[i] < box.max.y && box.min.y < maxY[i])
+                {
+                    bits |= uint64_t{1} << (i - begin);
+                }
+            }
+            sink(begin, bits);
+            begin = end;
+        }
+    }
+
+    template <typename Sink>
+    void BatchCollisions::OverlapPairsScalar(const AABBBatch& batch, std::span<const BroadphasePair> pairs,
+                                             size_t begin, Sink& sink)
+    {
+        const float* minX = batch.GetMinX();
+        const float* minY = batch.GetMinY();
+        const float* maxX = batch.GetMaxX();
+        const float* maxY = batch.GetMaxY();
+        while (begin < pairs.size())
+        {
+            size_t end = std::min(pairs.size(), (begin / 64 + 1) * 64);
+            uint64_t bits = 0;
+            for (size_t i = begin; i < end; i++)
+            {
+                uint32_t a = pairs[i].a;
+                uint32_t b = pairs[i].b;
+                bool hit = (minX[a] < maxX[b]) & (minX[b] < maxX[a]) & (minY[a] < maxY[b]) & (minY[b] < maxY[a]);
+                bits |= (uint64_t) hit << (i - begin);
+            }
+            sink(begin, bits);
+            begin = end;
+        }
+    }
+
+#ifdef LUNARA_BATCH_SSE
+    template <typename Sink>
+    size_t BatchCollisions::OverlapSSE(const AABB& box, const AABBBatch& batch, Sink& sink)
+    {
+        const __m128 boxMinX = _mm_set1_ps(box.min.x);
+        const __m128 boxMinY = _mm_set1_ps(box.min.y);
+        const __m128 boxMaxX = _mm_set1_ps(box.max.x);
+        const __m128 boxMaxY = _mm_set1_ps(box.max.y);
+        const size_t count = batch.GetCount();
+
+        // Sixteen boxes per reported word keep the sink calls rare
+        size_t i = 0;
+        for (; i + 16 <= count; i += 16)
+        {
+            uint64_t bits = 0;
+            for (size_t j = 0; j < 16; j += 4)
+            {
+                size_t index = i + j;
+                __m128 minX = _mm_loadu_ps(batch.GetMinX() + index);
+                __m128 minY = _mm_loadu_ps(batch.GetMinY() + index);
+                __m128 maxX = _mm_loadu_ps(batch.GetMaxX() + index);
+                __m128 maxY = _mm_loadu_ps(batch.GetMaxY() + index);
+                __m128 hit = _mm_and_ps(_mm_cmplt_ps(minX, boxMaxX), _mm_cmplt_ps(boxMinX, maxX));
+                hit = _mm_and_ps(hit, _mm_cmplt_ps(minY, boxMaxY));
+                hit = _mm_and_ps(hit, _mm_cmplt_ps(boxMinY, maxY));
+                bits |= (uint64_t) _mm_movemask_ps(hit) << j;
+            }
+            if (bits != 0) { sink(i, bits); }
+        }
+        return i;
+    }
+#endif
+
+#ifdef LUNARA_BATCH_AVX2
+    template <typename Sink>
+    size_t BatchCollisions::OverlapAVX2(const AABB& box, const AABBBatch& batch, Sink& sink)
+    {
+        const __m256 boxMinX = _mm256_set1_ps(box.min.x);
+        const __m256 boxMinY = _mm256_set1_ps(box.min.y);
+        const __m256 boxMaxX = _mm256_set1_ps(box.max.x);
+        const __m256 boxMaxY = _mm256_set1_ps(box.max.y);
+        const size_t count = batch.GetCount();
+
+        size_t i = 0;
+        for (; i + 32 <= count; i += 32)
+        {
+            uint64_t bits = 0;
+            for (size_t j = 0; j < 32; j += 8)
+            {
+                size_t index = i + j;
+                __m256 minX = _mm256_loadu_ps(batch.GetMinX() + index);
+                __m256 minY = _mm256_loadu_ps(batch.GetMinY() + index);
+                __m256 maxX = _mm256_loadu_ps(batch.GetMaxX() + index);
+                __m256 maxY = _mm256_loadu_ps(batch.GetMaxY() + index);
+                __m256 hit = _mm256_cmp_ps(minX, boxMaxX, _CMP_LT_OQ);
+                hit = _mm256_and_ps(hit, _mm256_cmp_ps(boxMinX, maxX, _CMP_LT_OQ));
+                hit = _mm256_and_ps(hit, _mm256_cmp_ps(minY, boxMaxY, _CMP_LT_OQ));
+                hit = _mm256_and_ps(hit, _mm256_cmp_ps(boxMinY, maxY, _CMP_LT_OQ));
+                bits |= (uint64_t) (uint32_t) _mm256_movemask_ps(hit) << j;
+            }
+            if (bits != 0) { sink(i, bits); }
+        }
+        return i;
+    }
+
+    template <typename Sink>
+    size_t BatchCollisions::OverlapPairsAVX2(const AABBBatch& batch, std::span<const BroadphasePair> pairs, Sink& sink)
+    {
+        static_assert(sizeof(BroadphasePair) == 2 * sizeof(uint32_t), "pairs are loaded as interleaved indices");
+
+        // Interleaved a0 b0 a1 b1 ... become a0 a1 a2 a3 b0 b1 b2 b3 within each register
+        const __m256i split = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+        const auto* indices = reinterpret_cast<const __m256i*>(pairs.data());
+
+        const float* minX = batch.GetMinX();
+        const float* minY = batch.GetMinY();
+        const float* maxX = batch.GetMaxX();
+        const float* maxY = batch.GetMaxY();
+
+        size_t i = 0;
+        for (; i + 32 <= pairs.size(); i += 32)
+        {
+            uint64_t bits = 0;
+            for (size_t j = 0; j < 32; j += 8)
+            {
+                size_t index = (i + j) / 4;
+                __m256i low = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(indices + index), split);
+                __m256i high = _mm256_permutevar8x32_epi32(_mm256_loadu_si256(indices + index + 1), split);
+                __m256i a = _mm256_permute2x128_si256(low, high, 0x20);
+                __m256i b = _mm256_permute2x128_si256(low, high, 0x31);
+
+                __m256 hit = _mm256_cmp_ps(_mm256_i32gather_ps(minX, a, 4), _mm256_i32gather_ps(maxX, b, 4),
+                                           _CMP_LT_OQ);
+                hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_i32gather_ps(minX, b, 4), _mm256_i32gather_ps(maxX, a, 4),
+                                                       _CMP_LT_OQ));
+                hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_i32gather_ps(minY, a, 4), _mm256_i32gather_ps(maxY, b, 4),
+                                                       _CMP_LT_OQ));
+                hit = _mm256_and_ps(hit, _mm256_cmp_ps(_mm256_i32gather_ps(minY, b, 4), _mm256_i32gather_ps(maxY, a, 4),
+                                                       _CMP_LT_OQ));
+                bits |= (uint64_t) (uint32_t) _mm256_movemask_ps(hit) << j;
+            }
+            if (bits != 0) { sink(i, bits); }
+        }
+        return i;
+    }
+#endif
+
+    template <typename Sink>
+    void BatchCollisions::Dispatch(const AABB& box, const AABBBatch& batch, Sink& sink)
+    {
+        // The vector paths stop at a multiple of their block size, the scalar loop finishes the tail
+        size_t begin = 0;
+        switch (GetSimdLevel())
+        {
+#ifdef LUNARA_BATCH_AVX2
+            case SimdLevel::AVX2:
+                begin = OverlapAVX2(box, batch, sink);
+                break;
+#endif
+#ifdef LUNARA_BATCH_SSE
+            case SimdLevel::SSE:
+                begin = OverlapSSE(box, batch, sink);
+                break;
+#endif
+            default:
+                break;
+        }
+        OverlapScalar(box, batch, begin, sink);
+    }
+
+    template <typename Sink>
+    void BatchCollisions::DispatchPairs(const AABBBatch& batch, std::span<const BroadphasePair> pairs, Sink& sink)
+    {
+        // SSE has no gather, loading the pairs one by one is what the scalar loop already does
+        size_t begin = 0;
+#ifdef LUNARA_BATCH_AVX2
+        if (GetSimdLevel() == SimdLevel::AVX2) { begin = OverlapPairsAVX2(batch, pairs, sink); }
+#endif
+        OverlapPairsScalar(batch, pairs, begin, sink);
+    }
+
+    inline size_t BatchCollisions::Overlap(const AABB& box, const AABBBatch& batch, std::span<uint64_t> mask)
+    {
+        if (mask.size() < GetMaskWords(batch.GetCount())) { throw std::runtime_error("Collision mask is too small!"); }
+        std::fill_n(mask.begin(), GetMaskWords(batch.GetCount()), uint64_t{});
+        size_t hits = 0;
+        auto sink = [&](size_t first, uint64_t bits) {
+            mask[first / 64] |= bits << (first % 64);
+            hits += (size_t) std::popcount(bits);
+        };
+        Dispatch(box, batch, sink);
+        return hits;
+    }
+
+    inline size_t BatchCollisions::Overlap(const AABB& box, const AABBBatch& batch, std::vector<uint32_t>& hits)
+    {
+        hits.clear();
+        auto sink = [&](size_t first, uint64_t bits) {
+            for (; bits != 0; bits &= bits - 1)
+            {
+                hits.push_back((uint32_t) (first + (size_t) std::countr_zero(bits)));
+            }
+        };
+        Dispatch(box, batch, sink);
+        return hits.size();
+    }
+
+    inline size_t BatchCollisions::OverlapPairs(const AABBBatch& batch, std::span<const BroadphasePair> pairs,
+                                                std::span<uint64_t> mask)
+    {
+        if (mask.size() < GetMaskWords(pairs.size())) { throw std::runtime_error("Collision mask is too small!"); }
+        std::fill_n(mask.begin(), GetMaskWords(pairs.size()), uint64_t{});
+        size_t hits = 0;
+        auto sink = [&](size_t first, uint64_t bits) {
+            mask[first / 64] |= bits << (first % 64);
+            hits += (size_t) std::popcount(bits);
+        };
+        DispatchPairs(batch, pairs, sink);
+        return hits;
+    }
+
+    inline size_t BatchCollisions::OverlapPairs(const AABBBatch& batch, std::span<const BroadphasePair> pairs,
+                                                std::vector<BroadphasePair>& hits)
+    {
+        hits.clear();
+        auto sink = [&](size_t first, uint64_t bits) {
+            for (; bits != 0; bits &= bits - 1) { hits.push_back(pairs[first + (size_t) std::countr_zero(bits)]); }
+        };
+        DispatchPairs(batch, pairs, sink);
+        return hits.size();
+    }
+}// namespace LunaraEngine
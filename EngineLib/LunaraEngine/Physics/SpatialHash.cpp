@@ -0,0 +1,233 @@
+#include "SpatialHash.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+
+namespace LunaraEngine
+{
+    uint32_t SpatialHash::Insert(const FRect& bounds, uint32_t layer, uint32_t mask)
+    {
+        m_Bounds.push_back(bounds);
+        m_Layers.push_back(layer);
+        m_Masks.push_back(mask);
+        m_Dirty = true;
+        return (uint32_t) (m_Bounds.size() - 1);
+    }
+
+    uint32_t SpatialHash::Insert(std::span<const FRect> bounds, std::span<const uint32_t> layers,
+                                 std::span<const uint32_t> masks)
+    {
+        if ((!layers.empty() && layers.size() != bounds.size()) || (!masks.empty() && masks.size() != bounds.size()))
+        {
+            throw std::runtime_error("Spatial hash layers and masks have to match the bounds!");
+        }
+
+        auto first = (uint32_t) m_Bounds.size();
+        m_Bounds.insert(m_Bounds.end(), bounds.begin(), bounds.end());
+        if (layers.empty()) { m_Layers.resize(m_Bounds.size(), 1); }
+        else { m_Layers.insert(m_Layers.end(), layers.begin(), layers.end()); }
+        if (masks.empty()) { m_Masks.resize(m_Bounds.size(), ALL_LAYERS); }
+        else { m_Masks.insert(m_Masks.end(), masks.begin(), masks.end()); }
+        m_Dirty = true;
+        return first;
+    }
+
+    void SpatialHash::Update(uint32_t body, const FRect& bounds)
+    {
+        m_Bounds[body] = bounds;
+        m_Dirty = true;
+    }
+
+    void SpatialHash::Update(std::span<const FRect> bounds, uint32_t firstBody)
+    {
+        if (firstBody + bounds.size() > m_Bounds.size())
+        {
+            throw std::runtime_error("Spatial hash update is out of range!");
+        }
+        std::ranges::copy(bounds, m_Bounds.begin() + firstBody);
+        m_Dirty = true;
+    }
+
+    void SpatialHash::Clear()
+    {
+        m_Bounds.clear();
+        m_Layers.clear();
+        m_Masks.clear();
+        m_Dirty = true;
+    }
+
+    void SpatialHash::SetCellSize(float cellSize)
+    {
+        if (cellSize <= 0.0f) { throw std::runtime_error("Spatial hash cell size has to be positive!"); }
+        m_CellSize = cellSize;
+        m_InverseCellSize = 1.0f / cellSize;
+        m_Dirty = true;
+    }
+
+    void SpatialHash::FindPairs(std::vector<BroadphasePair>& pairs)
+    {
+        if (m_Dirty) { Rebuild(); }
+
+        pairs.clear();
+        for (uint32_t bucket = 0; bucket + 1 < (uint32_t) m_BucketStarts.size(); bucket++)
+        {
+            uint32_t end = m_BucketStarts[bucket + 1];
+            for (uint32_t i = m_BucketStarts[bucket]; i < end; i++)
+            {
+                const Entry& a = m_Entries[i];
+                for (uint32_t j = i + 1; j < end; j++)
+                {
+                    const Entry& b = m_Entries[j];
+                    if ((a.mask & b.layer) == 0 && (b.mask & a.layer) == 0) { continue; }
+                    if (!Overlaps(a.bounds, b.bounds)) { continue; }
+
+                    // Bodies sharing several cells meet in several buckets, only the bucket of the cell holding
+                    // the corner of their intersection reports them
+                    int32_t x = ToCell(std::max(a.bounds.x, b.bounds.x));
+                    int32_t y = ToCell(std::max(a.bounds.y, b.bounds.y));
+                    if (GetBucket(x, y) != bucket) { continue; }
+
+                    pairs.push_back({std::min(a.body, b.body), std::max(a.body, b.body)});
+                }
+            }
+        }
+    }
+
+    void SpatialHash::QueryRegion(const FRect& region, std::vector<uint32_t>& bodies, uint32_t mask)
+    {
+        if (m_Dirty) { Rebuild(); }
+
+        bodies.clear();
+        if (m_Bounds.empty()) { return; }
+
+        CellRange range = GetCellRange(region);
+        for (int32_t y = range.minY; y <= range.maxY; y++)
+        {
+            for (int32_t x = range.minX; x <= range.maxX; x++)
+            {
+                uint32_t bucket = GetBucket(x, y);
+                for (uint32_t e = m_BucketStarts[bucket]; e < m_BucketStarts[bucket + 1]; e++)
+                {
+                    const Entry& entry = m_Entries[e];
+                    if ((entry.layer & mask) == 0 || !Overlaps(region, entry.bounds)) { continue; }
+                    // The body is listed once, in the cell holding the corner of its overlap with the region
+                    if (ToCell(std::max(region.x, entry.bounds.x)) != x ||
+                        ToCell(std::max(region.y, entry.bounds.y)) != y)
+                    {
+                        continue;
+                    }
+                    bodies.push_back(entry.body);
+                }
+            }
+        }
+    }
+
+    void SpatialHash::QueryPoint(glm::vec2 point, std::vector<uint32_t>& bodies, uint32_t mask)
+    {
+        if (m_Dirty) { Rebuild(); }
+
+        bodies.clear();
+        if (m_Bounds.empty()) { return; }
+
+        // A point lies in one cell and a body is stored once per bucket
+        uint32_t bucket = GetBucket(ToCell(point.x), ToCell(point.y));
+        for (uint32_t e = m_BucketStarts[bucket]; e < m_BucketStarts[bucket + 1]; e++)
+        {
+            const Entry& entry = m_Entries[e];
+            const FRect& bounds = entry.bounds;
+            if ((entry.layer & mask) == 0) { continue; }
+            if (point.x >= bounds.x && point.x < bounds.x + bounds.w && point.y >= bounds.y &&
+                point.y < bounds.y + bounds.h)
+            {
+                bodies.push_back(entry.body);
+            }
+        }
+    }
+
+    void SpatialHash::Rebuild()
+    {
+        m_Dirty = false;
+        const auto bodyCount = (uint32_t) m_Bounds.size();
+        m_CellRanges.resize(bodyCount);
+
+        size_t cellCount = 0;
+        for (uint32_t body = 0; body < bodyCount; body++)
+        {
+            CellRange& range = m_CellRanges[body];
+            range = GetCellRange(m_Bounds[body]);
+            cellCount += (size_t) (range.maxX - range.minX + 1) * (size_t) (range.maxY - range.minY + 1);
+        }
+
+        size_t bucketCount = std::bit_ceil(std::max<size_t>(cellCount, 16));
+        m_BucketShift = (uint32_t) (64 - std::countr_zero(bucketCount));
+        m_BucketStarts.assign(bucketCount + 1, 0);
+
+        // The buckets of every body are hashed once and reused for the scatter below
+        m_BodyBuckets.clear();
+        m_BodyBucketStarts.resize(bodyCount + 1);
+        for (uint32_t body = 0; body < bodyCount; body++)
+        {
+            m_BodyBucketStarts[body] = (uint32_t) m_BodyBuckets.size();
+            AppendBuckets(m_CellRanges[body]);
+        }
+        m_BodyBucketStarts[bodyCount] = (uint32_t) m_BodyBuckets.size();
+
+        for (uint32_t bucket: m_BodyBuckets) { m_BucketStarts[bucket + 1]++; }
+        for (size_t i = 1; i <= bucketCount; i++) { m_BucketStarts[i] += m_BucketStarts[i - 1]; }
+        m_Entries.resize(m_BodyBuckets.size());
+
+        // Bodies are written in id order, the starts are restored by walking the buckets back afterwards
+        for (uint32_t body = 0; body < bodyCount; body++)
+        {
+            Entry entry{m_Bounds[body], body, m_Layers[body], m_Masks[body]};
+            for (uint32_t b = m_BodyBucketStarts[body]; b < m_BodyBucketStarts[body + 1]; b++)
+            {
+                m_Entries[m_BucketStarts[m_BodyBuckets[b]]++] = entry;
+            }
+        }
+        for (size_t i = bucketCount; i > 0; i--) { m_BucketStarts[i] = m_BucketStarts[i - 1]; }
+        m_BucketStarts[0] = 0;
+    }
+
+    void SpatialHash::AppendBuckets(const CellRange& range)
+    {
+        auto first = (ptrdiff_t) m_BodyBuckets.size();
+        for (int32_t y = range.minY; y <= range.maxY; y++)
+        {
+            for (int32_t x = range.minX; x <= range.maxX; x++)
+            {
+                // Cells of one body that hash to the same bucket must not list the body twice
+                uint32_t bucket = GetBucket(x, y);
+                auto begin = m_BodyBuckets.begin() + first;
+                if (m_BodyBuckets.end() - begin > (ptrdiff_t) SMALL_RANGE_CELLS ||
+                    std::find(begin, m_BodyBuckets.end(), bucket) == m_BodyBuckets.end())
+                {
+                    m_BodyBuckets.push_back(bucket);
+                }
+            }
+        }
+
+        // Large bodies skip the linear check above and are deduplicated in one go
+        auto begin = m_BodyBuckets.begin() + first;
+        if (m_BodyBuckets.end() - begin > (ptrdiff_t) SMALL_RANGE_CELLS)
+        {
+            std::sort(begin, m_BodyBuckets.end());
+            m_BodyBuckets.erase(std::unique(begin, m_BodyBuckets.end()), m_BodyBuckets.end());
+        }
+    }
+
+    int32_t SpatialHash::ToCell(float value) const { return (int32_t) std::floor(value * m_InverseCellSize); }
+
+    SpatialHash::CellRange SpatialHash::GetCellRange(const FRect& bounds) const
+    {
+        return {ToCell(bounds.x), ToCell(bounds.y), ToCell(bounds.x + bounds.w), ToCell(bounds.y + bounds.h)};
+    }
+
+    uint32_t SpatialHash::GetBucket(int32_t x, int32_t y) const
+    {
+        // Fibonacci hashing of both coordinates, the high bits of the product are the well mixed ones
+        uint64_t key = ((uint64_t) (uint32_t) x << 32) | (uint32_t) y;
+        return (uint32_t) ((key * 0x9E3779B97F4A7C15ull) >> m_BucketShift);
+    }
+}// namespace LunaraEngine
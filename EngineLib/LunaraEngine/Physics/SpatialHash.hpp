@@ -0,0 +1,98 @@
+#pragma once
+#include <LunaraEngine/Math/Rect.h>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace LunaraEngine
+{
+    struct BroadphasePair {
+        uint32_t a{};
+        uint32_t b{};
+    };
+
+    // Uniform grid broadphase. Cells are hashed into a flat bucket table that is rebuilt with a counting sort
+    // whenever bodies changed, which suits scenes where most bodies move every frame. Bodies are identified by
+    // the order they were inserted in
+    class SpatialHash
+    {
+    public:
+        static constexpr uint32_t ALL_LAYERS = 0xFFFFFFFF;
+
+    public:
+        explicit SpatialHash(float cellSize = 64.0f) { SetCellSize(cellSize); }
+
+    public:
+        uint32_t Insert(const FRect& bounds, uint32_t layer = 1, uint32_t mask = ALL_LAYERS);
+        // Appends all bodies at once, returns the id of the first one
+        uint32_t Insert(std::span<const FRect> bounds, std::span<const uint32_t> layers = {},
+                        std::span<const uint32_t> masks = {});
+        void Update(uint32_t body, const FRect& bounds);
+        // Replaces the bounds of the bodies starting at firstBody
+        void Update(std::span<const FRect> bounds, uint32_t firstBody = 0);
+        void Clear();
+
+        void SetCellSize(float cellSize);
+
+        [[nodiscard]] float GetCellSize() const { return m_CellSize; }
+
+        [[nodiscard]] size_t GetBodyCount() const { return m_Bounds.size(); }
+
+        [[nodiscard]] const FRect& GetBounds(uint32_t body) const { return m_Bounds[body]; }
+
+    public:
+        // Every overlapping pair exactly once, a pair counts when either body's mask contains the other's layer
+        void FindPairs(std::vector<BroadphasePair>& pairs);
+        // Bodies overlapping the region whose layer is in the mask, each body at most once
+        void QueryRegion(const FRect& region, std::vector<uint32_t>& bodies, uint32_t mask = ALL_LAYERS);
+        void QueryPoint(glm::vec2 point, std::vector<uint32_t>& bodies, uint32_t mask = ALL_LAYERS);
+
+        [[nodiscard]] static bool Overlaps(const FRect& a, const FRect& b)
+        {
+            return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+        }
+
+    private:
+        static constexpr size_t SMALL_RANGE_CELLS = 8;
+
+        // Bodies are copied into every bucket they touch so a bucket is scanned without leaving its memory
+        struct Entry {
+            FRect bounds{};
+            uint32_t body{};
+            uint32_t layer{};
+            uint32_t mask{};
+        };
+
+        struct CellRange {
+            int32_t minX{};
+            int32_t minY{};
+            int32_t maxX{};
+            int32_t maxY{};
+        };
+
+        void Rebuild();
+        [[nodiscard]] int32_t ToCell(float value) const;
+        [[nodiscard]] CellRange GetCellRange(const FRect& bounds) const;
+        [[nodiscard]] uint32_t GetBucket(int32_t x, int32_t y) const;
+        void AppendBuckets(const CellRange& range);
+
+    private:
+        float m_CellSize{};
+        float m_InverseCellSize{};
+        bool m_Dirty{};
+
+        std::vector<FRect> m_Bounds;
+        std::vector<uint32_t> m_Layers;
+        std::vector<uint32_t> m_Masks;
+        std::vector<CellRange> m_CellRanges;
+
+        // Bodies of bucket i are m_Entries[m_BucketStarts[i], m_BucketStarts[i + 1])
+        std::vector<uint32_t> m_BucketStarts;
+        std::vector<Entry> m_Entries;
+        uint32_t m_BucketShift{};
+        // Buckets touched by body i are m_BodyBuckets[m_BodyBucketStarts[i], m_BodyBucketStarts[i + 1])
+        std::vector<uint32_t> m_BodyBuckets;
+        std::vector<uint32_t> m_BodyBucketStarts;
+    };
+}// namespace LunaraEngine
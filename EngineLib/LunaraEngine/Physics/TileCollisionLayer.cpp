@@ -0,0 +1,258 @@
+#include "TileCollisionLayer.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+
+namespace LunaraEngine
+{
+    void TileCollisionLayer::Create(uint32_t width, uint32_t height, float tileSize, glm::vec2 origin)
+    {
+        if (tileSize <= 0.0f) { throw std::runtime_error("Tile collision layer tile size has to be positive!"); }
+
+        m_Width = width;
+        m_Height = height;
+        m_WordsPerRow = (width + 63) / 64;
+        m_TileSize = tileSize;
+        m_InverseTileSize = 1.0f / tileSize;
+        m_Origin = origin;
+        m_Bits.assign((size_t) m_WordsPerRow * height, 0);
+    }
+
+    void TileCollisionLayer::SetSolid(uint32_t x, uint32_t y, bool solid)
+    {
+        if (x >= m_Width || y >= m_Height) { return; }
+
+        uint64_t& word = GetRow(y)[x / 64];
+        uint64_t bit = uint64_t{1} << (x % 64);
+        word = solid ? word | bit : word & ~bit;
+    }
+
+    void TileCollisionLayer::SetSolid(uint32_t x, uint32_t y, uint32_t width, uint32_t height, bool solid)
+    {
+        if (x >= m_Width || y >= m_Height || width == 0 || height == 0) { return; }
+
+        uint32_t maxX = x + std::min(width, m_Width - x) - 1;
+        uint32_t maxY = y + std::min(height, m_Height - y) - 1;
+        for (uint32_t row = y; row <= maxY; row++)
+        {
+            uint64_t* words = GetRow(row);
+            for (uint32_t w = x / 64; w <= maxX / 64; w++)
+            {
+                uint64_t mask = ~uint64_t{};
+                if (w == x / 64) { mask &= ~uint64_t{} << (x % 64); }
+                if (w == maxX / 64) { mask &= ~uint64_t{} >> (63 - maxX % 64); }
+                words[w] = solid ? words[w] | mask : words[w] & ~mask;
+            }
+        }
+    }
+
+    void TileCollisionLayer::Clear() { std::ranges::fill(m_Bits, uint64_t{}); }
+
+    bool TileCollisionLayer::Overlaps(const AABB& box) const
+    {
+        TileRange range = GetTileRange({box.min - m_Origin, box.max - m_Origin});
+        for (int64_t y = range.minY; y <= range.maxY; y++)
+        {
+            if (range.minX <= range.maxX && AnySolid((uint32_t) y, (uint32_t) range.minX, (uint32_t) range.maxX))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    TileSweepResult TileCollisionLayer::Sweep(const AABB& box, glm::vec2 displacement) const
+    {
+        TileSweepResult result;
+        glm::vec2 min = box.min - m_Origin;
+        glm::vec2 max = box.max - m_Origin;
+
+        // Separate axes let a box slide along a wall instead of sticking to it
+        result.displacement.x = SweepX(GetTileRange({min, max}), min.x, max.x, displacement.x);
+        result.hitX = result.displacement.x != displacement.x;
+        min.x += result.displacement.x;
+        max.x += result.displacement.x;
+
+        result.displacement.y = SweepY(GetTileRange({min, max}), min.y, max.y, displacement.y);
+        result.hitY = result.displacement.y != displacement.y;
+        return result;
+    }
+
+    bool TileCollisionLayer::RayCast(glm::vec2 origin, glm::vec2 translation, TileRayHit& hit) const
+    {
+        if (m_Bits.empty()) { return false; }
+
+        // Amanatides and Woo traversal, every tile the segment passes through is visited once in order
+        glm::vec2 start = (origin - m_Origin) * m_InverseTileSize;
+        glm::vec2 delta = translation * m_InverseTileSize;
+        int64_t tile[2] = {(int64_t) std::floor(start.x), (int64_t) std::floor(start.y)};
+        int64_t step[2]{};
+        float next[2]{};
+        float stepFraction[2]{};
+        uint64_t steps = 0;
+        for (int axis = 0; axis < 2; axis++)
+        {
+            auto last = (int64_t) std::floor(start[axis] + delta[axis]);
+            steps += (uint64_t) std::abs(last - tile[axis]);
+            if (delta[axis] == 0.0f)
+            {
+                next[axis] = std::numeric_limits<float>::infinity();
+                stepFraction[axis] = std::numeric_limits<float>::infinity();
+                continue;
+            }
+            step[axis] = delta[axis] > 0.0f ? 1 : -1;
+            float boundary = (float) (delta[axis] > 0.0f ? tile[axis] + 1 : tile[axis]);
+            next[axis] = (boundary - start[axis]) / delta[axis];
+            stepFraction[axis] = std::abs(1.0f / delta[axis]);
+        }
+
+        float fraction = 0.0f;
+        glm::vec2 normal{};
+        for (uint64_t i = 0;; i++)
+        {
+            if (tile[0] >= 0 && tile[1] >= 0 && IsSolid((uint32_t) tile[0], (uint32_t) tile[1]))
+            {
+                hit.point = origin + translation * fraction;
+                hit.normal = normal;
+                hit.fraction = fraction;
+                hit.x = (uint32_t) tile[0];
+                hit.y = (uint32_t) tile[1];
+                return true;
+            }
+
+            int axis = next[0] < next[1] ? 0 : 1;
+            if (i == steps || next[axis] > 1.0f) { return false; }
+
+            fraction = next[axis];
+            tile[axis] += step[axis];
+            next[axis] += stepFraction[axis];
+            normal = {};
+            normal[axis] = (float) -step[axis];
+        }
+    }
+
+    int64_t TileCollisionLayer::ToTileMin(float value) const
+    {
+        return (int64_t) std::floor(value * m_InverseTileSize + EDGE_TOLERANCE);
+    }
+
+    int64_t TileCollisionLayer::ToTileMax(float value) const
+    {
+        return (int64_t) std::ceil(value * m_InverseTileSize - EDGE_TOLERANCE) - 1;
+    }
+
+    TileCollisionLayer::TileRange TileCollisionLayer::GetTileRange(const AABB& box) const
+    {
+        return {std::max<int64_t>(ToTileMin(box.min.x), 0), std::max<int64_t>(ToTileMin(box.min.y), 0),
+                std::min<int64_t>(ToTileMax(box.max.x), (int64_t) m_Width - 1),
+                std::min<int64_t>(ToTileMax(box.max.y), (int64_t) m_Height - 1)};
+    }
+
+    bool TileCollisionLayer::AnySolid(uint32_t y, uint32_t minX, uint32_t maxX) const
+    {
+        const uint64_t* row = GetRow(y);
+        const uint32_t first = minX / 64;
+        const uint32_t last = maxX / 64;
+        for (uint32_t w = first; w <= last; w++)
+        {
+            uint64_t bits = row[w];
+            if (w == first) { bits &= ~uint64_t{} << (minX % 64); }
+            if (w == last) { bits &= ~uint64_t{} >> (63 - maxX % 64); }
+            if (bits != 0) { return true; }
+        }
+        return false;
+    }
+
+    int64_t TileCollisionLayer::FindFirstSolid(uint32_t y, uint32_t minX, uint32_t maxX) const
+    {
+        const uint64_t* row = GetRow(y);
+        const uint32_t first = minX / 64;
+        const uint32_t last = maxX / 64;
+        for (uint32_t w = first; w <= last; w++)
+        {
+            uint64_t bits = row[w];
+            if (w == first) { bits &= ~uint64_t{} << (minX % 64); }
+            if (w == last) { bits &= ~uint64_t{} >> (63 - maxX % 64); }
+            if (bits != 0) { return (int64_t) w * 64 + std::countr_zero(bits); }
+        }
+        return -1;
+    }
+
+    int64_t TileCollisionLayer::FindLastSolid(uint32_t y, uint32_t minX, uint32_t maxX) const
+    {
+        const uint64_t* row = GetRow(y);
+        const uint32_t first = minX / 64;
+        const uint32_t last = maxX / 64;
+        for (uint32_t w = last + 1; w-- > first;)
+        {
+            uint64_t bits = row[w];
+            if (w == first) { bits &= ~uint64_t{} << (minX % 64); }
+            if (w == last) { bits &= ~uint64_t{} >> (63 - maxX % 64); }
+            if (bits != 0) { return (int64_t) w * 64 + 63 - std::countl_zero(bits); }
+        }
+        return -1;
+    }
+
+    float TileCollisionLayer::SweepX(const TileRange& rows, float minX, float maxX, float displacement) const
+    {
+        if (displacement == 0.0f || rows.minY > rows.maxY) { return displacement; }
+
+        // Only the columns the leading edge enters are scanned, every row narrows the range for the next one
+        if (displacement > 0.0f)
+        {
+            int64_t from = std::max<int64_t>(ToTileMax(maxX) + 1, 0);
+            int64_t to = std::min<int64_t>(ToTileMax(maxX + displacement), (int64_t) m_Width - 1);
+            int64_t blocked = -1;
+            for (int64_t y = rows.minY; y <= rows.maxY && from <= to; y++)
+            {
+                int64_t column = FindFirstSolid((uint32_t) y, (uint32_t) from, (uint32_t) to);
+                if (column < 0) { continue; }
+                blocked = column;
+                to = column - 1;
+            }
+            return blocked < 0 ? displacement : std::max((float) blocked * m_TileSize - maxX, 0.0f);
+        }
+
+        int64_t from = std::max<int64_t>(ToTileMin(minX + displacement), 0);
+        int64_t to = std::min<int64_t>(ToTileMin(minX) - 1, (int64_t) m_Width - 1);
+        int64_t blocked = -1;
+        for (int64_t y = rows.minY; y <= rows.maxY && from <= to; y++)
+        {
+            int64_t column = FindLastSolid((uint32_t) y, (uint32_t) from, (uint32_t) to);
+            if (column < 0) { continue; }
+            blocked = column;
+            from = column + 1;
+        }
+        return blocked < 0 ? displacement : std::min((float) (blocked + 1) * m_TileSize - minX, 0.0f);
+    }
+
+    float TileCollisionLayer::SweepY(const TileRange& columns, float minY, float maxY, float displacement) const
+    {
+        if (displacement == 0.0f || columns.minX > columns.maxX) { return displacement; }
+
+        // Rows are visited in the direction of motion, the first one with a solid tile under the box stops it
+        auto minX = (uint32_t) columns.minX;
+        auto maxX = (uint32_t) columns.maxX;
+        if (displacement > 0.0f)
+        {
+            int64_t from = std::max<int64_t>(ToTileMax(maxY) + 1, 0);
+            int64_t to = std::min<int64_t>(ToTileMax(maxY + displacement), (int64_t) m_Height - 1);
+            for (int64_t y = from; y <= to; y++)
+            {
+                if (AnySolid((uint32_t) y, minX, maxX)) { return std::max((float) y * m_TileSize - maxY, 0.0f); }
+            }
+            return displacement;
+        }
+
+        int64_t from = std::min<int64_t>(ToTileMin(minY) - 1, (int64_t) m_Height - 1);
+        int64_t to = std::max<int64_t>(ToTileMin(minY + displacement), 0);
+        for (int64_t y = from; y >= to; y--)
+        {
+            if (AnySolid((uint32_t) y, minX, maxX)) { return std::min((float) (y + 1) * m_TileSize - minY, 0.0f); }
+        }
+        return displacement;
+    }
+}// namespace LunaraEngine
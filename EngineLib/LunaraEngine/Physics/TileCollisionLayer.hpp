@@ -0,0 +1,106 @@
+#pragma once
+#include <LunaraEngine/Physics/AABB.hpp>
+#include <cstdint>
+#include <vector>
+#include <glm/glm.hpp>
+
+namespace LunaraEngine
+{
+    struct TileSweepResult {
+        // Part of the requested displacement that could be applied
+        glm::vec2 displacement{};
+        // Whether a solid tile stopped the motion along the axis
+        bool hitX{};
+        bool hitY{};
+    };
+
+    struct TileRayHit {
+        glm::vec2 point{};
+        // Face of the tile that was hit, zero when the ray started inside a solid tile
+        glm::vec2 normal{};
+        float fraction{};
+        uint32_t x{};
+        uint32_t y{};
+    };
+
+    // Solid or empty per tile, one bit per tile in 64 bit words with every row starting on a new word. Tiles
+    // outside the grid are empty
+    class TileCollisionLayer
+    {
+    public:
+        TileCollisionLayer() = default;
+
+        TileCollisionLayer(uint32_t width, uint32_t height, float tileSize, glm::vec2 origin = {})
+        {
+            Create(width, height, tileSize, origin);
+        }
+
+    public:
+        void Create(uint32_t width, uint32_t height, float tileSize, glm::vec2 origin = {});
+        void SetSolid(uint32_t x, uint32_t y, bool solid);
+        // Sets the tiles [x, x + width) x [y, y + height) a word at a time
+        void SetSolid(uint32_t x, uint32_t y, uint32_t width, uint32_t height, bool solid);
+        void Clear();
+
+        [[nodiscard]] bool IsSolid(uint32_t x, uint32_t y) const
+        {
+            return x < m_Width && y < m_Height && (GetRow(y)[x / 64] >> (x % 64)) & 1;
+        }
+
+        [[nodiscard]] bool Overlaps(const AABB& box) const;
+
+        // Moves the box along x and then along y and stops it at the first solid tile on the way, so it cannot
+        // tunnel through thin walls however far it moves. A box that already overlaps a tile can move out of it
+        [[nodiscard]] TileSweepResult Sweep(const AABB& box, glm::vec2 displacement) const;
+
+        // First solid tile the segment origin + t * translation, t in [0, 1], enters
+        bool RayCast(glm::vec2 origin, glm::vec2 translation, TileRayHit& hit) const;
+
+        [[nodiscard]] uint32_t GetWidth() const { return m_Width; }
+
+        [[nodiscard]] uint32_t GetHeight() const { return m_Height; }
+
+        [[nodiscard]] float GetTileSize() const { return m_TileSize; }
+
+        [[nodiscard]] glm::vec2 GetOrigin() const { return m_Origin; }
+
+    private:
+        // Inclusive tile range, empty when min > max
+        struct TileRange {
+            int64_t minX{};
+            int64_t minY{};
+            int64_t maxX{};
+            int64_t maxY{};
+        };
+
+        [[nodiscard]] const uint64_t* GetRow(uint32_t y) const { return m_Bits.data() + (size_t) y * m_WordsPerRow; }
+
+        [[nodiscard]] uint64_t* GetRow(uint32_t y) { return m_Bits.data() + (size_t) y * m_WordsPerRow; }
+
+        // A box stopped on a tile edge picks up rounding errors once its position is written back, overlaps below
+        // this fraction of a tile are ignored so it does not end up inside the tile it rests against
+        static constexpr float EDGE_TOLERANCE = 1.0f / 1024.0f;
+
+        // Coordinates relative to the origin. Boxes cover the tiles their half open extent touches, a box ending
+        // on a tile edge does not cover the next tile
+        [[nodiscard]] int64_t ToTileMin(float value) const;
+        [[nodiscard]] int64_t ToTileMax(float value) const;
+        [[nodiscard]] TileRange GetTileRange(const AABB& box) const;
+
+        [[nodiscard]] bool AnySolid(uint32_t y, uint32_t minX, uint32_t maxX) const;
+        [[nodiscard]] int64_t FindFirstSolid(uint32_t y, uint32_t minX, uint32_t maxX) const;
+        [[nodiscard]] int64_t FindLastSolid(uint32_t y, uint32_t minX, uint32_t maxX) const;
+
+        [[nodiscard]] float SweepX(const TileRange& rows, float minX, float maxX, float displacement) const;
+        [[nodiscard]] float SweepY(const TileRange& columns, float minY, float maxY, float displacement) const;
+
+    private:
+        uint32_t m_Width{};
+        uint32_t m_Height{};
+        uint32_t m_WordsPerRow{};
+        float m_TileSize{1.0f};
+        float m_InverseTileSize{1.0f};
+        glm::vec2 m_Origin{};
+        std::vector<uint64_t> m_Bits;
+    };
+}// namespace LunaraEngine
@@ -3,34 +3,104 @@
 #include <LunaraEngine/Renderer/Shader.hpp>
 #include <LunaraEngine/Renderer/Buffer/StorageBuffer.hpp>
 #include <LunaraEngine/Renderer/RendererCommands.hpp>
+#include <LunaraEngine/Renderer/Renderer.hpp>
+#include <LunaraEngine/Renderer/Camera.hpp>
+#include <LunaraEngine/Renderer/RadixSort.hpp>
 #include <glm/glm.hpp>
 #include <span>
+#include <bit>
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#define LUNARA_BATCH_CULL_SSE
+#endif
 
 namespace LunaraEngine
 {
-    BatchRenderer::BatchRenderer()
+    BatchRenderer::BatchRenderer() = default;
+
+    BatchRenderer::BatchRenderer(const ApplicationConfig& config, std::vector<std::wstring_view> textureNames,
+                                 QuadInstanceFormat format)
+        : BatchRenderer()
     {
-        m_Capacity = MAX_QUADS;
-        m_Offset = 0;
-        m_QuadCount = 0;
-        m_Positions.resize(m_Capacity);
-        m_Sizes.resize(m_Capacity);
-        m_TextureIndices.resize(m_Capacity);
-        std::fill(m_Positions.begin(), m_Positions.end(), glm::vec4(0.0f));
-        std::fill(m_Sizes.begin(), m_Sizes.end(), glm::vec2(0.0f));
-        std::fill(m_TextureIndices.begin(), m_TextureIndices.end(), 0);
+        Create(config, textureNames, format);
     }
 
-    BatchRenderer::BatchRenderer(const ApplicationConfig& config, std::vector<std::wstring_view> textureNames)
-        : BatchRenderer()
+    void BatchRenderer::Create(const ApplicationConfig& config, std::vector<std::wstring_view> textureNames,
+                               QuadInstanceFormat format)
     {
-        Create(config, textureNames);
+        m_Format = format;
+        m_Pages.clear();
+        if (m_Format == QuadInstanceFormat::Packed)
+        {
+            m_Shader = CreatePackedQuadShader(config, textureNames, PAGE_QUADS, BufferResourceUsage::Transient);
+        }
+        else { m_Shader = CreateQuadShader(config, textureNames, PAGE_QUADS, BufferResourceUsage::Transient); }
+        Reserve(PAGE_QUADS);
+
+        // Map local texture indices to slots in the bindless table
+        m_TextureSlots = m_Shader->GetBindlessTextureSlots();
+        m_FallbackTextureSlot = m_Shader->GetFallbackTextureSlot();
+        m_TextureSlotRuns.assign(m_TextureSlots.size(), 1);
+        for (size_t i = m_TextureSlots.size(); i-- > 1;)
+        {
+            if (m_TextureSlots[i] == m_TextureSlots[i - 1] + 1) { m_TextureSlotRuns[i - 1] = m_TextureSlotRuns[i] + 1; }
+        }
+
+        CreateRetainedShaders(config);
+        if (m_Format == QuadInstanceFormat::Separate && Renderer::HasDepthAttachment()) { CreateOpaqueShader(config); }
+
+        m_DirtySprites.resize(Renderer::GetFramesInFlight());
+        m_FrameDirty.resize(Renderer::GetFramesInFlight());
     }
 
-    void BatchRenderer::Create(const ApplicationConfig& config, std::vector<std::wstring_view> textureNames)
+    std::shared_ptr<Shader> BatchRenderer::CreateQuadShader(const ApplicationConfig& config,
+                                                            const std::vector<std::wstring_view>& textureNames,
+                                                            size_t length, BufferResourceUsage usage)
     {
-        m_Shader = Shader::Create(
+        return Shader::Create(
                 ShaderInfoBuilder("FlatQuadBatched", config.shadersDirectory)
+                        .SetDepthTest(DepthTest::Read)
+                        .AddResources(
+                                {BufferResourceBuilder("UniformBuffer", BufferResourceType::UniformBuffer)
+                                         .AddAttributes({{"model", BufferResourceAttributeType::Mat4},
+                                                         {"view", BufferResourceAttributeType::Mat4},
+                                                         {"projection", BufferResourceAttributeType::Mat4},
+                                                         {"zoom", BufferResourceAttributeType::Float},
+                                                         {"time", BufferResourceAttributeType::Float}})
+                                         .Build(),
+                                 BufferResourceBuilder("Positions", BufferResourceType::StorageBuffer, length)
+                                         .AddAttributes({{"Position", BufferResourceAttributeType::Vec4}})
+                                         .SetUsage(usage)
+                                         .Build(),
+                                 BufferResourceBuilder("Sizes", BufferResourceType::StorageBuffer, length)
+                                         .AddAttributes({{"Size", BufferResourceAttributeType::Vec2}})
+                                         .SetUsage(usage)
+                                         .Build(),
+                                 BufferResourceBuilder("TextureIndices", BufferResourceType::StorageBuffer, length)
+                                         .AddAttributes({{"TextureIndex", BufferResourceAttributeType::UInt}})
+                                         .SetUsage(usage)
+                                         .Build(),
+                                 BufferResourceBuilder("Animations", BufferResourceType::StorageBuffer, length)
+                                         .AddAttributes({{"startFrame", BufferResourceAttributeType::UInt},
+                                                         {"frameCount", BufferResourceAttributeType::UInt},
+                                                         {"fps", BufferResourceAttributeType::Float},
+                                                         {"startTime", BufferResourceAttributeType::Float}})
+                                         .SetUsage(usage)
+                                         .Build()})
+                        .AddResource(TextureResourceBuilder<TextureResourceType::Texture2DBindlessArray>(
+                                             "Textures", config.texturesDirectory, textureNames)
+                                             .Build())
+                        .Build());
+    }
+
+    std::shared_ptr<Shader> BatchRenderer::CreatePackedQuadShader(const ApplicationConfig& config,
+                                                                  const std::vector<std::wstring_view>& textureNames,
+                                                                  size_t length, BufferResourceUsage usage)
+    {
+        return Shader::Create(
+                ShaderInfoBuilder("FlatQuadPacked", config.shadersDirectory)
                         .AddResources(
                                 {BufferResourceBuilder("UniformBuffer", BufferResourceType::UniformBuffer)
                                          .AddAttributes({{"model", BufferResourceAttributeType::Mat4},
@@ -38,50 +108,686 @@ namespace LunaraEngine
                                                          {"projection", BufferResourceAttributeType::Mat4},
                                                          {"zoom", BufferResourceAttributeType::Float}})
                                          .Build(),
-                                 BufferResourceBuilder("Positions", BufferResourceType::StorageBuffer, MAX_QUADS)
+                                 BufferResourceBuilder("Instances", BufferResourceType::StorageBuffer, length)
+                                         .AddAttributes({{"Position", BufferResourceAttributeType::Vec2},
+                                                         {"Size", BufferResourceAttributeType::UInt},
+                                                         {"TextureTint", BufferResourceAttributeType::UInt}})
+                                         .SetUsage(usage)
+                                         .Build()})
+                        .AddResource(TextureResourceBuilder<TextureResourceType::Texture2DBindlessArray>(
+                                             "Textures", config.texturesDirectory, textureNames)
+                                             .Build())
+                        .Build());
+    }
+
+    void BatchRenderer::CreateRetainedShaders(const ApplicationConfig& config)
+    {
+        // Retained sprites rarely change so they live in device local buffers updated through staging copies,
+        // the textures are already registered in the shared bindless table
+        m_RetainedShader = Shader::Create(
+                ShaderInfoBuilder("FlatQuadCulled", config.shadersDirectory)
+                        .AddResources(
+                                {BufferResourceBuilder("UniformBuffer", BufferResourceType::UniformBuffer)
+                                         .AddAttributes({{"model", BufferResourceAttributeType::Mat4},
+                                                         {"view", BufferResourceAttributeType::Mat4},
+                                                         {"projection", BufferResourceAttributeType::Mat4},
+                                                         {"zoom", BufferResourceAttributeType::Float},
+                                                         {"time", BufferResourceAttributeType::Float}})
+                                         .Build(),
+                                 BufferResourceBuilder("Positions", BufferResourceType::StorageBuffer, MAX_SPRITES)
                                          .AddAttributes({{"Position", BufferResourceAttributeType::Vec4}})
+                                         .SetUsage(BufferResourceUsage::Static)
                                          .Build(),
-                                 BufferResourceBuilder("Sizes", BufferResourceType::StorageBuffer, MAX_QUADS)
+                                 BufferResourceBuilder("Sizes", BufferResourceType::StorageBuffer, MAX_SPRITES)
                                          .AddAttributes({{"Size", BufferResourceAttributeType::Vec2}})
+                                         .SetUsage(BufferResourceUsage::Static)
                                          .Build(),
-                                 BufferResourceBuilder("TextureIndices", BufferResourceType::StorageBuffer, MAX_QUADS)
+                                 BufferResourceBuilder("TextureIndices", BufferResourceType::StorageBuffer, MAX_SPRITES)
                                          .AddAttributes({{"TextureIndex", BufferResourceAttributeType::UInt}})
+                                         .SetUsage(BufferResourceUsage::Static)
+                                         .Build(),
+                                 BufferResourceBuilder("Animations", BufferResourceType::StorageBuffer, MAX_SPRITES)
+                                         .AddAttributes({{"startFrame", BufferResourceAttributeType::UInt},
+                                                         {"frameCount", BufferResourceAttributeType::UInt},
+                                                         {"fps", BufferResourceAttributeType::Float},
+                                                         {"startTime", BufferResourceAttributeType::Float}})
+                                         .SetUsage(BufferResourceUsage::Static)
+                                         .Build(),
+                                 BufferResourceBuilder("VisibleIndices", BufferResourceType::StorageBuffer, MAX_SPRITES)
+                                         .AddAttributes({{"Index", BufferResourceAttributeType::UInt}})
+                                         .SetUsage(BufferResourceUsage::Static)
+                                         .Build(),
+                                 BufferResourceBuilder("DrawCommand", BufferResourceType::StorageBuffer)
+                                         .AddAttributes({{"vertexCount", BufferResourceAttributeType::UInt},
+                                                         {"instanceCount", BufferResourceAttributeType::UInt},
+                                                         {"firstVertex", BufferResourceAttributeType::UInt},
+                                                         {"firstInstance", BufferResourceAttributeType::UInt}})
+                                         .SetUsage(BufferResourceUsage::Static)
                                          .Build()})
-                        .AddResource(TextureResourceBuilder<TextureResourceType::Texture2DArray>(
-                                             "Texture2DArray", config.texturesDirectory, textureNames)
+                        .AddResource(TextureResourceBuilder<TextureResourceType::Texture2DBindlessArray>(
+                                             "Textures", config.texturesDirectory, {})
                                              .Build())
                         .Build());
+
+        // The cull pass reads the sprite buffers and writes the visible list and draw arguments in place
+        m_CullShader = Shader::Create(
+                ShaderInfoBuilder("SpriteCull", config.shadersDirectory)
+                        .UseAsComputeShader()
+                        .AddResources(
+                                {BufferResourceBuilder("CullParams", BufferResourceType::UniformBuffer)
+                                         .AddAttributes({{"rect", BufferResourceAttributeType::Vec4},
+                                                         {"count", BufferResourceAttributeType::UInt}})
+                                         .Build(),
+                                 BufferResourceBuilder("Positions", BufferResourceType::StorageBuffer, MAX_SPRITES)
+                                         .AddAttributes({{"Position", BufferResourceAttributeType::Vec4}})
+                                         .SetUsage(BufferResourceUsage::Shared)
+                                         .Build(),
+                                 BufferResourceBuilder("Sizes", BufferResourceType::StorageBuffer, MAX_SPRITES)
+                                         .AddAttributes({{"Size", BufferResourceAttributeType::Vec2}})
+                                         .SetUsage(BufferResourceUsage::Shared)
+                                         .Build(),
+                                 BufferResourceBuilder("VisibleIndices", BufferResourceType::StorageBuffer, MAX_SPRITES)
+                                         .AddAttributes({{"Index", BufferResourceAttributeType::UInt}})
+                                         .SetUsage(BufferResourceUsage::Shared)
+                                         .Build(),
+                                 BufferResourceBuilder("DrawCommand", BufferResourceType::StorageBuffer)
+                                         .AddAttributes({{"vertexCount", BufferResourceAttributeType::UInt},
+                                                         {"instanceCount", BufferResourceAttributeType::UInt},
+                                                         {"firstVertex", BufferResourceAttributeType::UInt},
+                                                         {"firstInstance", BufferResourceAttributeType::UInt}})
+                                         .SetUsage(BufferResourceUsage::Shared)
+                                         .Build()})
+                        .Build());
+
+        m_CullShader->ShareBuffer(ShaderBinding::_1, m_RetainedShader.get(), ShaderBinding::_1);
+        m_CullShader->ShareBuffer(ShaderBinding::_2, m_RetainedShader.get(), ShaderBinding::_2);
+        m_CullShader->ShareBuffer(ShaderBinding::_3, m_RetainedShader.get(), ShaderBinding::_5);
+        m_CullShader->ShareBuffer(ShaderBinding::_4, m_RetainedShader.get(), ShaderBinding::_6);
+    }
+
+    void BatchRenderer::CreateOpaqueShader(const ApplicationConfig& config)
+    {
+        // Same layout and vertex stage as the translucent shader, the camera uniform is shared so it is only uploaded
+        // once
+        m_OpaqueShader = Shader::Create(
+                ShaderInfoBuilder("FlatQuadOpaque", config.shadersDirectory)
+                        .SetVertexName("FlatQuadBatched")
+                        .SetDepthTest(DepthTest::ReadWrite)
+                        .AddResources(
+                                {BufferResourceBuilder("UniformBuffer", BufferResourceType::UniformBuffer)
+                                         .AddAttributes({{"model", BufferResourceAttributeType::Mat4},
+                                                         {"view", BufferResourceAttributeType::Mat4},
+                                                         {"projection", BufferResourceAttributeType::Mat4},
+                                                         {"zoom", BufferResourceAttributeType::Float},
+                                                         {"time", BufferResourceAttributeType::Float}})
+                                         .SetUsage(BufferResourceUsage::Shared)
+                                         .Build(),
+                                 BufferResourceBuilder("Positions", BufferResourceType::StorageBuffer, PAGE_QUADS)
+                                         .AddAttributes({{"Position", BufferResourceAttributeType::Vec4}})
+                                         .SetUsage(BufferResourceUsage::Transient)
+                                         .Build(),
+                                 BufferResourceBuilder("Sizes", BufferResourceType::StorageBuffer, PAGE_QUADS)
+                                         .AddAttributes({{"Size", BufferResourceAttributeType::Vec2}})
+                                         .SetUsage(BufferResourceUsage::Transient)
+                                         .Build(),
+                                 BufferResourceBuilder("TextureIndices", BufferResourceType::StorageBuffer, PAGE_QUADS)
+                                         .AddAttributes({{"TextureIndex", BufferResourceAttributeType::UInt}})
+                                         .SetUsage(BufferResourceUsage::Transient)
+                                         .Build(),
+                                 BufferResourceBuilder("Animations", BufferResourceType::StorageBuffer, PAGE_QUADS)
+                                         .AddAttributes({{"startFrame", BufferResourceAttributeType::UInt},
+                                                         {"frameCount", BufferResourceAttributeType::UInt},
+                                                         {"fps", BufferResourceAttributeType::Float},
+                                                         {"startTime", BufferResourceAttributeType::Float}})
+                                         .SetUsage(BufferResourceUsage::Transient)
+                                         .Build()})
+                        .AddResource(TextureResourceBuilder<TextureResourceType::Texture2DBindlessArray>(
+                                             "Textures", config.texturesDirectory, {})
+                                             .Build())
+                        .Build());
+
+        m_OpaqueShader->ShareBuffer(ShaderBinding::_0, m_Shader.get(), ShaderBinding::_0);
     }
 
     void BatchRenderer::Destroy() {}
 
     void BatchRenderer::AddQuad(const glm::vec3&& position, const glm::vec2&& size, const uint32_t textureIndex)
     {
-        if (m_QuadCount == m_Capacity) { return; }
+        if (m_CullingEnabled && !IsVisible(position, size)) { return; }
+
+        StoreQuad(position, size, MapTextureIndex(textureIndex));
+    }
+
+    void BatchRenderer::AddAnimatedQuad(const glm::vec3& position, const glm::vec2& size,
+                                        const SpriteAnimation& animation)
+    {
+        if (m_CullingEnabled && !IsVisible(position, size)) { return; }
 
-        m_Positions[m_QuadCount] = glm::vec4{position, 0.0f};
-        m_Sizes[m_QuadCount] = size;
-        m_TextureIndices[m_QuadCount] = textureIndex;
+        // The packed record has no room for the animation, it shows the first frame
+        SpriteAnimation mapped = MapAnimation(animation);
+        StoreQuad(position, size, mapped.startFrame, mapped);
+    }
+
+    void BatchRenderer::AddInstance(const PackedQuadInstance& instance)
+    {
+        glm::vec3 position{instance.position, 0.0f};
+        glm::vec2 size = instance.GetSize();
+        if (m_CullingEnabled && !IsVisible(position, size)) { return; }
+
+        uint32_t textureSlot = MapTextureIndex(instance.GetTextureIndex());
+        if (m_Format == QuadInstanceFormat::Separate)
+        {
+            StoreQuad(position, size, textureSlot);
+            return;
+        }
+
+        // Already packed, only the texture index has to be remapped to its bindless slot
+        QuadPage& page = AcquirePage();
+        page.packedInstances[page.count] = instance;
+        page.packedInstances[page.count].textureTint = (instance.textureTint & 0xFFFF0000u) | (textureSlot & 0xFFFFu);
+        ++page.count;
         ++m_QuadCount;
+        if (m_SortingEnabled) { m_SortKeys.push_back(MakeSortKey(m_SortingLayer, 0.0f)); }
     }
 
-    RendererCommandDrawBatch* BatchRenderer::CreateDrawCommand()
+    void BatchRenderer::StoreQuad(const glm::vec3& position, const glm::vec2& size, uint32_t textureSlot,
+                                  const SpriteAnimation& animation)
     {
-        BufferUploadListBuilder uploadListBuilder(m_Shader);
-        uploadListBuilder.Add(m_Positions, m_Sizes, m_TextureIndices);
+        QuadPage& page = AcquirePage();
+        if (m_Format == QuadInstanceFormat::Packed)
+        {
+            page.packedInstances[page.count] = PackedQuadInstance::Pack(position, size, textureSlot);
+        }
+        else
+        {
+            page.positions[page.count] = glm::vec4{position, 0.0f};
+            page.sizes[page.count] = size;
+            page.textureIndices[page.count] = textureSlot;
+            page.animations[page.count] = animation;
+        }
+        ++page.count;
+        ++m_QuadCount;
+        if (m_SortingEnabled) { m_SortKeys.push_back(MakeSortKey(m_SortingLayer, position.z)); }
+        if (m_DepthPassEnabled)
+        {
+            m_SortMaterials.push_back(textureSlot < m_SlotMaterials.size() ? m_SlotMaterials[textureSlot]
+                                                                           : SpriteMaterial::Translucent);
+        }
+    }
 
-        RendererCommandDrawBatch* command =
-                new RendererCommandDrawBatch(uploadListBuilder.Get(), m_QuadCount, m_Offset);
+    BatchRenderer::QuadPage& BatchRenderer::AcquirePage()
+    {
+        if (m_ActivePage < m_Pages.size() && m_Pages[m_ActivePage]->count == PAGE_QUADS) { ++m_ActivePage; }
+        if (m_ActivePage == m_Pages.size()) { Reserve((m_Pages.size() + 1) * PAGE_QUADS); }
+        return *m_Pages[m_ActivePage];
+    }
 
-        return command;
+    void BatchRenderer::Reserve(size_t quadCount)
+    {
+        AllocatePages(m_Pages, (quadCount + PAGE_QUADS - 1) / PAGE_QUADS);
+    }
+
+    void BatchRenderer::AllocatePages(std::vector<std::unique_ptr<QuadPage>>& pages, size_t pageCount) const
+    {
+        // New pages are appended, the ones already written stay where they are
+        while (pages.size() < pageCount)
+        {
+            auto page = std::make_unique<QuadPage>();
+            if (m_Format == QuadInstanceFormat::Packed) { page->packedInstances.resize(PAGE_QUADS); }
+            else
+            {
+                page->positions.resize(PAGE_QUADS, glm::vec4(0.0f));
+                page->sizes.resize(PAGE_QUADS, glm::vec2(0.0f));
+                page->textureIndices.resize(PAGE_QUADS, 0);
+                page->animations.resize(PAGE_QUADS);
+            }
+            pages.push_back(std::move(page));
+        }
+    }
+
+    void BatchRenderer::EnableSorting()
+    {
+        // Quads added before sorting was enabled keep their submission order on the lowest key
+        if (!m_SortingEnabled) { m_SortKeys.assign(m_QuadCount, 0); }
+        m_SortingEnabled = true;
+    }
+
+    void BatchRenderer::DisableSorting()
+    {
+        DisableDepthPass();
+        m_SortingEnabled = false;
+        m_SortKeys.clear();
+    }
+
+    void BatchRenderer::SetSortingLayer(uint8_t layer) { m_SortingLayer = layer; }
+
+    void BatchRenderer::SetSortingDepthRange(float minDepth, float maxDepth)
+    {
+        if (!(maxDepth > minDepth)) { throw std::runtime_error("Sorting depth range has to be increasing!"); }
+
+        m_SortDepthMin = minDepth;
+        m_SortDepthScale = 65535.0f / (maxDepth - minDepth);
+    }
+
+    void BatchRenderer::EnableDepthPass()
+    {
+        if (m_OpaqueShader == nullptr)
+        {
+            LOG_WARNING("Depth pass needs the separate quad instance format and a depth attachment");
+            return;
+        }
+
+        // Draw order comes from the sort keys, quads added before this point stay translucent
+        EnableSorting();
+        if (!m_DepthPassEnabled) { m_SortMaterials.assign(m_QuadCount, SpriteMaterial::Translucent); }
+        m_DepthPassEnabled = true;
+    }
+
+    void BatchRenderer::DisableDepthPass()
+    {
+        m_DepthPassEnabled = false;
+        m_SortMaterials.clear();
+    }
+
+    void BatchRenderer::SetTextureMaterial(uint32_t textureIndex, SpriteMaterial material)
+    {
+        if (textureIndex >= m_TextureSlots.size()) { throw std::runtime_error("Texture index is out of range!"); }
+        uint32_t slot = m_TextureSlots[textureIndex];
+        if (slot >= m_SlotMaterials.size()) { m_SlotMaterials.resize(slot + 1, SpriteMaterial::Translucent); }
+        m_SlotMaterials[slot] = material;
+    }
+
+    SpriteMaterial BatchRenderer::GetTextureMaterial(uint32_t textureIndex) const
+    {
+        if (textureIndex >= m_TextureSlots.size()) { return SpriteMaterial::Translucent; }
+        uint32_t slot = m_TextureSlots[textureIndex];
+        return slot < m_SlotMaterials.size() ? m_SlotMaterials[slot] : SpriteMaterial::Translucent;
+    }
+
+    float BatchRenderer::MakeDepth(uint32_t sortKey)
+    {
+        // Higher keys are nearer, the 24 bit keys land exactly on the float steps below the cleared 1.0
+        return 1.0f - (float) (sortKey + 1) * (1.0f / 16777216.0f);
+    }
+
+    uint32_t BatchRenderer::MakeSortKey(uint8_t layer, float depth) const
+    {
+        // A 2D scene needs far fewer depth steps than a float has, 16 bits keep the sort at two passes. NaN ends
+        // up at the back
+        float steps = (depth - m_SortDepthMin) * m_SortDepthScale;
+        auto quantized = (uint32_t) (steps > 0.0f ? std::min(steps + 0.5f, 65535.0f) : 0.0f);
+        return (uint32_t{layer} << 16) | quantized;
+    }
+
+    void BatchRenderer::SortPages()
+    {
+        RadixSort(m_SortKeys, m_SortOrder, m_SortScratch);
+
+        AllocatePages(m_SortedPages, m_Pages.size());
+        for (auto& page: m_SortedPages) { page->count = 0; }
+
+        auto isOpaque = [this](uint32_t index) {
+            return m_DepthPassEnabled && m_SortMaterials[index] != SpriteMaterial::Translucent;
+        };
+
+        // Translucent quads blend back to front
+        size_t sorted = 0;
+        for (uint32_t index: m_SortOrder)
+        {
+            if (isOpaque(index)) { continue; }
+            CopySortedQuad(index, *m_SortedPages[sorted++ / PAGE_QUADS]);
+        }
+
+        if (!m_DepthPassEnabled) { return; }
+
+        AllocatePages(m_OpaquePages, m_Pages.size());
+        for (auto& page: m_OpaquePages) { page->count = 0; }
+
+        // Opaque quads go front to back so the depth test rejects everything they cover before it is shaded,
+        // walking the stable order backwards puts the last submitted of equal keys first
+        size_t opaque = 0;
+        for (auto it = m_SortOrder.rbegin(); it != m_SortOrder.rend(); ++it)
+        {
+            if (!isOpaque(*it)) { continue; }
+            CopySortedQuad(*it, *m_OpaquePages[opaque++ / PAGE_QUADS]);
+        }
+    }
+
+    void BatchRenderer::CopySortedQuad(uint32_t index, QuadPage& dst) const
+    {
+        const QuadPage& src = *m_Pages[index / PAGE_QUADS];
+        const size_t srcIndex = index % PAGE_QUADS;
+        const size_t dstIndex = dst.count;
+
+        if (m_Format == QuadInstanceFormat::Packed) { dst.packedInstances[dstIndex] = src.packedInstances[srcIndex]; }
+        else
+        {
+            dst.positions[dstIndex] = src.positions[srcIndex];
+            dst.sizes[dstIndex] = src.sizes[srcIndex];
+            dst.textureIndices[dstIndex] = src.textureIndices[srcIndex];
+            dst.animations[dstIndex] = src.animations[srcIndex];
+            // The unused w component carries the depth written by the vertex shader
+            if (m_DepthPassEnabled) { dst.positions[dstIndex].w = MakeDepth(m_SortKeys[index]); }
+        }
+        ++dst.count;
+    }
+
+    void BatchRenderer::AddQuads(std::span<const float> x, std::span<const float> y, std::span<const float> width,
+                                 std::span<const float> height, std::span<const uint32_t> textureIndices, float z)
+    {
+        size_t count = std::min({x.size(), y.size(), width.size(), height.size(), textureIndices.size()});
+
+        m_VisibleIndices.resize(count);
+        size_t visibleCount = 0;
+        size_t i = 0;
+
+        if (!m_CullingEnabled)
+        {
+            for (; i < count; i++) { m_VisibleIndices[visibleCount++] = (uint32_t) i; }
+        }
+#ifdef LUNARA_BATCH_CULL_SSE
+        else
+        {
+            // Four quads per iteration, the overlap mask selects the survivors
+            const __m128 minX = _mm_set1_ps(m_CullMin.x);
+            const __m128 minY = _mm_set1_ps(m_CullMin.y);
+            const __m128 maxX = _mm_set1_ps(m_CullMax.x);
+            const __m128 maxY = _mm_set1_ps(m_CullMax.y);
+            for (; i + 4 <= count; i += 4)
+            {
+                __m128 left = _mm_loadu_ps(x.data() + i);
+                __m128 top = _mm_loadu_ps(y.data() + i);
+                __m128 right = _mm_add_ps(left, _mm_loadu_ps(width.data() + i));
+                __m128 bottom = _mm_add_ps(top, _mm_loadu_ps(height.data() + i));
+
+                __m128 overlapX = _mm_and_ps(_mm_cmplt_ps(left, maxX), _mm_cmpgt_ps(right, minX));
+                __m128 overlapY = _mm_and_ps(_mm_cmplt_ps(top, maxY), _mm_cmpgt_ps(bottom, minY));
+                int mask = _mm_movemask_ps(_mm_and_ps(overlapX, overlapY));
+
+                while (mask != 0)
+                {
+                    m_VisibleIndices[visibleCount++] = (uint32_t) (i + (size_t) std::countr_zero((unsigned) mask));
+                    mask &= mask - 1;
+                }
+            }
+        }
+#endif
+
+        // Scalar tail and fallback
+        for (; i < count; i++)
+        {
+            if (IsVisible(glm::vec3{x[i], y[i], z}, glm::vec2{width[i], height[i]}))
+            {
+                m_VisibleIndices[visibleCount++] = (uint32_t) i;
+            }
+        }
+
+        for (size_t v = 0; v < visibleCount; v++)
+        {
+            uint32_t index = m_VisibleIndices[v];
+            StoreQuad(glm::vec3{x[index], y[index], z}, glm::vec2{width[index], height[index]},
+                      MapTextureIndex(textureIndices[index]));
+        }
+    }
+
+    void BatchRenderer::EnableCulling(float margin)
+    {
+        m_CullingEnabled = true;
+        m_CullMargin = margin;
+    }
+
+    void BatchRenderer::DisableCulling() { m_CullingEnabled = false; }
+
+    void BatchRenderer::SetCullRect(const Camera& camera) { SetCullRect(camera.GetVisibleRect()); }
+
+    void BatchRenderer::SetCullRect(const FRect& rect)
+    {
+        m_CullMin = glm::vec2{rect.x, rect.y} - m_CullMargin;
+        m_CullMax = glm::vec2{rect.x + rect.w, rect.y + rect.h} + m_CullMargin;
+    }
+
+    bool BatchRenderer::IsVisible(const glm::vec3& position, const glm::vec2& size) const
+    {
+        return position.x < m_CullMax.x && position.x + size.x > m_CullMin.x && position.y < m_CullMax.y &&
+               position.y + size.y > m_CullMin.y;
+    }
+
+    uint32_t BatchRenderer::MapTextureIndex(uint32_t textureIndex) const
+    {
+        if (textureIndex < m_TextureSlots.size()) { return m_TextureSlots[textureIndex]; }
+
+        // Passing the index through would sample another shader's texture or an unwritten slot
+        if (!m_UnknownTextureLogged)
+        {
+            LOG_WARNING("Texture index %u is out of range, drawing the fallback texture instead", textureIndex);
+            m_UnknownTextureLogged = true;
+        }
+        return m_FallbackTextureSlot;
+    }
+
+    SpriteAnimation BatchRenderer::MapAnimation(const SpriteAnimation& animation) const
+    {
+        // The shader steps through slots, frames past a gap in the bindless table are left out
+        SpriteAnimation mapped = animation;
+        mapped.startFrame = MapTextureIndex(animation.startFrame);
+        if (animation.startFrame < m_TextureSlotRuns.size())
+        {
+            mapped.frameCount = std::min(animation.frameCount, m_TextureSlotRuns[animation.startFrame]);
+        }
+        else { mapped.frameCount = std::min(animation.frameCount, 1u); }
+        return mapped;
+    }
+
+    std::vector<RendererCommand*> BatchRenderer::CreateDrawCommands()
+    {
+        std::vector<RendererCommand*> commands;
+        if (m_SortingEnabled) { SortPages(); }
+
+        if (m_DepthPassEnabled && !m_OpaquePages.empty() && m_OpaquePages.front()->count > 0)
+        {
+            commands.push_back(new RendererCommandBindShader(m_OpaqueShader.get(), nullptr));
+            AppendDrawCommands(commands, m_OpaqueShader, m_OpaquePages);
+            // The translucent pass runs with the shader the caller bound
+            commands.push_back(new RendererCommandBindShader(m_Shader.get(), nullptr));
+        }
+
+        AppendDrawCommands(commands, m_Shader, m_SortingEnabled ? m_SortedPages : m_Pages);
+        return commands;
+    }
+
+    void BatchRenderer::AppendDrawCommands(std::vector<RendererCommand*>& commands,
+                                           const std::shared_ptr<Shader>& shader,
+                                           const std::vector<std::unique_ptr<QuadPage>>& pages) const
+    {
+        // One draw per filled page, each uploads into its own transient allocation
+        for (const auto& page: pages)
+        {
+            if (page->count == 0) { break; }
+
+            BufferUploadListBuilder uploadListBuilder(shader);
+            if (m_Format == QuadInstanceFormat::Packed)
+            {
+                uploadListBuilder.SetRange(0, page->count).Add(page->packedInstances);
+            }
+            else
+            {
+                uploadListBuilder.SetRange(0, page->count)
+                        .Add(page->positions, page->sizes, page->textureIndices, page->animations);
+            }
+
+            commands.push_back(new RendererCommandDrawBatch(uploadListBuilder.Get(), page->count, 0));
+        }
     }
 
     void BatchRenderer::Flush()
     {
-        m_Offset = 0;
+        m_HighWaterMark = std::max(m_HighWaterMark, m_QuadCount);
+        for (auto& page: m_Pages) { page->count = 0; }
+        m_ActivePage = 0;
         m_QuadCount = 0;
+        m_SortKeys.clear();
+        m_SortMaterials.clear();
     }
 
     std::weak_ptr<Shader> BatchRenderer::GetShader() { return m_Shader; }
 
+    void BatchRenderer::SetTime(float seconds)
+    {
+        // The opaque shader shares this uniform buffer
+        if (m_Format == QuadInstanceFormat::Separate) { m_Shader->SetUniform("time", seconds); }
+        m_RetainedShader->SetUniform("time", seconds);
+    }
+
+    std::weak_ptr<Shader> BatchRenderer::GetOpaqueShader() { return m_OpaqueShader; }
+
+    SpriteHandle BatchRenderer::CreateSprite(const glm::vec3& position, const glm::vec2& size,
+                                             const uint32_t textureIndex)
+    {
+        SpriteHandle handle{};
+        if (!m_FreeSprites.empty())
+        {
+            handle.slot = m_FreeSprites.back();
+            m_FreeSprites.pop_back();
+        }
+        else
+        {
+            if (m_SpriteCount == MAX_SPRITES)
+            {
+                LOG_ERROR("Retained sprite limit reached");
+                return handle;
+            }
+            handle.slot = (uint32_t) m_SpriteCount++;
+            m_SpritePositions.resize(m_SpriteCount);
+            m_SpriteSizes.resize(m_SpriteCount);
+            m_SpriteTextureIndices.resize(m_SpriteCount);
+            m_SpriteAnimations.resize(m_SpriteCount);
+        }
+
+        UpdateSprite(handle, position, size, textureIndex);
+        return handle;
+    }
+
+    void BatchRenderer::UpdateSprite(SpriteHandle handle, const glm::vec3& position, const glm::vec2& size,
+                                     const uint32_t textureIndex)
+    {
+        if (!handle.IsValid() || handle.slot >= m_SpriteCount) { return; }
+
+        m_SpritePositions[handle.slot] = glm::vec4{position, 0.0f};
+        m_SpriteSizes[handle.slot] = size;
+        m_SpriteTextureIndices[handle.slot] = MapTextureIndex(textureIndex);
+        m_SpriteAnimations[handle.slot] = SpriteAnimation{};
+        MarkSpriteDirty(handle.slot);
+    }
+
+    void BatchRenderer::UpdateSprite(SpriteHandle handle, const glm::vec3& position)
+    {
+        if (!handle.IsValid() || handle.slot >= m_SpriteCount) { return; }
+
+        m_SpritePositions[handle.slot] = glm::vec4{position, 0.0f};
+        MarkSpriteDirty(handle.slot);
+    }
+
+    void BatchRenderer::SetSpriteAnimation(SpriteHandle handle, const SpriteAnimation& animation)
+    {
+        if (!handle.IsValid() || handle.slot >= m_SpriteCount) { return; }
+
+        // Uploaded once, from here on the sprite animates without any CPU work
+        SpriteAnimation mapped = MapAnimation(animation);
+        m_SpriteTextureIndices[handle.slot] = mapped.startFrame;
+        m_SpriteAnimations[handle.slot] = mapped;
+        MarkSpriteDirty(handle.slot);
+    }
+
+    void BatchRenderer::DestroySprite(SpriteHandle& handle)
+    {
+        if (!handle.IsValid() || handle.slot >= m_SpriteCount) { return; }
+
+        // A zero sized quad is degenerate, the slot keeps drawing nothing until it is reused
+        m_SpriteSizes[handle.slot] = glm::vec2(0.0f);
+        MarkSpriteDirty(handle.slot);
+        m_FreeSprites.push_back(handle.slot);
+        handle.slot = SpriteHandle::INVALID_SLOT;
+    }
+
+    void BatchRenderer::MarkSpriteDirty(uint32_t slot)
+    {
+        size_t word = slot / DIRTY_WORD_BITS;
+        uint64_t bit = uint64_t{1} << (slot % DIRTY_WORD_BITS);
+
+        // Every frame in flight has to receive the change once
+        for (size_t frame = 0; frame < m_DirtySprites.size(); frame++)
+        {
+            auto& dirty = m_DirtySprites[frame];
+            if (word >= dirty.size()) { dirty.resize(word + 1); }
+            dirty[word] |= bit;
+            m_FrameDirty[frame] = true;
+        }
+    }
+
+    void BatchRenderer::CullRetainedSprites(const Camera& camera)
+    {
+        if (m_SpriteCount == 0) { return; }
+
+        FRect rect = camera.GetVisibleRect();
+        m_CullShader->SetUniform("rect", glm::vec4{rect.x, rect.y, rect.x + rect.w, rect.y + rect.h});
+        m_CullShader->SetUniform("count", (uint32_t) m_SpriteCount);
+
+        // The instance count is accumulated atomically by the cull pass, it has to start from zero
+        Renderer::FillBuffer(m_CullShader.get(), ShaderBinding::_4, sizeof(uint32_t), sizeof(uint32_t), 0);
+        Renderer::BindShader(m_CullShader.get());
+        Renderer::Dispatch(m_CullShader.get(),
+                           (uint32_t) ((m_SpriteCount + CULL_GROUP_SIZE - 1) / CULL_GROUP_SIZE));
+        m_RetainedCulled = true;
+    }
+
+    RendererCommandDrawBatch* BatchRenderer::CreateRetainedDrawCommand()
+    {
+        m_DirtyRanges.clear();
+
+        uint32_t frame = Renderer::GetCurrentFrame();
+        if (frame < m_DirtySprites.size() && m_FrameDirty[frame])
+        {
+            auto& dirty = m_DirtySprites[frame];
+            for (size_t word = 0; word < dirty.size(); word++)
+            {
+                uint64_t bits = dirty[word];
+                if (bits == 0) { continue; }
+                dirty[word] = 0;
+
+                // Walk runs of set bits and merge them with the previous range when the gap is small
+                while (bits != 0)
+                {
+                    size_t begin = (size_t) std::countr_zero(bits);
+                    size_t length = (size_t) std::countr_one(bits >> begin);
+                    size_t offset = word * DIRTY_WORD_BITS + begin;
+
+                    if (!m_DirtyRanges.empty() &&
+                        offset <= m_DirtyRanges.back().offset + m_DirtyRanges.back().count + RANGE_MERGE_GAP)
+                    {
+                        m_DirtyRanges.back().count = offset + length - m_DirtyRanges.back().offset;
+                    }
+                    else { m_DirtyRanges.push_back(UploadRange{offset, length}); }
+
+                    bits = begin + length == DIRTY_WORD_BITS ? 0 : bits & (~uint64_t{0} << (begin + length));
+                }
+            }
+            m_FrameDirty[frame] = false;
+        }
+
+        BufferUploadListBuilder uploadListBuilder(m_RetainedShader);
+        uploadListBuilder.AddRanges(
+                m_DirtyRanges, m_SpritePositions, m_SpriteSizes, m_SpriteTextureIndices, m_SpriteAnimations);
+
+        // Without a cull pass this frame the draw arguments are stale, nothing is drawn
+        auto* command = new RendererCommandDrawBatch(uploadListBuilder.Get(), m_RetainedCulled ? m_SpriteCount : 0, 0);
+        command->indirect = m_RetainedCulled;
+        command->indirectBinding = ShaderBinding::_6;
+        m_RetainedCulled = false;
+        return command;
+    }
+
+    std::weak_ptr<Shader> BatchRenderer::GetRetainedShader() { return m_RetainedShader; }
+
+    std::weak_ptr<Shader> BatchRenderer::GetCullShader() { return m_CullShader; }
+
 }// namespace LunaraEngine
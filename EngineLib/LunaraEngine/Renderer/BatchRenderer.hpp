@@ -3,9 +3,14 @@
 #include <vector>
 #include <memory>
 #include <filesystem>
+#include <limits>
+#include <span>
 
 #include <glm/glm.hpp>
 #include <LunaraEngine/Core/CommonTypes.hpp>
+#include <LunaraEngine/Renderer/CommonTypes.hpp>
+#include <LunaraEngine/Renderer/QuadInstance.hpp>
+#include <LunaraEngine/Math/Rect.h>
 
 namespace LunaraEngine
 {
@@ -15,38 +20,211 @@ namespace LunaraEngine
     class IndexBuffer;
     template <typename T>
     class StorageBuffer;
+    class RendererCommand;
     class RendererCommandDrawBatch;
     class Shader;
+    class Camera;
+
+    struct SpriteHandle {
+        static constexpr uint32_t INVALID_SLOT = std::numeric_limits<uint32_t>::max();
+        uint32_t slot{INVALID_SLOT};
+
+        [[nodiscard]] bool IsValid() const { return slot != INVALID_SLOT; }
+    };
+
+    enum class SpriteMaterial : uint8_t
+    {
+        // Blended back to front after everything opaque
+        Translucent = 0,
+        // Every texel covers what is behind it
+        Opaque,
+        // Texels are either fully opaque or discarded
+        AlphaTested
+    };
 
     class BatchRenderer
     {
     public:
         BatchRenderer();
-        BatchRenderer(const ApplicationConfig& config, std::vector<std::wstring_view> textureNames);
+        BatchRenderer(const ApplicationConfig& config, std::vector<std::wstring_view> textureNames,
+                      QuadInstanceFormat format = QuadInstanceFormat::Separate);
         ~BatchRenderer() = default;
 
     public:
-        void Create(const ApplicationConfig& config, std::vector<std::wstring_view> textureNames);
+        void Create(const ApplicationConfig& config, std::vector<std::wstring_view> textureNames,
+                    QuadInstanceFormat format = QuadInstanceFormat::Separate);
         void Destroy();
 
     public:
         void AddQuad(const glm::vec3&& position, const glm::vec2&& size, const uint32_t textureIndex = 0);
-        RendererCommandDrawBatch* CreateDrawCommand();
+        void AddQuads(std::span<const float> x, std::span<const float> y, std::span<const float> width,
+                      std::span<const float> height, std::span<const uint32_t> textureIndices, float z = 0.0f);
+        void AddAnimatedQuad(const glm::vec3& position, const glm::vec2& size, const SpriteAnimation& animation);
+        void AddInstance(const PackedQuadInstance& instance);
+        std::vector<RendererCommand*> CreateDrawCommands();
         void Flush();
+        void Reserve(size_t quadCount);
         std::weak_ptr<Shader> GetShader();
+        // Seconds on the clock animations are evaluated against, uploaded once per frame
+        void SetTime(float seconds);
+
+        [[nodiscard]] QuadInstanceFormat GetFormat() const { return m_Format; }
+
+        [[nodiscard]] size_t GetQuadCount() const { return m_QuadCount; }
+
+        [[nodiscard]] size_t GetCapacity() const { return m_Pages.size() * PAGE_QUADS; }
+
+        [[nodiscard]] size_t GetPageCount() const { return m_Pages.size(); }
+
+        // Largest number of quads submitted in a single frame, a good value for Reserve
+        [[nodiscard]] size_t GetHighWaterMark() const { return m_HighWaterMark; }
+
+    public:
+        // Quads are drawn ordered by layer, then by depth (position z) and finally in submission order
+        void EnableSorting();
+        void DisableSorting();
+        void SetSortingLayer(uint8_t layer);
+        // Depth is quantized to 16 bits over this range, depths outside of it are clamped
+        void SetSortingDepthRange(float minDepth, float maxDepth);
+
+        [[nodiscard]] bool IsSortingEnabled() const { return m_SortingEnabled; }
+
+        [[nodiscard]] uint8_t GetSortingLayer() const { return m_SortingLayer; }
+
+        // The layer above 16 bits of depth, 24 bits in total so the sort takes at most two passes
+        [[nodiscard]] uint32_t MakeSortKey(uint8_t layer, float depth) const;
+
+    public:
+        // Opaque and alpha tested quads are drawn front to back with depth writes before the translucent pass,
+        // needs the separate instance format and a depth attachment
+        void EnableDepthPass();
+        void DisableDepthPass();
+        void SetTextureMaterial(uint32_t textureIndex, SpriteMaterial material);
+        [[nodiscard]] SpriteMaterial GetTextureMaterial(uint32_t textureIndex) const;
+        std::weak_ptr<Shader> GetOpaqueShader();
+
+        [[nodiscard]] bool IsDepthPassEnabled() const { return m_DepthPassEnabled; }
+
+        static float MakeDepth(uint32_t sortKey);
+
+    public:
+        SpriteHandle CreateSprite(const glm::vec3& position, const glm::vec2& size, const uint32_t textureIndex = 0);
+        void UpdateSprite(SpriteHandle handle, const glm::vec3& position, const glm::vec2& size,
+                          const uint32_t textureIndex);
+        void UpdateSprite(SpriteHandle handle, const glm::vec3& position);
+        void SetSpriteAnimation(SpriteHandle handle, const SpriteAnimation& animation);
+        void DestroySprite(SpriteHandle& handle);
+        void CullRetainedSprites(const Camera& camera);
+        RendererCommandDrawBatch* CreateRetainedDrawCommand();
+        std::weak_ptr<Shader> GetRetainedShader();
+        std::weak_ptr<Shader> GetCullShader();
+
+    public:
+        void EnableCulling(float margin = 0.0f);
+        void DisableCulling();
+        void SetCullRect(const Camera& camera);
+        void SetCullRect(const FRect& rect);
+
+        [[nodiscard]] bool IsCullingEnabled() const { return m_CullingEnabled; }
+
+    public:
+        static std::shared_ptr<Shader> CreateQuadShader(const ApplicationConfig& config,
+                                                        const std::vector<std::wstring_view>& textureNames,
+                                                        size_t length, BufferResourceUsage usage);
+        static std::shared_ptr<Shader> CreatePackedQuadShader(const ApplicationConfig& config,
+                                                              const std::vector<std::wstring_view>& textureNames,
+                                                              size_t length, BufferResourceUsage usage);
+
+    private:
+        // Fixed size block of instances, one draw each. Pages are never reallocated once written
+        struct QuadPage {
+            size_t count{};
+            std::vector<glm::vec4> positions;
+            std::vector<glm::vec2> sizes;
+            std::vector<uint32_t> textureIndices;
+            std::vector<SpriteAnimation> animations;
+            std::vector<PackedQuadInstance> packedInstances;
+        };
+
+    private:
+        void CreateRetainedShaders(const ApplicationConfig& config);
+        void CreateOpaqueShader(const ApplicationConfig& config);
+        QuadPage& AcquirePage();
+        void AllocatePages(std::vector<std::unique_ptr<QuadPage>>& pages, size_t pageCount) const;
+        void SortPages();
+        void CopySortedQuad(uint32_t index, QuadPage& dst) const;
+        void AppendDrawCommands(std::vector<RendererCommand*>& commands, const std::shared_ptr<Shader>& shader,
+                                const std::vector<std::unique_ptr<QuadPage>>& pages) const;
+        uint32_t MapTextureIndex(uint32_t textureIndex) const;
+        SpriteAnimation MapAnimation(const SpriteAnimation& animation) const;
+        void StoreQuad(const glm::vec3& position, const glm::vec2& size, uint32_t textureSlot,
+                       const SpriteAnimation& animation = {});
+        [[nodiscard]] bool IsVisible(const glm::vec3& position, const glm::vec2& size) const;
+        void MarkSpriteDirty(uint32_t slot);
 
     private:
-        static constexpr size_t MAX_QUADS = 10000;
+        static constexpr size_t PAGE_QUADS = 10000;
+        static constexpr size_t MAX_SPRITES = 131072;
+        static constexpr size_t DIRTY_WORD_BITS = 64;
+        // Clean gaps up to this many sprites are uploaded instead of starting a new range
+        static constexpr size_t RANGE_MERGE_GAP = 8;
+        static constexpr uint32_t CULL_GROUP_SIZE = 64;
 
     private:
-        size_t m_Offset{};
         size_t m_QuadCount{};
-        size_t m_Capacity{};
+        size_t m_HighWaterMark{};
+        size_t m_ActivePage{};
+
+        std::vector<std::unique_ptr<QuadPage>> m_Pages;
+
+        bool m_SortingEnabled{};
+        uint8_t m_SortingLayer{};
+        std::vector<uint32_t> m_SortKeys;
+        std::vector<uint32_t> m_SortOrder;
+        std::vector<uint32_t> m_SortScratch;
+        float m_SortDepthMin{-1024.0f};
+        float m_SortDepthScale{65535.0f / 2048.0f};
+        // Pages in draw order, only used while sorting is enabled
+        std::vector<std::unique_ptr<QuadPage>> m_SortedPages;
+
+        bool m_DepthPassEnabled{};
+        // Indexed by bindless slot, slots without an entry are translucent
+        std::vector<SpriteMaterial> m_SlotMaterials;
+        std::vector<SpriteMaterial> m_SortMaterials;
+        std::vector<std::unique_ptr<QuadPage>> m_OpaquePages;
+        std::shared_ptr<Shader> m_OpaqueShader;
+
+        std::vector<uint32_t> m_TextureSlots;
+        // Number of consecutive bindless slots starting at each local texture index
+        std::vector<uint32_t> m_TextureSlotRuns;
+        uint32_t m_FallbackTextureSlot{};
+        mutable bool m_UnknownTextureLogged{};
+        QuadInstanceFormat m_Format{QuadInstanceFormat::Separate};
 
-        std::vector<glm::vec4> m_Positions;
-        std::vector<glm::vec2> m_Sizes;
-        std::vector<uint32_t> m_TextureIndices;
+        bool m_CullingEnabled{};
+        float m_CullMargin{};
+        glm::vec2 m_CullMin{};
+        glm::vec2 m_CullMax{};
+        std::vector<uint32_t> m_VisibleIndices;
 
         std::shared_ptr<Shader> m_Shader;
+
+    private:
+        size_t m_SpriteCount{};
+        std::vector<uint32_t> m_FreeSprites;
+
+        std::vector<glm::vec4> m_SpritePositions;
+        std::vector<glm::vec2> m_SpriteSizes;
+        std::vector<uint32_t> m_SpriteTextureIndices;
+        std::vector<SpriteAnimation> m_SpriteAnimations;
+
+        // One dirty bitset per frame in flight, each frame owns its own copy of the sprite buffers
+        std::vector<std::vector<uint64_t>> m_DirtySprites;
+        std::vector<uint8_t> m_FrameDirty;
+        std::vector<UploadRange> m_DirtyRanges;
+
+        std::shared_ptr<Shader> m_RetainedShader;
+        std::shared_ptr<Shader> m_CullShader;
+        bool m_RetainedCulled{};
     };
 }// namespace LunaraEngine
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "Camera.hpp"
 #include <glm/gtc/matrix_transform.hpp>
 #include <LunaraEngine/Engine.hpp>
+#include <limits>
 
 namespace LunaraEngine
 {
@@ -52,6 +53,22 @@ namespace LunaraEngine
         CalculateProjection();
     }
 
+    FRect Camera::GetVisibleRect() const
+    {
+        // Unproject the clip space corners back to world space
+        glm::mat4 inverse = glm::inverse(m_Projection * m_View * m_Model);
+        glm::vec2 min{std::numeric_limits<f32>::max()};
+        glm::vec2 max{std::numeric_limits<f32>::lowest()};
+        for (glm::vec2 corner: {glm::vec2{-1.0f, -1.0f}, glm::vec2{1.0f, -1.0f}, glm::vec2{-1.0f, 1.0f},
+                                glm::vec2{1.0f, 1.0f}})
+        {
+            glm::vec4 world = inverse * glm::vec4{corner, 0.0f, 1.0f};
+            min = glm::min(min, glm::vec2{world} / world.w);
+            max = glm::max(max, glm::vec2{world} / world.w);
+        }
+        return FRect{min.x, min.y, max.x - min.x, max.y - min.y};
+    }
+
     void Camera::Upload(Shader* shader)
     {
         shader->SetUniform("model", m_Model);
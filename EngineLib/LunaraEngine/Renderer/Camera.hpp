@@ -1,5 +1,6 @@
 #pragma once
 #include "glm/glm.hpp"
+#include <LunaraEngine/Math/Rect.h>
 
 namespace LunaraEngine
 {
@@ -25,6 +26,8 @@ namespace LunaraEngine
 
         [[nodiscard]] glm::mat4 GetModelMatrix() const { return m_Model; }
 
+        [[nodiscard]] FRect GetVisibleRect() const;
+
     public:
         void Upload(Shader* shader);
         void Init();
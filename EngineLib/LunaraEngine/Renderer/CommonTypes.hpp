@@ -140,6 +140,22 @@ namespace LunaraEngine
         ReadWrite = 3
     };
 
+    enum class BufferResourceUsage
+    {
+        None = 0,
+        Dynamic,
+        Transient,
+        Static,
+        Shared,
+        // One device local buffer for every frame in flight, state the GPU carries from frame to frame
+        Persistent
+    };
+
+    struct UploadRange {
+        size_t offset{};
+        size_t count{};
+    };
+
     enum class TextureDataFormat : size_t
     {
         None = 0,
@@ -194,6 +210,7 @@ namespace LunaraEngine
                                                          .layoutType = BufferResourceMemoryLayout::STD430}};
         std::vector<BufferResourceAttribute> attributes;
         BufferResourceProperty property{BufferResourceProperty::ReadWrite};
+        BufferResourceUsage usage{BufferResourceUsage::Dynamic};
     };
 
     struct TextureResource {
@@ -228,10 +245,21 @@ namespace LunaraEngine
         std::vector<ShaderInputResource> inputResources;
     };
 
+    enum class DepthTest
+    {
+        None = 0,
+        // Tested against the depth buffer without writing to it
+        Read,
+        // Tested and written, blending is turned off
+        ReadWrite
+    };
+
     struct ShaderInfo {
         std::filesystem::path path;
         std::wstring name;
+        std::wstring vertexName;// empty when the vertex stage has the shader's own name
         bool isComputeShader = false;
+        DepthTest depthTest = DepthTest::None;
         BufferResources resources;
         uint32_t numInstances{};
     };
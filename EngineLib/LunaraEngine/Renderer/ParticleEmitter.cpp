@@ -0,0 +1,76 @@
+#include "ParticleEmitter.hpp"
+#include <algorithm>
+
+namespace LunaraEngine
+{
+    ParticleEmitter::ParticleEmitter(const ParticleEmitterSettings& settings, uint32_t seed)
+        : m_Settings(settings), m_Pool(settings.capacity), m_Random(seed + 1)
+    {}
+
+    void ParticleEmitter::Update(float dt)
+    {
+        m_Pool.Integrate(dt, m_Settings.forces);
+        m_Pool.RemoveDead();
+
+        if (m_Settings.rate > 0.0f)
+        {
+            const float emitInterval = 1.0f / m_Settings.rate;
+            m_PassedTime += dt;
+            auto emitCount = static_cast<size_t>(m_PassedTime / emitInterval);
+            m_PassedTime -= (float) emitCount * emitInterval;
+            Emit(emitCount);
+        }
+
+        UpdateBounds();
+    }
+
+    void ParticleEmitter::Emit(size_t count)
+    {
+        // Each emitter draws from its own generator, the global one would race between emitters
+        std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+        for (size_t i = 0; i < count; i++)
+        {
+            glm::vec2 position =
+                    m_Settings.origin + glm::vec2{unit(m_Random), unit(m_Random)} * m_Settings.positionSpread;
+            glm::vec2 velocity =
+                    m_Settings.velocity + glm::vec2{unit(m_Random), unit(m_Random)} * m_Settings.velocitySpread;
+            if (!m_Pool.Emit(position, velocity, m_Settings.life)) { break; }
+        }
+    }
+
+    void ParticleEmitter::Emit(size_t count, glm::vec2 position, glm::vec2 velocity, float life)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            if (!m_Pool.Emit(position, velocity, life)) { break; }
+        }
+    }
+
+    void ParticleEmitter::Clear()
+    {
+        m_Pool.Clear();
+        m_PassedTime = 0.0f;
+    }
+
+    bool ParticleEmitter::Overlaps(const FRect& rect, float margin) const
+    {
+        if (m_Pool.GetCount() == 0) { return false; }
+
+        return m_BoundsMin.x - margin < rect.x + rect.w && m_BoundsMax.x + margin > rect.x &&
+               m_BoundsMin.y - margin < rect.y + rect.h && m_BoundsMax.y + margin > rect.y;
+    }
+
+    void ParticleEmitter::UpdateBounds()
+    {
+        const auto& positions = m_Pool.GetPositions();
+        glm::vec2 boundsMin{std::numeric_limits<float>::max()};
+        glm::vec2 boundsMax{std::numeric_limits<float>::lowest()};
+        for (size_t i = 0; i < m_Pool.GetCount(); i++)
+        {
+            boundsMin = glm::min(boundsMin, positions[i]);
+            boundsMax = glm::max(boundsMax, positions[i]);
+        }
+        m_BoundsMin = boundsMin;
+        m_BoundsMax = boundsMax;
+    }
+}// namespace LunaraEngine
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <LunaraEngine/Math/Rect.h>
+#include <LunaraEngine/Renderer/ParticlePool.hpp>
+#include <glm/glm.hpp>
+
+namespace LunaraEngine
+{
+    struct ParticleEmitterSettings {
+        glm::vec2 origin{};
+        // Half extents of the box new particles are placed in
+        glm::vec2 positionSpread{};
+        glm::vec2 velocity{0.0f, -1.0f};
+        // Half extents of the random velocity offset
+        glm::vec2 velocitySpread{};
+        // Particles per second, emitters with a zero rate only emit bursts
+        float rate{};
+        float life{1.0f};
+        size_t capacity{1024};
+        ParticleForces forces{};
+    };
+
+    struct ParticleEmitterHandle {
+        static constexpr uint32_t INVALID_SLOT = std::numeric_limits<uint32_t>::max();
+        uint32_t slot{INVALID_SLOT};
+
+        [[nodiscard]] bool IsValid() const { return slot != INVALID_SLOT; }
+    };
+
+    // One effect with its own particle pool, emitters share nothing so they can be updated concurrently
+    class ParticleEmitter
+    {
+    public:
+        ParticleEmitter() = default;
+        explicit ParticleEmitter(const ParticleEmitterSettings& settings, uint32_t seed = 0);
+
+    public:
+        void Update(float dt);
+        void Emit(size_t count);
+        void Emit(size_t count, glm::vec2 position, glm::vec2 velocity, float life);
+        void Clear();
+
+        void SetOrigin(glm::vec2 origin) { m_Settings.origin = origin; }
+
+        void SetRate(float particlesPerSecond) { m_Settings.rate = std::max(particlesPerSecond, 0.0f); }
+
+        [[nodiscard]] const ParticleEmitterSettings& GetSettings() const { return m_Settings; }
+
+        [[nodiscard]] const ParticlePool& GetPool() const { return m_Pool; }
+
+        // Tests the particle bounds of the last update, empty emitters never overlap
+        [[nodiscard]] bool Overlaps(const FRect& rect, float margin) const;
+
+    private:
+        void UpdateBounds();
+
+    private:
+        ParticleEmitterSettings m_Settings;
+        ParticlePool m_Pool;
+        float m_PassedTime{};
+        std::minstd_rand m_Random;
+        glm::vec2 m_BoundsMin{};
+        glm::vec2 m_BoundsMax{};
+    };
+}// namespace LunaraEngine
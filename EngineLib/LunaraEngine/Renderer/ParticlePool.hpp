@@ -0,0 +1,161 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <algorithm>
+#include <glm/glm.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#define LUNARA_PARTICLE_SSE
+#endif
+
+namespace LunaraEngine
+{
+    struct ParticleForces {
+        // Velocity change per second
+        glm::vec2 wind{};
+        // Fraction of the velocity lost every step
+        float drag{};
+        // Scale from velocity to distance per second
+        float speed{1.0f};
+    };
+
+    // Alive particles occupy the dense range [0, count). Emission appends and death moves the last particle
+    // into the freed slot, so both are O(1) and updates never visit dead slots
+    class ParticlePool
+    {
+    public:
+        ParticlePool() = default;
+
+        explicit ParticlePool(size_t capacity) { Resize(capacity); }
+
+    public:
+        void Resize(size_t capacity);
+        bool Emit(glm::vec2 position, glm::vec2 velocity, float life);
+        void Kill(size_t index);
+        void Integrate(float dt, const ParticleForces& forces);
+        void RemoveDead();
+
+        void Clear() { m_Count = 0; }
+
+        [[nodiscard]] size_t GetCount() const { return m_Count; }
+
+        [[nodiscard]] size_t GetCapacity() const { return m_Lifes.size(); }
+
+        [[nodiscard]] bool IsFull() const { return m_Count == m_Lifes.size(); }
+
+        [[nodiscard]] const std::vector<glm::vec2>& GetPositions() const { return m_Positions; }
+
+        [[nodiscard]] const std::vector<glm::vec2>& GetVelocities() const { return m_Velocities; }
+
+        [[nodiscard]] const std::vector<float>& GetLifes() const { return m_Lifes; }
+
+    private:
+        std::vector<glm::vec2> m_Positions;
+        std::vector<glm::vec2> m_Velocities;
+        std::vector<float> m_Lifes;
+        size_t m_Count{};
+    };
+
+    inline void ParticlePool::Resize(size_t capacity)
+    {
+        m_Positions.resize(capacity);
+        m_Velocities.resize(capacity);
+        m_Lifes.resize(capacity);
+        m_Count = std::min(m_Count, capacity);
+    }
+
+    inline bool ParticlePool::Emit(glm::vec2 position, glm::vec2 velocity, float life)
+    {
+        if (IsFull()) { return false; }
+
+        m_Positions[m_Count] = position;
+        m_Velocities[m_Count] = velocity;
+        m_Lifes[m_Count] = life;
+        m_Count++;
+        return true;
+    }
+
+    inline void ParticlePool::Kill(size_t index)
+    {
+        size_t last = --m_Count;
+        m_Positions[index] = m_Positions[last];
+        m_Velocities[index] = m_Velocities[last];
+        m_Lifes[index] = m_Lifes[last];
+    }
+
+    inline void ParticlePool::Integrate(float dt, const ParticleForces& forces)
+    {
+        if (m_Count == 0) { return; }
+
+        // Positions and velocities are interleaved xy pairs, one float stream each
+        float* positions = &m_Positions[0].x;
+        float* velocities = &m_Velocities[0].x;
+        float* lifes = m_Lifes.data();
+        const size_t components = m_Count * 2;
+        const glm::vec2 wind = forces.wind * dt;
+        const float step = forces.speed * dt;
+        const float damping = 1.0f - forces.drag;
+
+        size_t i = 0;
+        size_t l = 0;
+#if defined(__AVX__)
+        {
+            const __m256 stepV = _mm256_set1_ps(step);
+            const __m256 windV = _mm256_setr_ps(wind.x, wind.y, wind.x, wind.y, wind.x, wind.y, wind.x, wind.y);
+            const __m256 dampingV = _mm256_set1_ps(damping);
+            for (; i + 8 <= components; i += 8)
+            {
+                __m256 position = _mm256_loadu_ps(positions + i);
+                __m256 velocity = _mm256_loadu_ps(velocities + i);
+                _mm256_storeu_ps(positions + i, _mm256_add_ps(position, _mm256_mul_ps(velocity, stepV)));
+                _mm256_storeu_ps(velocities + i, _mm256_mul_ps(_mm256_add_ps(velocity, windV), dampingV));
+            }
+
+            const __m256 dtV = _mm256_set1_ps(dt);
+            for (; l + 8 <= m_Count; l += 8)
+            {
+                _mm256_storeu_ps(lifes + l, _mm256_sub_ps(_mm256_loadu_ps(lifes + l), dtV));
+            }
+        }
+#endif
+#ifdef LUNARA_PARTICLE_SSE
+        {
+            const __m128 stepV = _mm_set1_ps(step);
+            const __m128 windV = _mm_setr_ps(wind.x, wind.y, wind.x, wind.y);
+            const __m128 dampingV = _mm_set1_ps(damping);
+            for (; i + 4 <= components; i += 4)
+            {
+                __m128 position = _mm_loadu_ps(positions + i);
+                __m128 velocity = _mm_loadu_ps(velocities + i);
+                _mm_storeu_ps(positions + i, _mm_add_ps(position, _mm_mul_ps(velocity, stepV)));
+                _mm_storeu_ps(velocities + i, _mm_mul_ps(_mm_add_ps(velocity, windV), dampingV));
+            }
+
+            const __m128 dtV = _mm_set1_ps(dt);
+            for (; l + 4 <= m_Count; l += 4) { _mm_storeu_ps(lifes + l, _mm_sub_ps(_mm_loadu_ps(lifes + l), dtV)); }
+        }
+#endif
+
+        // Scalar tail and fallback
+        for (; i < components; i += 2)
+        {
+            size_t index = i / 2;
+            m_Positions[index] += m_Velocities[index] * step;
+            m_Velocities[index] = (m_Velocities[index] + wind) * damping;
+        }
+        for (; l < m_Count; l++) { lifes[l] -= dt; }
+    }
+
+    inline void ParticlePool::RemoveDead()
+    {
+        // A moved in particle has not been checked yet, so the index only advances past survivors
+        size_t i = 0;
+        while (i < m_Count)
+        {
+            if (m_Lifes[i] > 0.0f) { i++; }
+            else { Kill(i); }
+        }
+    }
+}// namespace LunaraEngine
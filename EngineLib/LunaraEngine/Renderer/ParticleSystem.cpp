@@ -3,134 +3,346 @@
 #include <LunaraEngine/Renderer/Shader.hpp>
 #include <LunaraEngine/Renderer/Buffer/StorageBuffer.hpp>
 #include <LunaraEngine/Renderer/RendererCommands.hpp>
+#include <LunaraEngine/Renderer/Renderer.hpp>
+#include <LunaraEngine/Renderer/Camera.hpp>
+#include <LunaraEngine/Core/Log.h>
+#include <LunaraEngine/Core/JobSystem.hpp>
 #include <glm/glm.hpp>
-#include <glm/gtc/random.hpp>
 #include <numeric>
+#include <algorithm>
 
 #include <span>
 
 namespace LunaraEngine
 {
-    ParticleSystem::ParticleSystem()
+    namespace
     {
-        m_Capacity = MAX_PARTICLES;
+        // Wind blowing along {0.3, -0.2} at a speed of 5
+        constexpr ParticleEmitterSettings DEFAULT_EMITTER{.origin = {500.0f, 750.0f},
+                                                          .positionSpread = {175.0f, 0.0f},
+                                                          .velocity = {0.0f, -1.0f},
+                                                          .velocitySpread = {0.04f, 0.0f},
+                                                          .rate = 10.0f,
+                                                          .life = 1.5f,
+                                                          .capacity = 1024,
+                                                          .forces = {.wind = {1.5f, -1.0f},
+                                                                     .drag = 0.0004f,
+                                                                     .speed = 350.0f}};
+    }// namespace
+
+    ParticleSystem::ParticleSystem(ParticleSimulation simulation)
+    {
+        m_Simulation = simulation;
+        m_GPUEmitter = DEFAULT_EMITTER;
         m_Offset = 0;
+
+        // GPU particles never exist on the host
+        if (m_Simulation == ParticleSimulation::GPU)
+        {
+            m_Capacity = MAX_GPU_PARTICLES;
+            return;
+        }
+
+        m_Capacity = MAX_PARTICLES;
         m_ParticleCount = m_Capacity;
-        m_Positions.resize(m_Capacity);
-        m_Velocities.resize(m_Capacity);
-        m_Lifes.resize(m_Capacity);
-        m_LifeIndices.resize(m_Capacity);
-        std::fill(m_Lifes.begin(), m_Lifes.end(), 0.0f);
-        std::fill(m_LifeIndices.begin(), m_LifeIndices.end(), 0);
-        std::fill(m_Positions.begin(), m_Positions.end(), glm::vec2(0.0f));
-        std::fill(m_Velocities.begin(), m_Velocities.end(), glm::vec2(0.0f));
+        m_DrawPositions.resize(m_Capacity);
+        m_DrawLifes.resize(m_Capacity);
+        m_DrawIndices.resize(m_Capacity);
+        std::iota(m_DrawIndices.begin(), m_DrawIndices.end(), 0u);
+
+        // The default emitter keeps the original effect and receives the particles of Emit
+        ParticleEmitterSettings settings = DEFAULT_EMITTER;
+        settings.capacity = MAX_PARTICLES;
+        m_DefaultEmitter = CreateEmitter(settings);
     }
 
-    void ParticleSystem::Create(const ApplicationConfig& config)
+    void ParticleSystem::Create(const ApplicationConfig& config, ParticleSimulation simulation)
     {
+        s_ParticleSystem = new ParticleSystem(simulation);
+        s_ParticleSystem->CreateShaders(config);
+    }
 
-        s_ParticleSystem = new ParticleSystem();
+    void ParticleSystem::CreateShaders(const ApplicationConfig& config)
+    {
+        bool gpu = m_Simulation == ParticleSimulation::GPU;
+        auto usage = gpu ? BufferResourceUsage::Shared : BufferResourceUsage::Transient;
+
+        std::vector<BufferResource> resources = {
+                BufferResourceBuilder("UniformBuffer", BufferResourceType::UniformBuffer)
+                        .AddAttribute("model", BufferResourceAttributeType::Mat4)
+                        .AddAttribute("view", BufferResourceAttributeType::Mat4)
+                        .AddAttribute("projection", BufferResourceAttributeType::Mat4)
+                        .AddAttribute("zoom", BufferResourceAttributeType::Float)
+                        .Build(),
+                BufferResourceBuilder("ParticlePositions", BufferResourceType::StorageBuffer, m_Capacity)
+                        .AddAttribute("Position", BufferResourceAttributeType::Vec2)
+                        .SetUsage(usage)
+                        .Build(),
+                BufferResourceBuilder("ParticleLifes", BufferResourceType::StorageBuffer, m_Capacity)
+                        .AddAttribute("Life", BufferResourceAttributeType::Float)
+                        .SetUsage(usage)
+                        .Build(),
+                BufferResourceBuilder("AliveParticles", BufferResourceType::StorageBuffer, m_Capacity)
+                        .AddAttribute("Index", BufferResourceAttributeType::UInt)
+                        .SetUsage(usage)
+                        .Build()};
+
+        // The instance count of the GPU path is written by the simulation pass
+        if (gpu)
+        {
+            resources.push_back(BufferResourceBuilder("DrawCommand", BufferResourceType::StorageBuffer)
+                                        .AddAttribute("vertexCount", BufferResourceAttributeType::UInt)
+                                        .AddAttribute("instanceCount", BufferResourceAttributeType::UInt)
+                                        .AddAttribute("firstVertex", BufferResourceAttributeType::UInt)
+                                        .AddAttribute("firstInstance", BufferResourceAttributeType::UInt)
+                                        .SetUsage(BufferResourceUsage::Shared)
+                                        .Build());
+        }
 
-        s_ParticleSystem->m_Shader = Shader::Create(
+        m_Shader = Shader::Create(
                 ShaderInfoBuilder("ParticleShader", config.shadersDirectory)
-                        .AddResources({BufferResourceBuilder("UniformBuffer", BufferResourceType::UniformBuffer)
-                                               .AddAttribute("model", BufferResourceAttributeType::Mat4)
-                                               .AddAttribute("view", BufferResourceAttributeType::Mat4)
-                                               .AddAttribute("projection", BufferResourceAttributeType::Mat4)
-                                               .AddAttribute("zoom", BufferResourceAttributeType::Float)
-                                               .Build(),
-                                       BufferResourceBuilder(
-                                               "ParticlePositions", BufferResourceType::StorageBuffer, MAX_PARTICLES)
-                                               .AddAttribute("Position", BufferResourceAttributeType::Vec2)
-                                               .Build(),
-                                       BufferResourceBuilder(
-                                               "ParticleLifes", BufferResourceType::StorageBuffer, MAX_PARTICLES)
-                                               .AddAttribute("Life", BufferResourceAttributeType::Float)
-                                               .Build(),
-                                       BufferResourceBuilder(
-                                               "AliveParticles", BufferResourceType::StorageBuffer, MAX_PARTICLES)
-                                               .AddAttribute("Index", BufferResourceAttributeType::UInt)
-                                               .Build()})
+                        .AddResources(std::move(resources))
                         .AddResource(
                                 TextureResourceBuilder<TextureResourceType::Texture2D>(
-                                        "Texture", TextureInfo{.path = config.texturesDirectory, .name = L"block.png"})
+                                        "Texture",
+                                        // The block texture the particle shader was written against is not shipped
+                                        TextureInfo{.path = config.texturesDirectory,
+                                                    .name = L"world_tileset_sprites/world_tileset_r14_c3.png"})
                                         .Build())
                         .Build());
+
+        if (!gpu) { return; }
+
+        // Particle state stays in one device local copy shared by all frames, the draw reads it in place
+        m_ComputeShader = Shader::Create(
+                ShaderInfoBuilder("ParticleSimulate", config.shadersDirectory)
+                        .UseAsComputeShader()
+                        .AddResources(
+                                {BufferResourceBuilder("SimulationParams", BufferResourceType::UniformBuffer)
+                                         .AddAttribute("wind", BufferResourceAttributeType::Vec4)
+                                         .AddAttribute("emitter", BufferResourceAttributeType::Vec4)
+                                         .AddAttribute("emitVelocity", BufferResourceAttributeType::Vec4)
+                                         .AddAttribute("dt", BufferResourceAttributeType::Float)
+                                         .AddAttribute("emitCount", BufferResourceAttributeType::UInt)
+                                         .AddAttribute("seed", BufferResourceAttributeType::UInt)
+                                         .AddAttribute("capacity", BufferResourceAttributeType::UInt)
+                                         .Build(),
+                                 BufferResourceBuilder("Positions", BufferResourceType::StorageBuffer, m_Capacity)
+                                         .AddAttribute("Position", BufferResourceAttributeType::Vec2)
+                                         .SetUsage(BufferResourceUsage::Persistent)
+                                         .Build(),
+                                 BufferResourceBuilder("Velocities", BufferResourceType::StorageBuffer, m_Capacity)
+                                         .AddAttribute("Velocity", BufferResourceAttributeType::Vec2)
+                                         .SetUsage(BufferResourceUsage::Persistent)
+                                         .Build(),
+                                 BufferResourceBuilder("Lifes", BufferResourceType::StorageBuffer, m_Capacity)
+                                         .AddAttribute("Life", BufferResourceAttributeType::Float)
+                                         .SetUsage(BufferResourceUsage::Persistent)
+                                         .Build(),
+                                 BufferResourceBuilder("AliveParticles", BufferResourceType::StorageBuffer, m_Capacity)
+                                         .AddAttribute("Index", BufferResourceAttributeType::UInt)
+                                         .SetUsage(BufferResourceUsage::Persistent)
+                                         .Build(),
+                                 BufferResourceBuilder("DrawCommand", BufferResourceType::StorageBuffer)
+                                         .AddAttribute("vertexCount", BufferResourceAttributeType::UInt)
+                                         .AddAttribute("instanceCount", BufferResourceAttributeType::UInt)
+                                         .AddAttribute("firstVertex", BufferResourceAttributeType::UInt)
+                                         .AddAttribute("firstInstance", BufferResourceAttributeType::UInt)
+                                         .AddAttribute("emitted", BufferResourceAttributeType::UInt)
+                                         .SetUsage(BufferResourceUsage::Persistent)
+                                         .Build()})
+                        .Build());
+
+        m_Shader->ShareBuffer(ShaderBinding::_1, m_ComputeShader.get(), ShaderBinding::_1);
+        m_Shader->ShareBuffer(ShaderBinding::_2, m_ComputeShader.get(), ShaderBinding::_3);
+        m_Shader->ShareBuffer(ShaderBinding::_3, m_ComputeShader.get(), ShaderBinding::_4);
+        m_Shader->ShareBuffer(ShaderBinding::_4, m_ComputeShader.get(), ShaderBinding::_5);
     }
 
     void ParticleSystem::Destroy() { delete s_ParticleSystem; }
 
     void ParticleSystem::Update(float dt)
     {
-        constexpr float emitPerSecond = 10.0f;
-        constexpr float emitInterval = 1.0f / emitPerSecond;
-        constexpr float speed = 350.0f;
-        constexpr float windSpeed = 5.0f;
-        constexpr float windResistance = 0.0004f;
-        constexpr glm::vec2 windDir = {0.3f, -0.2f};
-
-        for (size_t id = 0; id < m_Capacity; ++id)
+        if (m_Simulation == ParticleSimulation::GPU)
         {
-            auto& particleLife = m_Lifes[id];
-            if (particleLife <= 0.0f)
-            {
-                particleLife = 0.0f;
-                continue;
-            }
-
-            m_Positions[id] += m_Velocities[id] * speed * dt;
-            m_Velocities[id] += windDir * windSpeed * dt;
-            m_Velocities[id] *= 1.0f - windResistance;
-            particleLife -= dt;
+            // Integration and emission happen in the next simulation pass, only the work is accumulated
+            const float emitInterval = 1.0f / m_GPUEmitter.rate;
+            m_PendingTime += dt;
+            m_PassedTime += dt;
+            auto emitCount = static_cast<uint32_t>(m_PassedTime / emitInterval);
+            m_PassedTime -= (float) emitCount * emitInterval;
+            m_PendingEmits += emitCount;
+            return;
         }
 
-        m_PassedTime += dt;
+        // Emitters share no state, each one integrates and emits on its own
+        JobSystem::ParallelFor(
+                m_Emitters.size(),
+                [this, dt](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; i++)
+                    {
+                        if (m_Emitters[i]) { m_Emitters[i]->Update(dt); }
+                    }
+                },
+                1);
+    }
 
-        auto emitCount = static_cast<size_t>(m_PassedTime / emitInterval);
+    void ParticleSystem::Emit(size_t count, glm::vec2 position, glm::vec2 velocity, float life, float mass)
+    {
+        (void) mass;
 
-        if (emitCount > 0)
+        // The GPU path has a single emitter, emitting moves it for the pending particles
+        if (m_Simulation == ParticleSimulation::GPU)
         {
-            m_PassedTime -= (float) emitCount * emitInterval;
-            for (size_t i = 0; i < emitCount; i++)
-            {
-                // float t = (1.0f + (float) i) / (1.0f + (float) emitCount);
-                glm::vec2 origin = {500.0f, 750.0f};
-                glm::vec2 velocity = {glm::linearRand(-0.04f, 0.04f), -1.0f};
-                glm::vec2 position = origin + glm::vec2{glm::linearRand(-0.5f, 0.5f), 0.0f} * speed;
+            m_GPUEmitter.origin = position;
+            m_GPUEmitter.velocity = velocity;
+            m_GPUEmitter.life = life;
+            m_PendingEmits += (uint32_t) std::min(count, m_Capacity);
+            return;
+        }
 
-                Emit(1, position, velocity, 1.5, 1.0f);
-            }
+        if (auto* emitter = GetEmitter(m_DefaultEmitter)) { emitter->Emit(count, position, velocity, life); }
+    }
+
+    void ParticleSystem::SetEmitRate(float particlesPerSecond)
+    {
+        if (m_Simulation == ParticleSimulation::GPU)
+        {
+            m_GPUEmitter.rate = std::max(particlesPerSecond, 0.001f);
+            return;
         }
+        if (auto* emitter = GetEmitter(m_DefaultEmitter)) { emitter->SetRate(particlesPerSecond); }
     }
 
-    void ParticleSystem::Emit(size_t count, glm::vec2 position, glm::vec2 velocity, float life, float mass)
+    ParticleEmitterHandle ParticleSystem::CreateEmitter(const ParticleEmitterSettings& settings)
     {
-        for (size_t i = 0; i < count; i++)
+        ParticleEmitterHandle handle{};
+        if (m_Simulation == ParticleSimulation::GPU)
         {
-            auto slot = std::ranges::find_if(m_Lifes, [](auto& life) { return life <= 0.0f; });
-            if (slot == m_Lifes.end()) return;
-            auto index = (size_t) std::distance(m_Lifes.begin(), slot);
-            m_Positions[index] = position;
-            m_Velocities[index] = velocity;
-            m_Lifes[index] = life;
+            LOG_WARNING("GPU particles only support the built in emitter");
+            return handle;
         }
-        (void) mass;
+
+        if (!m_FreeEmitters.empty())
+        {
+            handle.slot = m_FreeEmitters.back();
+            m_FreeEmitters.pop_back();
+        }
+        else
+        {
+            handle.slot = (uint32_t) m_Emitters.size();
+            m_Emitters.emplace_back();
+        }
+        m_Emitters[handle.slot] = std::make_unique<ParticleEmitter>(settings, m_NextSeed++);
+        return handle;
+    }
+
+    void ParticleSystem::DestroyEmitter(ParticleEmitterHandle& handle)
+    {
+        if (GetEmitter(handle) == nullptr) { return; }
+
+        m_Emitters[handle.slot].reset();
+        m_FreeEmitters.push_back(handle.slot);
+        handle.slot = ParticleEmitterHandle::INVALID_SLOT;
     }
 
+    ParticleEmitter* ParticleSystem::GetEmitter(ParticleEmitterHandle handle)
+    {
+        if (!handle.IsValid() || handle.slot >= m_Emitters.size()) { return nullptr; }
+        return m_Emitters[handle.slot].get();
+    }
+
+    void ParticleSystem::SetCullRect(const Camera& camera) { SetCullRect(camera.GetVisibleRect()); }
+
+    void ParticleSystem::SetCullRect(const FRect& rect)
+    {
+        m_CullingEnabled = true;
+        m_CullRect = rect;
+    }
+
+    void ParticleSystem::DisableCulling() { m_CullingEnabled = false; }
+
     ParticleSystem* ParticleSystem::GetInstance() { return s_ParticleSystem; }
 
+    void ParticleSystem::Simulate()
+    {
+        auto instance = GetInstance();
+        if (instance == nullptr || instance->m_Simulation != ParticleSimulation::GPU) { return; }
+        auto* shader = instance->m_ComputeShader.get();
+
+        // Device memory starts undefined, every slot has to begin dead
+        if (!instance->m_Simulated)
+        {
+            Renderer::FillBuffer(shader, ShaderBinding::_3, 0, instance->m_Capacity * sizeof(float), 0);
+        }
+
+        const auto& emitter = instance->m_GPUEmitter;
+        shader->SetUniform("wind", glm::vec4{emitter.forces.wind, 1.0f, emitter.forces.drag});
+        shader->SetUniform("emitter",
+                           glm::vec4{emitter.origin, 2.0f * emitter.positionSpread.x, emitter.forces.speed});
+        shader->SetUniform("emitVelocity", glm::vec4{emitter.velocity, emitter.velocitySpread.x, emitter.life});
+        shader->SetUniform("dt", instance->m_PendingTime);
+        shader->SetUniform("emitCount", instance->m_PendingEmits);
+        shader->SetUniform("seed", instance->m_SimulationFrame++);
+        shader->SetUniform("capacity", (uint32_t) instance->m_Capacity);
+
+        // The instance count and the emission counter are accumulated atomically, they restart from zero
+        Renderer::FillBuffer(shader, ShaderBinding::_5, sizeof(uint32_t), 4 * sizeof(uint32_t), 0);
+        Renderer::BindShader(shader);
+        Renderer::Dispatch(shader, (uint32_t) ((instance->m_Capacity + SIMULATE_GROUP_SIZE - 1) / SIMULATE_GROUP_SIZE));
+
+        instance->m_PendingTime = 0.0f;
+        instance->m_PendingEmits = 0;
+        instance->m_Simulated = true;
+    }
+
     RendererCommandDrawBatch* ParticleSystem::CreateDrawCommand()
     {
         auto instance = GetInstance();
+        if (instance->m_Simulation == ParticleSimulation::GPU)
+        {
+            // Draw arguments and the alive list stay valid between passes, nothing is uploaded
+            BufferUploadListBuilder uploadListBuilder(std::weak_ptr<Shader>(instance->m_Shader));
+            auto* command = new RendererCommandDrawBatch(uploadListBuilder.Get(), 0, 0);
+            command->indirect = instance->m_Simulated;
+            command->indirectBinding = ShaderBinding::_4;
+            return command;
+        }
+
+        // Visible emitters get consecutive parts of the draw streams, the alive list is their identity
+        instance->m_Batches.clear();
         size_t aliveParticleCount = 0;
+        for (const auto& emitter: instance->m_Emitters)
+        {
+            if (!emitter || (instance->m_CullingEnabled && !emitter->Overlaps(instance->m_CullRect, PARTICLE_EXTENT)))
+            {
+                continue;
+            }
+            size_t count = std::min(emitter->GetPool().GetCount(), instance->m_Capacity - aliveParticleCount);
+            if (count == 0) { continue; }
+            instance->m_Batches.push_back(EmitterBatch{emitter.get(), aliveParticleCount, count});
+            aliveParticleCount += count;
+        }
 
-        std::ranges::for_each(instance->m_Lifes, [&](const auto& life) {
-            if (life <= 0.0f) return;
-            instance->m_LifeIndices[aliveParticleCount++] = (uint32_t) (&life - &instance->m_Lifes[0]);
-        });
+        // The parts never overlap so emitters are copied concurrently
+        JobSystem::ParallelFor(
+                instance->m_Batches.size(),
+                [instance](size_t begin, size_t end) {
+                    for (size_t i = begin; i < end; i++)
+                    {
+                        const auto& batch = instance->m_Batches[i];
+                        const auto& pool = batch.emitter->GetPool();
+                        std::copy_n(pool.GetPositions().begin(), batch.count,
+                                    instance->m_DrawPositions.begin() + (std::ptrdiff_t) batch.offset);
+                        std::copy_n(pool.GetLifes().begin(), batch.count,
+                                    instance->m_DrawLifes.begin() + (std::ptrdiff_t) batch.offset);
+                    }
+                },
+                1);
 
         BufferUploadListBuilder uploadListBuilder(std::weak_ptr<Shader>(instance->m_Shader));
-        uploadListBuilder.Add(instance->m_Positions, instance->m_Lifes, instance->m_LifeIndices);
+        uploadListBuilder.SetRange(0, aliveParticleCount)
+                .Add(instance->m_DrawPositions, instance->m_DrawLifes, instance->m_DrawIndices);
 
         RendererCommandDrawBatch* command =
                 new RendererCommandDrawBatch(uploadListBuilder.Get(), aliveParticleCount, 0);
@@ -4,6 +4,8 @@
 #include <memory>
 #include <filesystem>
 #include <LunaraEngine/Core/CommonTypes.hpp>
+#include <LunaraEngine/Renderer/ParticleEmitter.hpp>
+#include <LunaraEngine/Math/Rect.h>
 #include <glm/glm.hpp>
 
 namespace LunaraEngine
@@ -15,6 +17,13 @@ namespace LunaraEngine
         float Life;
     };
 
+    // CPU particles are uploaded every frame, GPU particles stay in device memory and are simulated by a compute pass
+    enum class ParticleSimulation
+    {
+        CPU = 0,
+        GPU
+    };
+
     using std::size_t;
     template <typename T>
     class IndexBuffer;
@@ -22,23 +31,40 @@ namespace LunaraEngine
     class StorageBuffer;
     class RendererCommandDrawBatch;
     class Shader;
+    class Camera;
 
     class ParticleSystem
     {
     public:
-        ParticleSystem();
+        explicit ParticleSystem(ParticleSimulation simulation);
         ~ParticleSystem() = default;
 
     public:
         static ParticleSystem* GetInstance();
-        static void Create(const ApplicationConfig& config);
+        static void Create(const ApplicationConfig& config, ParticleSimulation simulation = ParticleSimulation::CPU);
         static void Destroy();
 
     public:
         void Update(float dt);
         void Emit(size_t count, glm::vec2 position, glm::vec2 velocity, float life, float mass);
+        void SetEmitRate(float particlesPerSecond);
+
+        ParticleEmitterHandle CreateEmitter(const ParticleEmitterSettings& settings);
+        void DestroyEmitter(ParticleEmitterHandle& handle);
+        [[nodiscard]] ParticleEmitter* GetEmitter(ParticleEmitterHandle handle);
+
+        [[nodiscard]] ParticleEmitterHandle GetDefaultEmitter() const { return m_DefaultEmitter; }
+
+        void SetCullRect(const Camera& camera);
+        void SetCullRect(const FRect& rect);
+        void DisableCulling();
+
+        [[nodiscard]] ParticleSimulation GetSimulation() const { return m_Simulation; }
+
+        [[nodiscard]] size_t GetCapacity() const { return m_Capacity; }
 
     public:
+        static void Simulate();
         static RendererCommandDrawBatch* CreateDrawCommand();
         static void Flush();
         static std::weak_ptr<Shader> GetShader();
@@ -46,18 +72,49 @@ namespace LunaraEngine
     private:
         inline static ParticleSystem* s_ParticleSystem = nullptr;
 
-        static constexpr size_t MAX_PARTICLES = 1000;
+        static constexpr size_t MAX_PARTICLES = size_t{1} << 17;
+        static constexpr size_t MAX_GPU_PARTICLES = size_t{1} << 21;
+        static constexpr size_t SIMULATE_GROUP_SIZE = 64;
+        // Half size of a particle quad in the particle shader
+        static constexpr float PARTICLE_EXTENT = 100.0f;
+
+        // Part of the shared draw streams filled from one emitter
+        struct EmitterBatch {
+            const ParticleEmitter* emitter{};
+            size_t offset{};
+            size_t count{};
+        };
+
+    private:
+        void CreateShaders(const ApplicationConfig& config);
 
     private:
         size_t m_Offset{};
         size_t m_ParticleCount{};
         size_t m_Capacity{};
         float m_PassedTime{};
+        ParticleSimulation m_Simulation{ParticleSimulation::CPU};
+
+        // GPU emitter, work accumulated by Update until the next simulation pass
+        ParticleEmitterSettings m_GPUEmitter;
+        float m_PendingTime{};
+        uint32_t m_PendingEmits{};
+        uint32_t m_SimulationFrame{};
+        bool m_Simulated{};
+
+        std::vector<std::unique_ptr<ParticleEmitter>> m_Emitters;
+        std::vector<uint32_t> m_FreeEmitters;
+        ParticleEmitterHandle m_DefaultEmitter;
+        uint32_t m_NextSeed{};
+
+        // All visible emitters are gathered into one set of streams and drawn together
+        std::vector<EmitterBatch> m_Batches;
+        std::vector<glm::vec2> m_DrawPositions;
+        std::vector<float> m_DrawLifes;
+        std::vector<uint32_t> m_DrawIndices;
+        bool m_CullingEnabled{};
+        FRect m_CullRect{};
 
-        std::vector<glm::vec2> m_Positions;
-        std::vector<glm::vec2> m_Velocities;
-        std::vector<float> m_Lifes;
-        std::vector<uint32_t> m_LifeIndices;
         std::shared_ptr<Shader> m_Shader;
         std::shared_ptr<Shader> m_ComputeShader;
     };
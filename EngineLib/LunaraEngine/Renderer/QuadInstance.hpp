@@ -0,0 +1,65 @@
+#pragma once
+#include <cstdint>
+#include <algorithm>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+
+namespace LunaraEngine
+{
+    enum class QuadInstanceFormat
+    {
+        // Position, size, texture index and animation in four storage buffers, 44 bytes per quad
+        Separate = 0,
+        // One interleaved 16 byte record per quad
+        Packed
+    };
+
+    // World positions exceed the half float range at tile map scale so they stay full precision,
+    // sizes are halves and the texture slot shares a word with an RGBA4444 tint
+    struct PackedQuadInstance {
+        static constexpr uint16_t WHITE = 0xFFFF;
+
+        glm::vec2 position{};
+        uint32_t size{};
+        uint32_t textureTint{};
+
+        [[nodiscard]] static PackedQuadInstance Pack(const glm::vec3& position, const glm::vec2& size,
+                                                     uint32_t textureIndex, uint16_t tint = WHITE)
+        {
+            PackedQuadInstance instance;
+            instance.position = glm::vec2(position);
+            instance.size = glm::packHalf2x16(size);
+            instance.textureTint = (std::min(textureIndex, uint32_t{0xFFFF})) | (uint32_t{tint} << 16);
+            return instance;
+        }
+
+        [[nodiscard]] static uint16_t PackTint(const glm::vec4& color)
+        {
+            auto channel = [](float value) { return (uint16_t) (std::clamp(value, 0.0f, 1.0f) * 15.0f + 0.5f); };
+            return (uint16_t) (channel(color.r) | channel(color.g) << 4 | channel(color.b) << 8 |
+                               channel(color.a) << 12);
+        }
+
+        [[nodiscard]] glm::vec2 GetSize() const { return glm::unpackHalf2x16(size); }
+
+        [[nodiscard]] uint32_t GetTextureIndex() const { return textureTint & 0xFFFF; }
+
+        [[nodiscard]] uint16_t GetTint() const { return (uint16_t) (textureTint >> 16); }
+    };
+
+    static_assert(sizeof(PackedQuadInstance) == 16);
+
+    // Flipbook evaluated in the vertex shader from the time uniform, a zero frame count draws the plain texture.
+    // The frames are consecutive texture indices starting at startFrame
+    struct SpriteAnimation {
+        uint32_t startFrame{};
+        uint32_t frameCount{};
+        float fps{};
+        float startTime{};
+
+        [[nodiscard]] bool IsAnimated() const { return frameCount > 0; }
+    };
+
+    static_assert(sizeof(SpriteAnimation) == 16);
+}// namespace LunaraEngine
@@ -0,0 +1,134 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <vector>
+
+namespace LunaraEngine
+{
+    namespace RadixSortDetail
+    {
+        inline constexpr uint32_t MAX_DIGIT_BITS = 12;
+        inline constexpr uint32_t MAX_PASSES = 3;
+    }// namespace RadixSortDetail
+
+    // Stable LSD radix sort, indices receives the positions of the keys in ascending order. Only the bits that
+    // differ between the keys are sorted, so a single layer or a narrow depth range takes fewer passes
+    inline void RadixSort(std::span<const uint32_t> keys, std::vector<uint32_t>& indices,
+                          std::vector<uint32_t>& scratch)
+    {
+        using namespace RadixSortDetail;
+
+        const size_t count = keys.size();
+        indices.resize(count);
+        if (count == 0) { return; }
+
+        uint32_t varying = 0;
+        for (uint32_t key: keys) { varying |= key ^ keys[0]; }
+        if (varying == 0)
+        {
+            std::iota(indices.begin(), indices.end(), 0u);
+            return;
+        }
+
+        // Up to 12 bit digits keep every histogram inside the L1 cache, the digits are spread evenly over the
+        // varying bits
+        const uint32_t lowBit = (uint32_t) std::countr_zero(varying);
+        const uint32_t bits = 32 - (uint32_t) std::countl_zero(varying) - lowBit;
+        const uint32_t passes = (bits + MAX_DIGIT_BITS - 1) / MAX_DIGIT_BITS;
+        const uint32_t digitBits = (bits + passes - 1) / passes;
+        const uint32_t digitMask = (uint32_t) ((uint64_t{1} << digitBits) - 1);
+
+        // All histograms are built in the same read of the keys
+        std::array<std::array<uint32_t, size_t{1} << MAX_DIGIT_BITS>, MAX_PASSES> histograms;
+        for (uint32_t pass = 0; pass < passes; pass++)
+        {
+            std::fill_n(histograms[pass].begin(), digitMask + 1, 0u);
+        }
+        // Layered keys with 16 bit depth always take two passes, spelled out so the loop has no inner loop
+        if (passes == 2)
+        {
+            for (uint32_t key: keys)
+            {
+                key >>= lowBit;
+                ++histograms[0][key & digitMask];
+                ++histograms[1][(key >> digitBits) & digitMask];
+            }
+        }
+        else
+        {
+            for (uint32_t key: keys)
+            {
+                key >>= lowBit;
+                for (uint32_t pass = 0; pass < passes; pass++)
+                {
+                    ++histograms[pass][(key >> (pass * digitBits)) & digitMask];
+                }
+            }
+        }
+        for (uint32_t pass = 0; pass < passes; pass++)
+        {
+            uint32_t sum = 0;
+            for (uint32_t digit = 0; digit <= digitMask; digit++)
+            {
+                uint32_t bucketCount = histograms[pass][digit];
+                histograms[pass][digit] = sum;
+                sum += bucketCount;
+            }
+        }
+
+        // Scattering in order keeps the submission order between equal keys
+        if (passes == 1)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                indices[histograms[0][(keys[i] >> lowBit) & digitMask]++] = (uint32_t) i;
+            }
+            return;
+        }
+
+        // The digits left after the first pass travel in the same word as the index, so the following passes
+        // read and write 4 bytes per key sequentially instead of looking the keys up again
+        scratch.resize(count);
+        const auto indexBits = (uint32_t) std::bit_width(count - 1);
+        if (bits - digitBits + indexBits <= 32)
+        {
+            const uint32_t indexMask = (uint32_t) ((uint64_t{1} << indexBits) - 1);
+            for (size_t i = 0; i < count; i++)
+            {
+                const uint32_t key = keys[i] >> lowBit;
+                scratch[histograms[0][key & digitMask]++] = ((key >> digitBits) << indexBits) | (uint32_t) i;
+            }
+
+            std::span<uint32_t> src(scratch);
+            std::span<uint32_t> dst(indices);
+            for (uint32_t pass = 1; pass < passes; pass++)
+            {
+                // The last pass strips the digits and leaves the plain index
+                const uint32_t shift = indexBits + (pass - 1) * digitBits;
+                const uint32_t keep = pass == passes - 1 ? indexMask : ~0u;
+                for (uint32_t entry: src) { dst[histograms[pass][(entry >> shift) & digitMask]++] = entry & keep; }
+                std::swap(src, dst);
+            }
+
+            // An even number of passes after the first one leaves the result in the scratch buffer
+            if (src.data() != indices.data()) { std::ranges::copy(src, indices.begin()); }
+            return;
+        }
+
+        // Keys too wide to share a word with the index are looked up through it on every pass
+        std::span<uint32_t> src(scratch);
+        std::span<uint32_t> dst(indices);
+        for (size_t i = 0; i < count; i++) { src[histograms[0][(keys[i] >> lowBit) & digitMask]++] = (uint32_t) i; }
+        for (uint32_t pass = 1; pass < passes; pass++)
+        {
+            const uint32_t shift = lowBit + pass * digitBits;
+            for (uint32_t index: src) { dst[histograms[pass][(keys[index] >> shift) & digitMask]++] = index; }
+            std::swap(src, dst);
+        }
+        if (src.data() != indices.data()) { std::ranges::copy(src, indices.begin()); }
+    }
+}// namespace LunaraEngine
@@ -45,6 +45,7 @@ Includes
 #include "Fonts.hpp"
 #include <LunaraEngine/Renderer/RendererCommands.hpp>
 #include <LunaraEngine/Core/Log.h>
+#include <algorithm>
 #include <string_view>
 
 namespace LunaraEngine
@@ -136,15 +137,64 @@ namespace LunaraEngine
         if (batchRenderer.expired()) return;
         auto batch = batchRenderer.lock();
 
-        PushCommand(batch->CreateDrawCommand());
+        for (auto* command: batch->CreateDrawCommands()) { PushCommand(command); }
 
         batch->Flush();
     }
 
+    void Renderer::DrawRetainedSprites(std::weak_ptr<BatchRenderer> batchRenderer)
+    {
+        if (batchRenderer.expired()) return;
+        auto batch = batchRenderer.lock();
+
+        PushCommand(batch->CreateRetainedDrawCommand());
+    }
+
+    void Renderer::CullRetainedSprites(std::weak_ptr<BatchRenderer> batchRenderer, const Camera& camera)
+    {
+        if (batchRenderer.expired()) return;
+        auto batch = batchRenderer.lock();
+
+        batch->CullRetainedSprites(camera);
+    }
+
+    void Renderer::Dispatch(Shader* shader, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+    {
+        PushCommand(new RendererCommandDispatch(shader, groupCountX, groupCountY, groupCountZ));
+    }
+
+    void Renderer::FillBuffer(Shader* shader, ShaderBinding binding, size_t offset, size_t size, uint32_t value)
+    {
+        PushCommand(new RendererCommandFillBuffer(shader, binding, offset, size, value));
+    }
+
+    void Renderer::DrawTileMap(std::weak_ptr<TileMap> tileMap, const Camera& camera)
+    {
+        if (tileMap.expired()) return;
+        auto map = tileMap.lock();
+
+        for (auto* command: map->CreateDrawCommands(camera)) { PushCommand(command); }
+    }
+
     void Renderer::Flush()
     {
-        for (const auto& cmd: Renderer::GetInstance()->m_CommandStack)
+        auto& commandStack = Renderer::GetInstance()->m_CommandStack;
+
+        // Uploads are recorded once the frame started, its buffers are free again after BeginFrame waited for them
+        auto beginFrame = std::ranges::find(commandStack, std::variant<RendererCommandType, RendererCommand*>(
+                                                                  RendererCommandType::BeginFrame));
+        auto uploadsAt = beginFrame == commandStack.end() ? commandStack.begin() : std::next(beginFrame);
+        std::vector<const RendererCommand*> uploadCommands;
+        for (auto it = uploadsAt; it != commandStack.end(); it++)
         {
+            if (auto* command = std::get_if<RendererCommand*>(&*it)) { uploadCommands.push_back(*command); }
+        }
+
+        for (auto it = commandStack.begin(); it != commandStack.end(); it++)
+        {
+            if (it == uploadsAt) { RendererAPI::GetInstance()->RecordStagedUploads(uploadCommands); }
+
+            const auto& cmd = *it;
             if (!std::holds_alternative<RendererCommand*>(cmd))
             {
                 RendererAPI::GetInstance()->HandleCommand(nullptr, std::get<RendererCommandType>(cmd));
@@ -165,6 +215,12 @@ namespace LunaraEngine
 
     size_t Renderer::GetHeight() { return size_t(); }
 
+    uint32_t Renderer::GetCurrentFrame() { return RendererAPI::GetInstance()->GetCurrentFrame(); }
+
+    uint32_t Renderer::GetFramesInFlight() { return RendererAPI::GetInstance()->GetFramesInFlight(); }
+
+    bool Renderer::HasDepthAttachment() { return RendererAPI::GetInstance()->HasDepthAttachment(); }
+
     Window* Renderer::GetWindow() { return RendererAPI::GetInstance()->GetWindow(); }
 
 
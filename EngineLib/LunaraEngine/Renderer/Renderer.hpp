@@ -51,6 +51,7 @@ Includes
 #include "Buffer/VertexBuffer.hpp"
 #include "Shader.hpp"
 #include "BatchRenderer.hpp"
+#include "TileMap.hpp"
 #include "ParticleSystem.hpp"
 
 #include <SDL3/SDL_render.h>
@@ -90,9 +91,17 @@ namespace LunaraEngine
         static void BeginRenderPass();
         static void EndRenderPass();
         static void DrawQuadBatch(std::weak_ptr<BatchRenderer> batchRenderer);
+        static void DrawRetainedSprites(std::weak_ptr<BatchRenderer> batchRenderer);
+        static void CullRetainedSprites(std::weak_ptr<BatchRenderer> batchRenderer, const Camera& camera);
+        static void Dispatch(Shader* shader, uint32_t groupCountX, uint32_t groupCountY = 1, uint32_t groupCountZ = 1);
+        static void FillBuffer(Shader* shader, ShaderBinding binding, size_t offset, size_t size, uint32_t value);
+        static void DrawTileMap(std::weak_ptr<TileMap> tileMap, const Camera& camera);
         static void Flush();
         static size_t GetWidth();
         static size_t GetHeight();
+        static uint32_t GetCurrentFrame();
+        static uint32_t GetFramesInFlight();
+        static bool HasDepthAttachment();
 
     public:
         static Window* GetWindow();
@@ -44,6 +44,7 @@ Includes
 #include "Window.hpp"
 #include "RendererCommands.hpp"
 #include <filesystem>
+#include <span>
 #include <string_view>
 #include <cstdint>
 
@@ -63,6 +64,7 @@ namespace LunaraEngine
         std::string_view windowName;
         uint32_t initialWidth;
         uint32_t initialHeight;
+        bool depthAttachment = true;
     };
 
     class RendererAPI
@@ -87,11 +89,17 @@ namespace LunaraEngine
         virtual void HandleCommand(const RendererCommand* command,
                                    const RendererCommandType type = RendererCommandType::None) = 0;
         virtual void HandleCommand(const RendererCommandType type) = 0;
+        // Called once per flush with the commands of the frame, before any of them is handled, so uploads into
+        // video memory can be recorded ahead of every pass that reads them
+        virtual void RecordStagedUploads(std::span<const RendererCommand* const> commands) = 0;
 
         virtual std::weak_ptr<RendererDataType> GetData() = 0;
 
         virtual size_t GetWidth() const = 0;
         virtual size_t GetHeight() const = 0;
+        virtual uint32_t GetCurrentFrame() const = 0;
+        virtual uint32_t GetFramesInFlight() const = 0;
+        virtual bool HasDepthAttachment() const = 0;
 
     public:
         inline static RendererAPI* s_Instance;
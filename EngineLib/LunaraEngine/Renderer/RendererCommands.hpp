@@ -5,6 +5,8 @@
 #include <span>
 #include <memory>
 #include <utility>
+#include <limits>
+#include <algorithm>
 #include <LunaraEngine/Core/Log.h>
 #include <LunaraEngine/Renderer/Shader.hpp>
 
@@ -40,6 +42,8 @@ namespace LunaraEngine
         BeginFrame,
         Present,
         DrawQuadBatch,
+        Dispatch,
+        FillBuffer,
         Count
     };
 
@@ -206,8 +210,9 @@ namespace LunaraEngine
         template <typename Ty = uint8_t>
         using BufferView = std::span<Ty>;
 
+        // destination buffer, source elements, element offset of the range in both buffers, shader binding
         template <typename Ty = uint8_t>
-        using BufferUpload = std::tuple<StorageBuffer<Ty>*, BufferView<Ty>>;
+        using BufferUpload = std::tuple<StorageBuffer<Ty>*, BufferView<Ty>, size_t, ShaderBinding>;
 
 
         BaseBufferUploadList() = default;
@@ -217,24 +222,38 @@ namespace LunaraEngine
 
     public:
         template <std::ranges::range Container, typename V = void>
-        BaseBufferUploadList& Add(V* dstBuffer, const Container& srcBuffer)
+        BaseBufferUploadList& Add(V* dstBuffer, const Container& srcBuffer, ShaderBinding binding = {})
+        {
+            return Add<Container>(dstBuffer, srcBuffer, 0, srcBuffer.size(), binding);
+        }
+
+        template <std::ranges::range Container, typename V = void>
+        BaseBufferUploadList& Add(V* dstBuffer, const Container& srcBuffer, size_t offset, size_t count,
+                                  ShaderBinding binding = {})
         {
             using U = std::ranges::range_value_t<Container>;
             static_assert(std::is_trivially_copyable_v<U>);
 
-            list.emplace_back((StorageBuffer<T>*) dstBuffer, BufferView<T>((T*) srcBuffer.data(), srcBuffer.size()));
+            offset = std::min(offset, (size_t) srcBuffer.size());
+            count = std::min(count, srcBuffer.size() - offset);
+            list.emplace_back((StorageBuffer<T>*) dstBuffer, BufferView<T>((T*) (srcBuffer.data() + offset), count),
+                              offset, binding);
             return *this;
         }
 
         template <typename U, typename V = void>
 
         requires std::is_trivially_copyable_v<U>
-        BaseBufferUploadList& Add(V* dstBuffer, U* srcBuffer, size_t length)
+        BaseBufferUploadList& Add(V* dstBuffer, U* srcBuffer, size_t length, ShaderBinding binding = {})
         {
-            list.emplace_back((StorageBuffer<T>*) dstBuffer, BufferView<T>((T*) srcBuffer, length));
+            list.emplace_back((StorageBuffer<T>*) dstBuffer, BufferView<T>((T*) srcBuffer, length), 0, binding);
             return *this;
         }
 
+        void SetShader(std::weak_ptr<Shader> shader) { m_Shader = shader; }
+
+        [[nodiscard]] const std::weak_ptr<Shader>& GetShader() const { return m_Shader; }
+
     public:
         auto begin() { return list.begin(); }
 
@@ -246,19 +265,28 @@ namespace LunaraEngine
 
     protected:
         std::vector<BufferUpload<T>> list;
+        std::weak_ptr<Shader> m_Shader;
     };
 
     template <typename T = uint8_t>
     class BaseBufferUploadListBuilder
     {
     public:
-        BaseBufferUploadListBuilder(std::weak_ptr<Shader> shader) : m_Shader(shader) {}
+        BaseBufferUploadListBuilder(std::weak_ptr<Shader> shader) : m_Shader(shader) { m_List.SetShader(shader); }
 
         ~BaseBufferUploadListBuilder() = default;
 
     public:
         BaseBufferUploadList<T>& Get() { return m_List; }
 
+        // Limits the following container uploads to the elements [offset, offset + count)
+        BaseBufferUploadListBuilder& SetRange(size_t offset, size_t count)
+        {
+            m_RangeOffset = offset;
+            m_RangeCount = count;
+            return *this;
+        }
+
     public:
         template <typename ValueType>
         requires(std::is_trivially_copyable_v<ValueType>)
@@ -273,7 +301,7 @@ namespace LunaraEngine
             auto shader = m_Shader.lock();
 
             auto* buffer = shader->GetBuffer(m_LastBinding);
-            m_List.template Add<ValueType>(buffer, srcBuffer, length);
+            m_List.template Add<ValueType>(buffer, srcBuffer, length, m_LastBinding);
             m_LastBinding = (ShaderBinding) ((size_t) m_LastBinding + 1);
             return *this;
         }
@@ -291,7 +319,7 @@ namespace LunaraEngine
             auto shader = m_Shader.lock();
 
             auto* buffer = shader->GetBuffer(m_LastBinding);
-            m_List.template Add<Container>(buffer, srcBuffer);
+            m_List.template Add<Container>(buffer, srcBuffer, m_RangeOffset, m_RangeCount, m_LastBinding);
             m_LastBinding = (ShaderBinding) ((size_t) m_LastBinding + 1);
             return *this;
         }
@@ -304,8 +332,40 @@ namespace LunaraEngine
             return *this;
         }
 
+        // Uploads several disjoint ranges of each container to the same binding
+        template <std::ranges::range... Containers>
+        requires((std::is_trivially_copyable_v<std::ranges::range_value_t<Containers>> && ...))
+        BaseBufferUploadListBuilder& AddRanges(std::span<const UploadRange> ranges, const Containers&... srcBuffers)
+        {
+            (AddRanges(ranges, srcBuffers), ...);
+            return *this;
+        }
+
+        template <std::ranges::range Container>
+        requires(std::is_trivially_copyable_v<std::ranges::range_value_t<Container>>)
+        BaseBufferUploadListBuilder& AddRanges(std::span<const UploadRange> ranges, const Container& srcBuffer)
+        {
+            if (m_Shader.expired())
+            {
+                LOG_ERROR("Shader is expired");
+                return *this;
+            }
+
+            auto shader = m_Shader.lock();
+
+            auto* buffer = shader->GetBuffer(m_LastBinding);
+            for (const auto& range: ranges)
+            {
+                m_List.template Add<Container>(buffer, srcBuffer, range.offset, range.count, m_LastBinding);
+            }
+            m_LastBinding = (ShaderBinding) ((size_t) m_LastBinding + 1);
+            return *this;
+        }
+
     private:
         ShaderBinding m_LastBinding{ShaderBinding::_1};
+        size_t m_RangeOffset{};
+        size_t m_RangeCount{std::numeric_limits<size_t>::max()};
         std::weak_ptr<Shader> m_Shader;
         BaseBufferUploadList<T> m_List;
     };
@@ -332,6 +392,47 @@ namespace LunaraEngine
         BaseBufferUploadList<> uploadList;
         size_t count{};
         size_t offset{};
+        // When set the instance count is read from a VkDrawIndirectCommand in this binding of the shader
+        bool indirect{};
+        ShaderBinding indirectBinding{};
+    };
+
+    class RendererCommandDispatch: public RendererCommand
+    {
+    public:
+        RendererCommandDispatch() = default;
+
+        RendererCommandDispatch(Shader* shader, uint32_t groupCountX, uint32_t groupCountY = 1,
+                                uint32_t groupCountZ = 1)
+            : shader(shader), groupCountX(groupCountX), groupCountY(groupCountY), groupCountZ(groupCountZ)
+        {}
+
+        virtual RendererCommandType GetType() const override { return RendererCommandType::Dispatch; }
+
+    public:
+        Shader* shader{};
+        uint32_t groupCountX{};
+        uint32_t groupCountY{};
+        uint32_t groupCountZ{};
+    };
+
+    class RendererCommandFillBuffer: public RendererCommand
+    {
+    public:
+        RendererCommandFillBuffer() = default;
+
+        RendererCommandFillBuffer(Shader* shader, ShaderBinding binding, size_t offset, size_t size, uint32_t value)
+            : shader(shader), binding(binding), offset(offset), size(size), value(value)
+        {}
+
+        virtual RendererCommandType GetType() const override { return RendererCommandType::FillBuffer; }
+
+    public:
+        Shader* shader{};
+        ShaderBinding binding{};
+        size_t offset{};
+        size_t size{};
+        uint32_t value{};
     };
 
     class RendererCommandDrawTexture: public RendererCommand
@@ -402,8 +503,9 @@ namespace LunaraEngine
         RegisterCommand<RendererCommandDrawIndexed>(RendererCommandType::DrawIndexed, "RendererCommand::DrawIndexed");
         RegisterCommand<RendererCommandDrawInstanced>(
                 RendererCommandType::DrawInstanced, "RendererCommand::DrawInstanced");
-        RegisterCommand<RendererCommandDrawInstanced>(
-                RendererCommandType::DrawQuadBatch, "RendererCommand::DrawQuadBatch");
+        RegisterCommand<RendererCommandDrawBatch>(RendererCommandType::DrawQuadBatch, "RendererCommand::DrawQuadBatch");
+        RegisterCommand<RendererCommandDispatch>(RendererCommandType::Dispatch, "RendererCommand::Dispatch");
+        RegisterCommand<RendererCommandFillBuffer>(RendererCommandType::FillBuffer, "RendererCommand::FillBuffer");
     }
 
     template <typename T, std::enable_if_t<std::is_base_of_v<RendererCommand, T> && !std::is_same_v<T, void>, int>>
@@ -362,6 +362,12 @@ namespace LunaraEngine
         return *this;
     }
 
+    ShaderInfoBuilder& ShaderInfoBuilder::SetVertexName(std::filesystem::path name)
+    {
+        m_Info.vertexName = name.wstring();
+        return *this;
+    }
+
     ShaderInfoBuilder& ShaderInfoBuilder::SetPath(std::filesystem::path path)
     {
         m_Info.path = path;
@@ -374,6 +380,12 @@ namespace LunaraEngine
         return *this;
     }
 
+    ShaderInfoBuilder& ShaderInfoBuilder::SetDepthTest(DepthTest depthTest)
+    {
+        m_Info.depthTest = depthTest;
+        return *this;
+    }
+
     ShaderInfoBuilder& ShaderInfoBuilder::AddVertexInputResource(
             std::vector<std::pair<std::string_view, BufferResourceAttributeType>>&& resources)
     {
@@ -486,6 +498,12 @@ namespace LunaraEngine
         return *this;
     }
 
+    BufferResourceBuilder& BufferResourceBuilder::SetUsage(BufferResourceUsage usage)
+    {
+        m_Resource.usage = usage;
+        return *this;
+    }
+
     BufferResourceBuilder& BufferResourceBuilder::AddAttribute(std::string_view name, BufferResourceAttributeType type)
     {
         m_Resource.attributes.push_back(BufferResourceAttribute{.name = name, .type = type});
@@ -34,6 +34,9 @@ namespace LunaraEngine
         virtual void SetUniform(std::string_view name, const glm::ivec4& value) = 0;
         virtual void* GetBuffer(ShaderBinding binding) = 0;
         virtual void* GetTexture(ShaderBinding binding) = 0;
+        virtual const std::vector<uint32_t>& GetBindlessTextureSlots() const = 0;
+        virtual uint32_t GetFallbackTextureSlot() const = 0;
+        virtual bool ShareBuffer(ShaderBinding binding, Shader* source, ShaderBinding sourceBinding) = 0;
 
     public:
         static size_t GetInputResourceSize(const ShaderInputResource& resource);
@@ -65,6 +68,7 @@ namespace LunaraEngine
         BufferResourceBuilder&
         AddAttributes(std::vector<std::pair<std::string_view, BufferResourceAttributeType>>&& attributes);
         BufferResourceBuilder& SetBinding(ShaderBinding binding);
+        BufferResourceBuilder& SetUsage(BufferResourceUsage usage);
         BufferResource Build();
 
     private:
@@ -173,8 +177,11 @@ namespace LunaraEngine
 
     public:
         ShaderInfoBuilder& SetName(std::filesystem::path name);
+        // Lets shaders that only differ in the fragment stage share one vertex source
+        ShaderInfoBuilder& SetVertexName(std::filesystem::path name);
         ShaderInfoBuilder& SetPath(std::filesystem::path path);
         ShaderInfoBuilder& UseAsComputeShader();
+        ShaderInfoBuilder& SetDepthTest(DepthTest depthTest);
         ShaderInfoBuilder&
         AddVertexInputResource(std::vector<std::pair<std::string_view, BufferResourceAttributeType>>&& resources);
         ShaderInfoBuilder& AddVertexInputResource(const ShaderInputResource& resource);
@@ -0,0 +1,243 @@
+#include "TileMap.hpp"
+#include <LunaraEngine/Core/Log.h>
+#include <LunaraEngine/Renderer/BatchRenderer.hpp>
+#include <LunaraEngine/Renderer/Camera.hpp>
+#include <LunaraEngine/Renderer/Renderer.hpp>
+#include <LunaraEngine/Renderer/RendererCommands.hpp>
+#include <LunaraEngine/Renderer/Shader.hpp>
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <span>
+
+namespace LunaraEngine
+{
+    TileMap::TileMap(const ApplicationConfig& config, std::vector<std::wstring_view> tileTextures, uint32_t width,
+                     uint32_t height, float tileSize, uint32_t layerCount, const glm::vec3& origin)
+    {
+        Create(config, tileTextures, width, height, tileSize, layerCount, origin);
+    }
+
+    void TileMap::Create(const ApplicationConfig& config, std::vector<std::wstring_view> tileTextures, uint32_t width,
+                         uint32_t height, float tileSize, uint32_t layerCount, const glm::vec3& origin)
+    {
+        m_Width = width;
+        m_Height = height;
+        m_LayerCount = layerCount;
+        m_TileSize = tileSize;
+        m_Origin = origin;
+        m_ChunksX = (width + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        m_ChunksY = (height + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+        size_t chunkCount = (size_t) m_ChunksX * m_ChunksY * m_LayerCount;
+        size_t instanceCount = chunkCount * CHUNK_TILES;
+
+        m_Tiles.assign(instanceCount, EMPTY_TILE);
+        m_Positions.resize(instanceCount);
+        m_Sizes.assign(instanceCount, glm::vec2(0.0f));
+        m_TextureIndices.assign(instanceCount, 0);
+        m_Animations.assign(instanceCount, SpriteAnimation{});
+
+        // Positions never change, tiles outside the map keep a zero size and draw nothing
+        for (uint32_t layer = 0; layer < m_LayerCount; layer++)
+        {
+            for (uint32_t chunkY = 0; chunkY < m_ChunksY; chunkY++)
+            {
+                for (uint32_t chunkX = 0; chunkX < m_ChunksX; chunkX++)
+                {
+                    size_t base = GetChunkIndex(layer, chunkX, chunkY) * CHUNK_TILES;
+                    for (uint32_t i = 0; i < CHUNK_TILES; i++)
+                    {
+                        float x = (float) (chunkX * CHUNK_SIZE + i % CHUNK_SIZE) * m_TileSize;
+                        float y = (float) (chunkY * CHUNK_SIZE + i / CHUNK_SIZE) * m_TileSize;
+                        m_Positions[base + i] = glm::vec4{m_Origin + glm::vec3{x, y, 0.0f}, 0.0f};
+                    }
+                }
+            }
+        }
+
+        m_Shader = BatchRenderer::CreateQuadShader(config, tileTextures, instanceCount, BufferResourceUsage::Static);
+        m_TextureSlots = m_Shader->GetBindlessTextureSlots();
+        m_FallbackTextureSlot = m_Shader->GetFallbackTextureSlot();
+
+        uint32_t framesInFlight = Renderer::GetFramesInFlight();
+        assert(framesInFlight <= 32);
+        m_AllFramesMask = framesInFlight >= 32 ? ~0u : (1u << framesInFlight) - 1u;
+        m_AnimationFramesPending = m_AllFramesMask;
+
+        // Device local buffers start out undefined so every chunk is uploaded once
+        m_ChunkDirtyFrames.assign(chunkCount, 0);
+        m_DirtyChunks.clear();
+        for (size_t chunk = 0; chunk < chunkCount; chunk++) { MarkChunkDirty(chunk); }
+    }
+
+    void TileMap::Destroy()
+    {
+        m_Shader.reset();
+        m_Tiles.clear();
+        m_Positions.clear();
+        m_Sizes.clear();
+        m_TextureIndices.clear();
+        m_Animations.clear();
+        m_ChunkDirtyFrames.clear();
+        m_DirtyChunks.clear();
+    }
+
+    size_t TileMap::GetChunkIndex(uint32_t layer, uint32_t chunkX, uint32_t chunkY) const
+    {
+        return ((size_t) layer * m_ChunksY + chunkY) * m_ChunksX + chunkX;
+    }
+
+    size_t TileMap::GetTileIndex(uint32_t layer, uint32_t x, uint32_t y) const
+    {
+        return GetChunkIndex(layer, x / CHUNK_SIZE, y / CHUNK_SIZE) * CHUNK_TILES + (y % CHUNK_SIZE) * CHUNK_SIZE +
+               x % CHUNK_SIZE;
+    }
+
+    void TileMap::SetTile(uint32_t layer, uint32_t x, uint32_t y, TileId tile)
+    {
+        if (layer >= m_LayerCount || x >= m_Width || y >= m_Height) { return; }
+
+        size_t index = GetTileIndex(layer, x, y);
+        if (m_Tiles[index] == tile) { return; }
+
+        WriteTile(index, tile);
+        MarkChunkDirty(index / CHUNK_TILES);
+    }
+
+    TileId TileMap::GetTile(uint32_t layer, uint32_t x, uint32_t y) const
+    {
+        if (layer >= m_LayerCount || x >= m_Width || y >= m_Height) { return EMPTY_TILE; }
+        return m_Tiles[GetTileIndex(layer, x, y)];
+    }
+
+    void TileMap::Fill(uint32_t layer, TileId tile)
+    {
+        if (layer >= m_LayerCount) { return; }
+
+        for (uint32_t y = 0; y < m_Height; y++)
+        {
+            for (uint32_t x = 0; x < m_Width; x++) { WriteTile(GetTileIndex(layer, x, y), tile); }
+        }
+        for (uint32_t chunk = 0; chunk < m_ChunksX * m_ChunksY; chunk++)
+        {
+            MarkChunkDirty(GetChunkIndex(layer, 0, 0) + chunk);
+        }
+    }
+
+    void TileMap::WriteTile(size_t index, TileId tile)
+    {
+        m_Tiles[index] = tile;
+        if (tile == EMPTY_TILE)
+        {
+            m_Sizes[index] = glm::vec2(0.0f);
+            return;
+        }
+
+        uint32_t textureIndex = (uint32_t) tile - 1;
+        m_Sizes[index] = glm::vec2(m_TileSize);
+        if (textureIndex < m_TextureSlots.size())
+        {
+            m_TextureIndices[index] = m_TextureSlots[textureIndex];
+            return;
+        }
+
+        // Same as the batch renderer, a raw index would sample another shader's texture or an unwritten slot
+        if (!m_UnknownTileLogged)
+        {
+            LOG_WARNING("Tile %u has no texture, drawing the fallback texture instead", (uint32_t) tile);
+            m_UnknownTileLogged = true;
+        }
+        m_TextureIndices[index] = m_FallbackTextureSlot;
+    }
+
+    void TileMap::MarkChunkDirty(size_t chunk)
+    {
+        if (m_ChunkDirtyFrames[chunk] == 0) { m_DirtyChunks.push_back((uint32_t) chunk); }
+        m_ChunkDirtyFrames[chunk] = m_AllFramesMask;
+    }
+
+    void TileMap::CollectDirtyChunks(uint32_t frame)
+    {
+        m_UploadRanges.clear();
+
+        uint32_t frameBit = 1u << frame;
+        std::ranges::sort(m_DirtyChunks);
+        for (auto chunk: m_DirtyChunks)
+        {
+            if ((m_ChunkDirtyFrames[chunk] & frameBit) == 0) { continue; }
+            m_ChunkDirtyFrames[chunk] &= ~frameBit;
+
+            // Neighbouring chunks are contiguous in the buffers and upload as one range
+            size_t offset = (size_t) chunk * CHUNK_TILES;
+            if (!m_UploadRanges.empty() && m_UploadRanges.back().offset + m_UploadRanges.back().count == offset)
+            {
+                m_UploadRanges.back().count += CHUNK_TILES;
+            }
+            else { m_UploadRanges.push_back(UploadRange{offset, CHUNK_TILES}); }
+        }
+
+        std::erase_if(m_DirtyChunks, [this](uint32_t chunk) { return m_ChunkDirtyFrames[chunk] == 0; });
+    }
+
+    std::vector<RendererCommandDrawBatch*> TileMap::CreateDrawCommands(const Camera& camera)
+    {
+        std::vector<RendererCommandDrawBatch*> commands;
+        if (m_Shader == nullptr || m_ChunksX == 0 || m_ChunksY == 0) { return commands; }
+
+        // Find the chunk columns and rows overlapping the visible rect
+        FRect rect = camera.GetVisibleRect();
+        float chunkExtent = m_TileSize * (float) CHUNK_SIZE;
+        float firstX = std::floor((rect.x - m_Origin.x) / chunkExtent);
+        float firstY = std::floor((rect.y - m_Origin.y) / chunkExtent);
+        float lastX = std::floor((rect.x + rect.w - m_Origin.x) / chunkExtent);
+        float lastY = std::floor((rect.y + rect.h - m_Origin.y) / chunkExtent);
+        if (lastX < 0.0f || lastY < 0.0f || firstX >= (float) m_ChunksX || firstY >= (float) m_ChunksY)
+        {
+            return commands;
+        }
+
+        uint32_t chunkX0 = (uint32_t) std::max(firstX, 0.0f);
+        uint32_t chunkY0 = (uint32_t) std::max(firstY, 0.0f);
+        uint32_t chunkX1 = std::min((uint32_t) lastX, m_ChunksX - 1);
+        uint32_t chunkY1 = std::min((uint32_t) lastY, m_ChunksY - 1);
+
+        // Pending chunk uploads ride along with the first draw of the frame
+        uint32_t frame = Renderer::GetCurrentFrame();
+        CollectDirtyChunks(frame);
+
+        // The shader only reads the time uniform for animated quads, tiles keep a frame count of zero
+        UploadRange allTiles{0, m_Animations.size()};
+        std::span<const UploadRange> animationRanges;
+        if (m_AnimationFramesPending & (1u << frame))
+        {
+            m_AnimationFramesPending &= ~(1u << frame);
+            animationRanges = {&allTiles, 1};
+        }
+
+        BufferUploadListBuilder uploadListBuilder(m_Shader);
+        uploadListBuilder.AddRanges(m_UploadRanges, m_Positions, m_Sizes, m_TextureIndices)
+                .AddRanges(animationRanges, m_Animations);
+
+        // Visible chunks of one row are adjacent in the buffers so each row is a single draw
+        size_t instanceCount = (size_t) (chunkX1 - chunkX0 + 1) * CHUNK_TILES;
+        for (uint32_t layer = 0; layer < m_LayerCount; layer++)
+        {
+            for (uint32_t chunkY = chunkY0; chunkY <= chunkY1; chunkY++)
+            {
+                size_t offset = GetChunkIndex(layer, chunkX0, chunkY) * CHUNK_TILES;
+                if (commands.empty())
+                {
+                    commands.push_back(new RendererCommandDrawBatch(uploadListBuilder.Get(), instanceCount, offset));
+                    continue;
+                }
+                BaseBufferUploadList<> emptyList;
+                emptyList.SetShader(m_Shader);
+                commands.push_back(new RendererCommandDrawBatch(std::move(emptyList), instanceCount, offset));
+            }
+        }
+        return commands;
+    }
+
+    std::weak_ptr<Shader> TileMap::GetShader() { return m_Shader; }
+}// namespace LunaraEngine
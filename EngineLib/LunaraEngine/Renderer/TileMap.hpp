@@ -0,0 +1,93 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <memory>
+#include <string_view>
+
+#include <glm/glm.hpp>
+#include <LunaraEngine/Core/CommonTypes.hpp>
+#include <LunaraEngine/Renderer/CommonTypes.hpp>
+#include <LunaraEngine/Renderer/QuadInstance.hpp>
+
+namespace LunaraEngine
+{
+    class Shader;
+    class Camera;
+    class RendererCommandDrawBatch;
+
+    // Tile id 0 is empty, any other id selects the texture at index id - 1
+    using TileId = uint16_t;
+
+    class TileMap
+    {
+    public:
+        TileMap() = default;
+        TileMap(const ApplicationConfig& config, std::vector<std::wstring_view> tileTextures, uint32_t width,
+                uint32_t height, float tileSize, uint32_t layerCount = 1, const glm::vec3& origin = glm::vec3(0.0f));
+        ~TileMap() = default;
+
+    public:
+        void Create(const ApplicationConfig& config, std::vector<std::wstring_view> tileTextures, uint32_t width,
+                    uint32_t height, float tileSize, uint32_t layerCount = 1,
+                    const glm::vec3& origin = glm::vec3(0.0f));
+        void Destroy();
+
+    public:
+        void SetTile(uint32_t layer, uint32_t x, uint32_t y, TileId tile);
+        [[nodiscard]] TileId GetTile(uint32_t layer, uint32_t x, uint32_t y) const;
+        void Fill(uint32_t layer, TileId tile);
+        std::vector<RendererCommandDrawBatch*> CreateDrawCommands(const Camera& camera);
+        std::weak_ptr<Shader> GetShader();
+
+        // clang-format off
+
+        [[nodiscard]] auto GetWidth() const { return m_Width; }
+        [[nodiscard]] auto GetHeight() const { return m_Height; }
+        [[nodiscard]] auto GetLayerCount() const { return m_LayerCount; }
+        [[nodiscard]] auto GetTileSize() const { return m_TileSize; }
+        [[nodiscard]] auto GetOrigin() const { return m_Origin; }
+
+        // clang-format on
+
+    public:
+        static constexpr uint32_t CHUNK_SIZE = 32;
+        static constexpr uint32_t CHUNK_TILES = CHUNK_SIZE * CHUNK_SIZE;
+        static constexpr TileId EMPTY_TILE = 0;
+
+    private:
+        [[nodiscard]] size_t GetChunkIndex(uint32_t layer, uint32_t chunkX, uint32_t chunkY) const;
+        [[nodiscard]] size_t GetTileIndex(uint32_t layer, uint32_t x, uint32_t y) const;
+        void WriteTile(size_t index, TileId tile);
+        void MarkChunkDirty(size_t chunk);
+        void CollectDirtyChunks(uint32_t frame);
+
+    private:
+        uint32_t m_Width{};
+        uint32_t m_Height{};
+        uint32_t m_LayerCount{};
+        uint32_t m_ChunksX{};
+        uint32_t m_ChunksY{};
+        float m_TileSize{};
+        glm::vec3 m_Origin{};
+
+        // Tiles and instance data share the chunk major layout, each chunk owns CHUNK_TILES consecutive instances
+        std::vector<TileId> m_Tiles;
+        std::vector<glm::vec4> m_Positions;
+        std::vector<SpriteAnimation> m_Animations;
+        std::vector<glm::vec2> m_Sizes;
+        std::vector<uint32_t> m_TextureIndices;
+        std::vector<uint32_t> m_TextureSlots;
+        uint32_t m_FallbackTextureSlot{};
+        bool m_UnknownTileLogged{};
+
+        // Bit per frame in flight that still has to receive the chunk
+        std::vector<uint32_t> m_ChunkDirtyFrames;
+        std::vector<uint32_t> m_DirtyChunks;
+        std::vector<UploadRange> m_UploadRanges;
+        uint32_t m_AllFramesMask{};
+        // Tiles never animate, each frame's buffer receives the zeroed animation records once
+        uint32_t m_AnimationFramesPending{};
+
+        std::shared_ptr<Shader> m_Shader;
+    };
+}// namespace LunaraEngine
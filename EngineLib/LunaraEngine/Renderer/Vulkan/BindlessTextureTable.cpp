@@ -0,0 +1,161 @@
+#include "BindlessTextureTable.hpp"
+#include <LunaraEngine/Renderer/Vulkan/Buffer/TextureBuffer.hpp>
+#include <LunaraEngine/Renderer/Vulkan/VulkanDataTypes.hpp>
+#include <LunaraEngine/Core/Log.h>
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+namespace LunaraEngine
+{
+    BindlessTextureTable::BindlessTextureTable(VkDevice device, VkPhysicalDevice physicalDevice) : m_Device(device)
+    {
+        m_Capacity = QueryCapacity(physicalDevice);
+        m_Layout = CreateDescriptorSetLayout(m_Device, m_Capacity);
+
+        VkDescriptorPoolSize poolSize{};
+        poolSize.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        poolSize.descriptorCount = m_Capacity;
+
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+        poolInfo.maxSets = 1;
+        poolInfo.poolSizeCount = 1;
+        poolInfo.pPoolSizes = &poolSize;
+
+        if (vkCreateDescriptorPool(m_Device, &poolInfo, nullptr, &m_DescriptorPool) != VK_SUCCESS)
+        {
+            throw std::runtime_error("failed to create bindless descriptor pool!");
+        }
+
+        VkDescriptorSetAllocateInfo allocateInfo{};
+        allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+        allocateInfo.descriptorPool = m_DescriptorPool;
+        allocateInfo.descriptorSetCount = 1;
+        allocateInfo.pSetLayouts = &m_Layout;
+
+        if (vkAllocateDescriptorSets(m_Device, &allocateInfo, &m_DescriptorSet) != VK_SUCCESS)
+        {
+            throw std::runtime_error("failed to allocate bindless descriptor set!");
+        }
+
+        // Hand out the lowest slots first
+        m_FreeSlots.resize(m_Capacity);
+        for (uint32_t i = 0; i < m_Capacity; i++) { m_FreeSlots[i] = m_Capacity - 1 - i; }
+
+        LOG_INFO("Bindless texture table created with %u slots", m_Capacity);
+    }
+
+    BindlessTextureTable::~BindlessTextureTable()
+    {
+        delete m_FallbackTexture;
+        if (m_DescriptorPool != VK_NULL_HANDLE) { vkDestroyDescriptorPool(m_Device, m_DescriptorPool, nullptr); }
+        if (m_Layout != VK_NULL_HANDLE) { vkDestroyDescriptorSetLayout(m_Device, m_Layout, nullptr); }
+    }
+
+    auto BindlessTextureTable::Register(VkImageView view, VkSampler sampler) -> std::expected<uint32_t, std::string>
+    {
+        if (m_FreeSlots.empty()) { return std::unexpected("Bindless texture table is full!"); }
+
+        uint32_t slot = m_FreeSlots.back();
+        m_FreeSlots.pop_back();
+
+        VkDescriptorImageInfo imageInfo{
+                .sampler = sampler, .imageView = view, .imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
+
+        VkWriteDescriptorSet descriptorWrite{};
+        descriptorWrite.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+        descriptorWrite.dstSet = m_DescriptorSet;
+        descriptorWrite.dstBinding = BINDING;
+        descriptorWrite.dstArrayElement = slot;
+        descriptorWrite.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        descriptorWrite.descriptorCount = 1;
+        descriptorWrite.pImageInfo = &imageInfo;
+
+        // The binding is UPDATE_AFTER_BIND so the set may already be bound in a pending command buffer
+        vkUpdateDescriptorSets(m_Device, 1, &descriptorWrite, 0, nullptr);
+
+        return slot;
+    }
+
+    void BindlessTextureTable::CreateFallbackTexture(RendererDataType* rendererData)
+    {
+        assert(m_FallbackTexture == nullptr);
+
+        // A single magenta texel, a missing texture stands out instead of showing another shader's texture
+        uint32_t texel = FALLBACK_COLOR;
+        TextureDataView dataView{.data = (uint8_t*) &texel, .size = sizeof(texel)};
+        TextureInfo textureInfo{.name = L"Fallback",
+                                .width = 1,
+                                .height = 1,
+                                .format = TextureFormat::RGBA,
+                                .type = TextureDataType::Int};
+        m_FallbackTexture = new VulkanTextureBuffer(rendererData, rendererData->gfxQueue, textureInfo, &dataView);
+
+        auto slot = Register(m_FallbackTexture->GetView(), m_FallbackTexture->GetSampler());
+        if (!slot.has_value())
+        {
+            LOG_ERROR("%s", slot.error().c_str());
+            throw std::runtime_error("failed to register fallback texture!");
+        }
+        m_FallbackSlot = *slot;
+    }
+
+    void BindlessTextureTable::Release(uint32_t slot)
+    {
+        assert(slot < m_Capacity && (m_FallbackTexture == nullptr || slot != m_FallbackSlot));
+        assert(std::ranges::find(m_FreeSlots, slot) == m_FreeSlots.end());
+
+        // The binding is PARTIALLY_BOUND, the stale descriptor is fine as long as no shader indexes it anymore
+        m_FreeSlots.push_back(slot);
+    }
+
+    VkDescriptorSetLayout BindlessTextureTable::CreateDescriptorSetLayout(VkDevice device, uint32_t capacity)
+    {
+        VkDescriptorSetLayoutBinding binding{};
+        binding.binding = BINDING;
+        binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+        binding.descriptorCount = capacity;
+        binding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+        binding.pImmutableSamplers = nullptr;
+
+        VkDescriptorBindingFlags bindingFlags =
+                VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT;
+
+        VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo{};
+        bindingFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+        bindingFlagsInfo.bindingCount = 1;
+        bindingFlagsInfo.pBindingFlags = &bindingFlags;
+
+        VkDescriptorSetLayoutCreateInfo layoutInfo{};
+        layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+        layoutInfo.pNext = &bindingFlagsInfo;
+        layoutInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+        layoutInfo.bindingCount = 1;
+        layoutInfo.pBindings = &binding;
+
+        VkDescriptorSetLayout layout{};
+        if (vkCreateDescriptorSetLayout(device, &layoutInfo, nullptr, &layout) != VK_SUCCESS)
+        {
+            throw std::runtime_error("failed to create bindless descriptor set layout!");
+        }
+        return layout;
+    }
+
+    uint32_t BindlessTextureTable::QueryCapacity(VkPhysicalDevice physicalDevice)
+    {
+        VkPhysicalDeviceDescriptorIndexingProperties indexingProperties{};
+        indexingProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES;
+
+        VkPhysicalDeviceProperties2 properties{};
+        properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        properties.pNext = &indexingProperties;
+        vkGetPhysicalDeviceProperties2(physicalDevice, &properties);
+
+        return std::min({MAX_TEXTURES, indexingProperties.maxDescriptorSetUpdateAfterBindSampledImages,
+                         indexingProperties.maxDescriptorSetUpdateAfterBindSamplers,
+                         indexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+                         indexingProperties.maxPerStageDescriptorUpdateAfterBindSamplers});
+    }
+}// namespace LunaraEngine
@@ -0,0 +1,56 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <expected>
+
+namespace LunaraEngine
+{
+    struct RendererDataType;
+    class VulkanTextureBuffer;
+
+    class BindlessTextureTable
+    {
+    public:
+        BindlessTextureTable(VkDevice device, VkPhysicalDevice physicalDevice);
+        ~BindlessTextureTable();
+        BindlessTextureTable(const BindlessTextureTable& other) = delete;
+        BindlessTextureTable& operator=(const BindlessTextureTable&) = delete;
+
+    public:
+        [[nodiscard]] auto Register(VkImageView view, VkSampler sampler) -> std::expected<uint32_t, std::string>;
+        void Release(uint32_t slot);
+        // Unknown texture indices are drawn with this texture instead of sampling an unwritten slot
+        void CreateFallbackTexture(RendererDataType* rendererData);
+
+        // clang-format off
+
+        [[nodiscard]] auto GetLayout() const { return m_Layout; }
+        [[nodiscard]] auto GetDescriptorSet() const { return m_DescriptorSet; }
+        [[nodiscard]] auto GetCapacity() const { return m_Capacity; }
+        [[nodiscard]] auto GetUsedSlotCount() const { return m_Capacity - (uint32_t) m_FreeSlots.size(); }
+        [[nodiscard]] auto GetFallbackSlot() const { return m_FallbackSlot; }
+
+        // clang-format on
+
+    public:
+        static VkDescriptorSetLayout CreateDescriptorSetLayout(VkDevice device, uint32_t capacity);
+        static uint32_t QueryCapacity(VkPhysicalDevice physicalDevice);
+
+    public:
+        static constexpr uint32_t MAX_TEXTURES = 4096;
+        static constexpr uint32_t BINDING = 0;
+        static constexpr uint32_t FALLBACK_COLOR = 0xffff00ff;
+
+    private:
+        VkDevice m_Device{};
+        VkDescriptorSetLayout m_Layout{};
+        VkDescriptorPool m_DescriptorPool{};
+        VkDescriptorSet m_DescriptorSet{};
+        uint32_t m_Capacity{};
+        std::vector<uint32_t> m_FreeSlots;
+        VulkanTextureBuffer* m_FallbackTexture{};
+        uint32_t m_FallbackSlot{};
+    };
+}// namespace LunaraEngine
@@ -35,6 +35,7 @@ namespace LunaraEngine
 
         void Upload(size_t offset, uint8_t* data, size_t length, size_t stride = 1);
         void Upload(uint8_t* data, size_t length, size_t stride = 1);
+        void Flush(size_t offset, size_t size);
         std::shared_ptr<CommandBuffer> BeginRecording(CommandPool* commandPool);
         void Submit(CommandBuffer* cmdBuffer, VkQueue executeQueue, VulkanFence* fence);
 
@@ -144,6 +145,8 @@ namespace LunaraEngine
         size_t m_Stride{};
         VkDeviceMemory m_BufferMemory{};
         uint8_t* m_MappedDataPtr{};
+        bool m_IsCoherent{true};
+        VkDeviceSize m_NonCoherentAtomSize{1};
         BufferResourceType m_ResourceType{};
     };
 
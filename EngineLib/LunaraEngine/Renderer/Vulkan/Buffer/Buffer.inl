@@ -32,6 +32,15 @@ namespace LunaraEngine
         assert(result == VK_SUCCESS);
         (void) result;
 
+        // Writes to non coherent memory have to be flushed explicitly in multiples of the atom size
+        m_IsCoherent = (properties & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT) != 0;
+        if (!m_IsCoherent)
+        {
+            VkPhysicalDeviceProperties deviceProperties;
+            vkGetPhysicalDeviceProperties(physicalDevice, &deviceProperties);
+            m_NonCoherentAtomSize = deviceProperties.limits.nonCoherentAtomSize;
+        }
+
         switch (m_ResourceType)
         {
             case BufferResourceType::Texture:
@@ -41,6 +50,9 @@ namespace LunaraEngine
                 result = vkBindBufferMemory(m_Device, m_Buffer, m_BufferMemory, 0);
                 assert(result == VK_SUCCESS);
 
+                // Device local memory is only reachable through transfer commands
+                if ((properties & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) == 0) { break; }
+
                 result = vkMapMemory(m_Device, m_BufferMemory, 0, m_Size * m_Stride, 0, (void**) &m_MappedDataPtr);
                 assert(result == VK_SUCCESS);
                 break;
@@ -131,6 +143,28 @@ namespace LunaraEngine
         uint8_t* newPtr = m_MappedDataPtr + offset;
         size_t size = length * stride;
         std::memcpy(newPtr, data, size);
+        Flush(offset, size);
+    }
+
+    template <BufferResourceType type>
+    void Buffer<type>::Flush(size_t offset, size_t size)
+    {
+        if (m_IsCoherent || size == 0) { return; }
+
+        const VkDeviceSize atom = m_NonCoherentAtomSize;
+        VkDeviceSize begin = (offset / atom) * atom;
+        VkDeviceSize end = ((offset + size + atom - 1) / atom) * atom;
+
+        VkMappedMemoryRange range{};
+        range.sType = VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE;
+        range.memory = m_BufferMemory;
+        range.offset = begin;
+        // The aligned end may run past the allocation, whole size covers the tail instead
+        range.size = end >= m_Size * m_Stride ? VK_WHOLE_SIZE : end - begin;
+
+        auto result = vkFlushMappedMemoryRanges(m_Device, 1, &range);
+        assert(result == VK_SUCCESS);
+        (void) result;
     }
 
     template <BufferResourceType type>
@@ -1,22 +1,46 @@
 #include "StorageBuffer.hpp"
 #include <LunaraEngine/Renderer/Vulkan/CommandPool.hpp>
+#include <LunaraEngine/Renderer/Vulkan/Synchronization.hpp>
 #include <LunaraEngine/Renderer/Vulkan/VulkanDataTypes.hpp>
 #include <cstring>
 
 namespace LunaraEngine
 {
     VulkanStorageBuffer::VulkanStorageBuffer(RendererDataType* rendererData, uint8_t* data, size_t length,
-                                             size_t stride)
+                                             size_t stride, BufferResourceUsage usage)
     {
-        Create(rendererData, data, length, stride);
+        Create(rendererData, data, length, stride, usage);
     }
 
-    void VulkanStorageBuffer::Create(RendererDataType* rendererData, uint8_t* data, size_t length, size_t stride)
+    void VulkanStorageBuffer::Create(RendererDataType* rendererData, uint8_t* data, size_t length, size_t stride,
+                                     BufferResourceUsage usage)
     {
         m_ResourceType = BufferResourceType::StorageBuffer;
         m_Device = rendererData->device;
         m_Size = length;
         m_Stride = stride;
+        m_Usage = usage;
+
+        if (IsDeviceLocal())
+        {
+            // Device local buffers can also be written by compute passes and consumed as indirect draw arguments
+            CreateBuffer(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT |
+                         VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT);
+            BindBufferToDevMemory(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, rendererData->physicalDevice);
+
+            // Persistent buffers are only written on the GPU and need no host copy
+            if (IsPersistent()) { return; }
+
+            // Static buffers are read from video memory, writes go through a persistent staging copy
+            m_StagingBuffer.Create(m_Device, rendererData->physicalDevice, nullptr, length, stride);
+            if (data != nullptr)
+            {
+                Stage(0, data, length, stride);
+                VulkanStorageBuffer* buffers[] = {this};
+                SubmitPendingCopies(rendererData, buffers);
+            }
+            return;
+        }
 
         CreateBuffer(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
         BindBufferToDevMemory(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
@@ -24,5 +48,60 @@ namespace LunaraEngine
         if (data != nullptr) { Upload(data, length, stride); }
     }
 
+    void VulkanStorageBuffer::Stage(size_t offset, uint8_t* data, size_t length, size_t stride)
+    {
+        assert(IsDeviceLocal() && !IsPersistent());
+        size_t size = length * stride;
+        if (size == 0) { return; }
+
+        m_StagingBuffer.Upload(offset, data, length, stride);
+
+        // Adjacent writes within one frame become a single copy region
+        if (!m_PendingCopies.empty() && m_PendingCopies.back().srcOffset + m_PendingCopies.back().size == offset)
+        {
+            m_PendingCopies.back().size += size;
+            return;
+        }
+        m_PendingCopies.push_back(VkBufferCopy{.srcOffset = offset, .dstOffset = offset, .size = size});
+    }
+
+    void VulkanStorageBuffer::RecordPendingCopies(VkCommandBuffer cmdBuffer)
+    {
+        if (m_PendingCopies.empty()) { return; }
+
+        vkCmdCopyBuffer(cmdBuffer, m_StagingBuffer.GetHandle(), m_Buffer, (uint32_t) m_PendingCopies.size(),
+                        m_PendingCopies.data());
+        m_PendingCopies.clear();
+    }
+
+    void VulkanStorageBuffer::RecordPendingCopies(VkCommandBuffer cmdBuffer,
+                                                  std::span<VulkanStorageBuffer* const> buffers)
+    {
+        if (buffers.empty()) { return; }
+
+        for (auto* buffer: buffers) { buffer->RecordPendingCopies(cmdBuffer); }
+
+        // Make the copies visible to every shader stage reading the buffers later in the frame
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+        vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT |
+                                     VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0, 1, &barrier, 0, nullptr, 0, nullptr);
+    }
+
+    void VulkanStorageBuffer::SubmitPendingCopies(RendererDataType* rendererData,
+                                                  std::span<VulkanStorageBuffer* const> buffers)
+    {
+        // Only used for the initial contents, later writes are recorded into the frame command buffer
+        VulkanFence fence(rendererData->device);
+        auto cmdBuffer = rendererData->commandPool->CreateImmediateCommandBuffer();
+        cmdBuffer->BeginRecording();
+        RecordPendingCopies(*cmdBuffer, buffers);
+        buffers.front()->Submit(cmdBuffer.get(), rendererData->gfxQueue, &fence);
+        fence.Destroy();
+    }
 
-}// namespace LunaraEngine
\ No newline at end of file
+}// namespace LunaraEngine
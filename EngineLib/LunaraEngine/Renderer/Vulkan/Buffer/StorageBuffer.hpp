@@ -5,6 +5,7 @@
 #include <glm/glm.hpp>
 #include <array>
 #include <vector>
+#include <span>
 
 namespace LunaraEngine
 {
@@ -16,10 +17,37 @@ namespace LunaraEngine
     {
     public:
         VulkanStorageBuffer() = default;
-        VulkanStorageBuffer(RendererDataType* rendererData, uint8_t* data, size_t length, size_t stride = 1);
+        VulkanStorageBuffer(RendererDataType* rendererData, uint8_t* data, size_t length, size_t stride = 1,
+                            BufferResourceUsage usage = BufferResourceUsage::Dynamic);
         ~VulkanStorageBuffer() = default;
 
     public:
-        void Create(RendererDataType* rendererData, uint8_t* data, size_t length, size_t stride = 1);
+        void Create(RendererDataType* rendererData, uint8_t* data, size_t length, size_t stride = 1,
+                    BufferResourceUsage usage = BufferResourceUsage::Dynamic);
+
+        [[nodiscard]] bool IsDeviceLocal() const
+        {
+            return m_Usage == BufferResourceUsage::Static || m_Usage == BufferResourceUsage::Persistent;
+        }
+
+        [[nodiscard]] bool IsPersistent() const { return m_Usage == BufferResourceUsage::Persistent; }
+
+        [[nodiscard]] bool HasPendingCopies() const { return !m_PendingCopies.empty(); }
+
+        // Writes into the staging copy, which is only reused once the frame that copies it finished on the GPU
+        void Stage(size_t offset, uint8_t* data, size_t length, size_t stride = 1);
+        void RecordPendingCopies(VkCommandBuffer cmdBuffer);
+
+    public:
+        // Records the copies of all buffers followed by one barrier, outside of a render pass
+        static void RecordPendingCopies(VkCommandBuffer cmdBuffer, std::span<VulkanStorageBuffer* const> buffers);
+
+    private:
+        static void SubmitPendingCopies(RendererDataType* rendererData, std::span<VulkanStorageBuffer* const> buffers);
+
+    private:
+        BufferResourceUsage m_Usage{BufferResourceUsage::Dynamic};
+        StagingBuffer m_StagingBuffer;
+        std::vector<VkBufferCopy> m_PendingCopies;
     };
-}// namespace LunaraEngine
\ No newline at end of file
+}// namespace LunaraEngine
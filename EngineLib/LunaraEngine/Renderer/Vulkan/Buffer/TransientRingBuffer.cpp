@@ -0,0 +1,120 @@
+#include "TransientRingBuffer.hpp"
+#include <LunaraEngine/Renderer/Vulkan/VulkanDataTypes.hpp>
+#include <LunaraEngine/Renderer/Vulkan/Shader.hpp>
+#include <LunaraEngine/Core/Log.h>
+#include <algorithm>
+#include <bit>
+
+namespace LunaraEngine
+{
+    TransientFrameBuffer::TransientFrameBuffer(RendererDataType* rendererData, size_t size)
+    {
+        Create(rendererData, size);
+    }
+
+    void TransientFrameBuffer::Create(RendererDataType* rendererData, size_t size)
+    {
+        m_ResourceType = BufferResourceType::StorageBuffer;
+        m_Device = rendererData->device;
+        m_Size = size;
+        m_Stride = 1;
+
+        CreateBuffer(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT);
+        BindBufferToDevMemory(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                              rendererData->physicalDevice);
+    }
+
+    TransientRingBuffer::TransientRingBuffer(RendererDataType* rendererData, VkDeviceSize frameCapacity)
+        : m_RendererData(rendererData)
+    {
+        VkPhysicalDeviceProperties deviceProperties;
+        vkGetPhysicalDeviceProperties(rendererData->physicalDevice, &deviceProperties);
+        m_Alignment = std::max(deviceProperties.limits.minStorageBufferOffsetAlignment,
+                               deviceProperties.limits.minUniformBufferOffsetAlignment);
+
+        m_Frames.resize(rendererData->maxFramesInFlight);
+        for (auto& frame: m_Frames) { CreateFrameBuffer(frame, frameCapacity); }
+
+        LOG_INFO("Transient ring buffer created with %llu bytes per frame", (unsigned long long) frameCapacity);
+    }
+
+    TransientRingBuffer::~TransientRingBuffer()
+    {
+        for (auto& frame: m_Frames) { delete frame.buffer; }
+        m_Frames.clear();
+    }
+
+    void TransientRingBuffer::CreateFrameBuffer(Frame& frame, VkDeviceSize capacity)
+    {
+        delete frame.buffer;
+
+        // The tail lets a dynamic binding of MAX_BINDING_RANGE start at any offset below the capacity
+        frame.buffer = new TransientFrameBuffer(m_RendererData, (size_t) (capacity + MAX_BINDING_RANGE));
+        frame.capacity = capacity;
+        frame.head = 0;
+        frame.requested = 0;
+    }
+
+    void TransientRingBuffer::Reset(uint32_t frameIndex)
+    {
+        // Called once the frame's fence has signaled, nothing on the GPU references this memory anymore
+        Frame& frame = m_Frames[frameIndex];
+        if (frame.requested > frame.capacity) { Grow(frameIndex, frame.requested); }
+        frame.head = 0;
+        frame.requested = 0;
+    }
+
+    void TransientRingBuffer::Reserve(uint32_t frameIndex, VkDeviceSize size)
+    {
+        // Recorded commands of the frame may reference the buffer once something was allocated from it
+        Frame& frame = m_Frames[frameIndex];
+        if (size > frame.capacity && frame.head == 0) { Grow(frameIndex, size); }
+    }
+
+    void TransientRingBuffer::Grow(uint32_t frameIndex, VkDeviceSize size)
+    {
+        VkDeviceSize capacity = std::bit_ceil(size);
+        LOG_WARNING("Transient ring buffer frame %u grows to %llu bytes", frameIndex, (unsigned long long) capacity);
+        CreateFrameBuffer(m_Frames[frameIndex], capacity);
+
+        // Reset and Reserve run before the frame binds any descriptor set, the sets of this frame are only
+        // referenced by command buffers that have completed
+        for (auto shader: m_Shaders) { shader->UpdateBufferDescriptorSets(frameIndex); }
+    }
+
+    auto TransientRingBuffer::Allocate(VkDeviceSize size) -> std::expected<TransientAllocation, std::string>
+    {
+        return Allocate(size, m_Alignment);
+    }
+
+    auto TransientRingBuffer::Allocate(VkDeviceSize size, VkDeviceSize alignment)
+            -> std::expected<TransientAllocation, std::string>
+    {
+        Frame& frame = m_Frames[m_RendererData->currentFrame];
+
+        // Requests are counted even when they don't fit so the next reset can grow the frame to the real demand
+        VkDeviceSize offset = (frame.head + alignment - 1) / alignment * alignment;
+        frame.requested = (frame.requested + alignment - 1) / alignment * alignment + size;
+        m_HighWaterMark = std::max(m_HighWaterMark, frame.requested);
+
+        if (offset + size > frame.capacity) { return std::unexpected("Transient ring buffer is out of memory!"); }
+
+        frame.head = offset + size;
+        return TransientAllocation{.buffer = frame.buffer->GetHandle(),
+                                   .offset = offset,
+                                   .size = size,
+                                   .data = frame.buffer->GetMappedData() + offset};
+    }
+
+    VkBuffer TransientRingBuffer::GetBuffer(uint32_t frameIndex) const
+    {
+        return m_Frames[frameIndex].buffer->GetHandle();
+    }
+
+    void TransientRingBuffer::Attach(VulkanShader* shader)
+    {
+        if (std::ranges::find(m_Shaders, shader) == m_Shaders.end()) { m_Shaders.push_back(shader); }
+    }
+
+    void TransientRingBuffer::Detach(VulkanShader* shader) { std::erase(m_Shaders, shader); }
+}// namespace LunaraEngine
@@ -0,0 +1,87 @@
+#pragma once
+#include <vulkan/vulkan.h>
+#include "Buffer.hpp"
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <expected>
+
+namespace LunaraEngine
+{
+    struct RendererDataType;
+    class VulkanShader;
+
+    struct TransientAllocation {
+        VkBuffer buffer{};
+        VkDeviceSize offset{};
+        VkDeviceSize size{};
+        uint8_t* data{};
+    };
+
+    class TransientFrameBuffer: public Buffer<BufferResourceType::Buffer>
+    {
+    public:
+        TransientFrameBuffer() = default;
+        TransientFrameBuffer(RendererDataType* rendererData, size_t size);
+        ~TransientFrameBuffer() = default;
+
+    public:
+        void Create(RendererDataType* rendererData, size_t size);
+
+        [[nodiscard]] uint8_t* GetMappedData() const { return m_MappedDataPtr; }
+    };
+
+    class TransientRingBuffer
+    {
+    public:
+        TransientRingBuffer(RendererDataType* rendererData, VkDeviceSize frameCapacity = DEFAULT_FRAME_CAPACITY);
+        ~TransientRingBuffer();
+        TransientRingBuffer(const TransientRingBuffer& other) = delete;
+        TransientRingBuffer& operator=(const TransientRingBuffer&) = delete;
+
+    public:
+        void Reset(uint32_t frameIndex);
+        // Grows the frame before its first allocation so a frame that needs more than the capacity still fits
+        void Reserve(uint32_t frameIndex, VkDeviceSize size);
+        [[nodiscard]] auto Allocate(VkDeviceSize size) -> std::expected<TransientAllocation, std::string>;
+        [[nodiscard]] auto Allocate(VkDeviceSize size, VkDeviceSize alignment)
+                -> std::expected<TransientAllocation, std::string>;
+
+        [[nodiscard]] VkBuffer GetBuffer(uint32_t frameIndex) const;
+
+        // Shaders with transient bindings, their descriptors are rewritten when a frame's buffer is replaced
+        void Attach(VulkanShader* shader);
+        void Detach(VulkanShader* shader);
+
+        // clang-format off
+
+        [[nodiscard]] auto GetCapacity(uint32_t frameIndex) const { return m_Frames[frameIndex].capacity; }
+        [[nodiscard]] auto GetUsed(uint32_t frameIndex) const { return m_Frames[frameIndex].head; }
+        [[nodiscard]] auto GetHighWaterMark() const { return m_HighWaterMark; }
+        [[nodiscard]] auto GetAlignment() const { return m_Alignment; }
+
+        // clang-format on
+
+    public:
+        static constexpr VkDeviceSize DEFAULT_FRAME_CAPACITY = 4 * 1024 * 1024;
+        static constexpr VkDeviceSize MAX_BINDING_RANGE = 1024 * 1024;
+
+    private:
+        struct Frame {
+            TransientFrameBuffer* buffer{};
+            VkDeviceSize capacity{};
+            VkDeviceSize head{};
+            VkDeviceSize requested{};
+        };
+
+        void CreateFrameBuffer(Frame& frame, VkDeviceSize capacity);
+        void Grow(uint32_t frameIndex, VkDeviceSize size);
+
+    private:
+        RendererDataType* m_RendererData{};
+        std::vector<Frame> m_Frames;
+        std::vector<VulkanShader*> m_Shaders;
+        VkDeviceSize m_Alignment{1};
+        VkDeviceSize m_HighWaterMark{};
+    };
+}// namespace LunaraEngine
@@ -48,6 +48,21 @@ namespace LunaraEngine
         return requiredExtensions.empty();
     }
 
+    bool CheckDescriptorIndexingSupport(VkPhysicalDevice device)
+    {
+        VkPhysicalDeviceVulkan12Features vulkan12Features{};
+        vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+
+        VkPhysicalDeviceFeatures2 features{};
+        features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        features.pNext = &vulkan12Features;
+        vkGetPhysicalDeviceFeatures2(device, &features);
+
+        return vulkan12Features.descriptorIndexing && vulkan12Features.shaderSampledImageArrayNonUniformIndexing &&
+               vulkan12Features.descriptorBindingSampledImageUpdateAfterBind &&
+               vulkan12Features.descriptorBindingPartiallyBound && vulkan12Features.runtimeDescriptorArray;
+    }
+
     bool IsDeviceSuitable(VkPhysicalDevice device, VkSurfaceKHR surface)
     {
         VkPhysicalDeviceProperties deviceProperties;
@@ -64,7 +79,9 @@ namespace LunaraEngine
         }
         //checks if it is a descrete gou not integrated or emulated one
         bool isDescrete = deviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU;
-        bool status = indices.isComplete() && extensionsSupported && swapChainAdequate && isDescrete;
+        bool descriptorIndexingSupported = CheckDescriptorIndexingSupport(device);
+        bool status = indices.isComplete() && extensionsSupported && swapChainAdequate && isDescrete &&
+                      descriptorIndexingSupported;
         if (status) { LOG_INFO("Device is suitable"); }
         return status;
     }
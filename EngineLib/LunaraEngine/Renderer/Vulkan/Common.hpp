@@ -8,6 +8,7 @@ namespace LunaraEngine
     QueueFamilyIndices FindQueueFamilies(VkPhysicalDevice device, VkSurfaceKHR surface);
 
     bool CheckDeviceExtensionSupport(VkPhysicalDevice device);
+    bool CheckDescriptorIndexingSupport(VkPhysicalDevice device);
 
     bool IsDeviceSuitable(VkPhysicalDevice device, VkSurfaceKHR surface);
     uint32_t FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties, VkPhysicalDevice physicalDevice);
@@ -41,9 +41,21 @@ namespace LunaraEngine
         builder.SetRasterization(PolygonMode::FILL);
         builder.SetSampling();
         builder.AddColorBlending();
+        builder.SetDepthStencil();
         builder.AddDynamicState(VK_DYNAMIC_STATE_VIEWPORT_WITH_COUNT);
         builder.AddDynamicState(VK_DYNAMIC_STATE_SCISSOR_WITH_COUNT);
 
+        AddDescriptorSets(builder, info);
+
+        auto pipelineData = builder.CreatePipeline();
+
+        p_Pipeline = pipelineData.pipeline;
+        p_Layout = pipelineData.layout;
+        for (auto& [location, layout]: pipelineData.descriptorSetLayouts) { p_DescriptorLayouts[location] = layout; }
+    }
+
+    void Pipeline::AddDescriptorSets(PipelineBuilder& builder, const ShaderInfo* info)
+    {
         // set location -> descriptor set purposetype
         std::map<uint32_t, BufferResourceType> types;
 
@@ -66,12 +78,6 @@ namespace LunaraEngine
         }
 
         for (auto& [set, type]: types) { builder.AddDescriptorSet(set, type); }
-
-        auto pipelineData = builder.CreatePipeline();
-
-        p_Pipeline = pipelineData.pipeline;
-        p_Layout = pipelineData.layout;
-        for (auto& [location, layout]: pipelineData.descriptorSetLayouts) { p_DescriptorLayouts[location] = layout; }
     }
 
     ComputePipeline::ComputePipeline(RendererDataType* rendererData, const ShaderInfo* info,
@@ -83,6 +89,8 @@ namespace LunaraEngine
         builder.SetPipelineType(PipelineType::Compute);
         builder.AddStage(ShaderStage::Compute, shaderSources.at(VK_SHADER_STAGE_COMPUTE_BIT));
 
+        AddDescriptorSets(builder, info);
+
         auto pipelineData = builder.CreatePipeline();
 
         p_Pipeline = pipelineData.pipeline;
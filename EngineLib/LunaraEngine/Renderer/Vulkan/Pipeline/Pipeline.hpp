@@ -6,12 +6,13 @@
 
 namespace LunaraEngine
 {
+    class PipelineBuilder;
 
     class Pipeline
     {
     public:
         Pipeline(VkDevice device);
-        ~Pipeline();
+        virtual ~Pipeline();
 
     public:
         VkPipeline GetPipeline() const;
@@ -19,6 +20,9 @@ namespace LunaraEngine
 
         const std::map<uint32_t, VkDescriptorSetLayout>& GetDescriptorLayouts() const;
 
+    protected:
+        void AddDescriptorSets(PipelineBuilder& builder, const ShaderInfo* info);
+
     protected:
         VkPipeline p_Pipeline = VK_NULL_HANDLE;
         VkPipelineLayout p_Layout = VK_NULL_HANDLE;
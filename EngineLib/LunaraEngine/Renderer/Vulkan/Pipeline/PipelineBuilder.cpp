@@ -1,6 +1,7 @@
 #include "PipelineBuilder.hpp"
 #include <LunaraEngine/Renderer/Vulkan/VulkanDataTypes.hpp>
 #include <LunaraEngine/Renderer/Vulkan/Shader.hpp>
+#include <LunaraEngine/Renderer/Vulkan/BindlessTextureTable.hpp>
 
 namespace LunaraEngine
 {
@@ -12,6 +13,14 @@ namespace LunaraEngine
 
     void PipelineBuilder::CreateDescriptorSetLayout(uint32_t location, BufferResourceType type)
     {
+        // Bindless sets share the renderer wide table, the layout has to match it exactly
+        if (type == BufferResourceType::Texture && IsBindlessSet(location))
+        {
+            m_DescriptorLayouts[location] = BindlessTextureTable::CreateDescriptorSetLayout(
+                    m_RendererData->device, m_RendererData->bindlessTextures->GetCapacity());
+            return;
+        }
+
         VkDescriptorSetLayoutCreateInfo layoutInfo{};
         layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
 
@@ -41,6 +50,14 @@ namespace LunaraEngine
         }
     }
 
+    bool PipelineBuilder::IsBindlessSet(uint32_t location) const
+    {
+        return std::ranges::any_of(m_Info->resources.textureResources, [location](const TextureResource& resource) {
+            return resource.layout.set == location &&
+                   resource.textureType == TextureResourceType::Texture2DBindlessArray;
+        });
+    }
+
     void PipelineBuilder::GetTextureDescriptorLayoutBindings(
             std::vector<VkDescriptorSetLayoutBinding>& descriptorSetLayoutBindings)
     {
@@ -69,7 +86,6 @@ namespace LunaraEngine
         {
             if (resource.type == BufferResourceType::PushConstant) { continue; }
 
-            const auto& type = resource.type;
             const auto& name = resource.name;
             ShaderBinding binding = resource.layout.binding;
             BufferResourceMemoryLayout layout = resource.layout.layoutType;
@@ -81,8 +97,8 @@ namespace LunaraEngine
 
             VkDescriptorSetLayoutBinding descriptorSetLayoutBinding{};
             descriptorSetLayoutBinding.binding = (uint32_t) binding;
-            descriptorSetLayoutBinding.descriptorType = GetDescriptorType(type);
-            descriptorSetLayoutBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+            descriptorSetLayoutBinding.descriptorType = GetDescriptorType(resource);
+            descriptorSetLayoutBinding.stageFlags = GetResourceStageFlags();
             descriptorSetLayoutBinding.descriptorCount = 1;
             descriptorSetLayoutBinding.pImmutableSamplers = nullptr;
             descriptorSetLayoutBindings.push_back(descriptorSetLayoutBinding);
@@ -101,12 +117,17 @@ namespace LunaraEngine
                 VkPushConstantRange range{};
                 range.offset = 0;
                 range.size = (uint32_t) resource.length * (uint32_t) resource.stride;
-                range.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+                range.stageFlags = GetResourceStageFlags();
                 m_ConstantRanges.push_back(range);
             }
         }
     }
 
+    VkShaderStageFlags PipelineBuilder::GetResourceStageFlags() const
+    {
+        return m_PipelineType == PipelineType::Compute ? VK_SHADER_STAGE_COMPUTE_BIT : VK_SHADER_STAGE_VERTEX_BIT;
+    }
+
     void PipelineBuilder::CreatePipelineLayout()
     {
         VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
@@ -269,7 +290,8 @@ namespace LunaraEngine
         VkPipelineColorBlendAttachmentState& colorBlendAttachment = m_BlendAttachments.back();
         colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT |
                                               VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
-        colorBlendAttachment.blendEnable = VK_TRUE;
+        // Depth writing passes are opaque, blending would only cost bandwidth
+        colorBlendAttachment.blendEnable = m_Info->depthTest == DepthTest::ReadWrite ? VK_FALSE : VK_TRUE;
         colorBlendAttachment.srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;          // Multiply by fragment alpha
         colorBlendAttachment.dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;// Inverse of it
         colorBlendAttachment.colorBlendOp = VK_BLEND_OP_ADD;// FinalColor = src + dst * (1 - src.a)
@@ -289,6 +311,20 @@ namespace LunaraEngine
         m_ColorBlending.blendConstants[3] = 0.0f;// Optional
     }
 
+    void PipelineBuilder::SetDepthStencil()
+    {
+        m_DepthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+        m_DepthStencil.depthTestEnable = m_Info->depthTest != DepthTest::None ? VK_TRUE : VK_FALSE;
+        m_DepthStencil.depthWriteEnable = m_Info->depthTest == DepthTest::ReadWrite ? VK_TRUE : VK_FALSE;
+        // Writers reject equal depth so the first of two coplanar quads wins, readers draw over their own layer
+        m_DepthStencil.depthCompareOp =
+                m_Info->depthTest == DepthTest::ReadWrite ? VK_COMPARE_OP_LESS : VK_COMPARE_OP_LESS_OR_EQUAL;
+        m_DepthStencil.depthBoundsTestEnable = VK_FALSE;
+        m_DepthStencil.stencilTestEnable = VK_FALSE;
+        m_DepthStencil.minDepthBounds = 0.0f;// Optional
+        m_DepthStencil.maxDepthBounds = 1.0f;// Optional
+    }
+
     void PipelineBuilder::AddDynamicState(VkDynamicState state)
     {
         m_DynamicStates.push_back(state);
@@ -321,7 +357,9 @@ namespace LunaraEngine
                 pipelineInfo.pViewportState = &m_ViewportState;
                 pipelineInfo.pRasterizationState = &m_Rasterizer;
                 pipelineInfo.pMultisampleState = &m_Multisampling;
-                pipelineInfo.pDepthStencilState = nullptr;
+                // Every pipeline of a render pass with a depth attachment needs a depth state, even a disabled one
+                pipelineInfo.pDepthStencilState =
+                        m_RendererData->swapChain->HasDepthAttachment() ? &m_DepthStencil : nullptr;
                 pipelineInfo.pColorBlendState = &m_ColorBlending;
                 pipelineInfo.pDynamicState = &m_DynamicState;
                 pipelineInfo.layout = m_Layout;
@@ -348,7 +386,7 @@ namespace LunaraEngine
                 if (vkCreateComputePipelines(
                             m_RendererData->device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline) != VK_SUCCESS)
                 {
-                    throw std::runtime_error("failed to create graphics pipeline!");
+                    throw std::runtime_error("failed to create compute pipeline!");
                 }
             }
             break;
@@ -443,5 +481,22 @@ namespace LunaraEngine
         }
     }
 
+    VkDescriptorType PipelineBuilder::GetDescriptorType(const BufferResource& resource)
+    {
+        // Transient resources are sub-allocated from the frame ring buffer and bound with dynamic offsets
+        if (resource.usage == BufferResourceUsage::Transient)
+        {
+            switch (resource.type)
+            {
+                case BufferResourceType::UniformBuffer:
+                    return VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+                case BufferResourceType::StorageBuffer:
+                    return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+                default:
+                    break;
+            }
+        }
+        return GetDescriptorType(resource.type);
+    }
 
 }// namespace LunaraEngine
\ No newline at end of file
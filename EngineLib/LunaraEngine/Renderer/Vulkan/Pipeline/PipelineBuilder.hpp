@@ -23,17 +23,21 @@ namespace LunaraEngine
         void SetRasterization(PolygonMode mode);
         void SetSampling();
         void AddColorBlending();
+        void SetDepthStencil();
         void AddDynamicState(VkDynamicState state);
         void AddDescriptorSet(uint32_t set, BufferResourceType type);
         PipelineData CreatePipeline();
         static VkDescriptorType GetDescriptorType(BufferResourceType type);
+        static VkDescriptorType GetDescriptorType(const BufferResource& resource);
 
     private:
         void CreateDescriptorSetLayout(uint32_t location, BufferResourceType type);
+        bool IsBindlessSet(uint32_t location) const;
         void GetBufferDescriptorLayoutBindings(std::vector<VkDescriptorSetLayoutBinding>& descriptorSetLayoutBindings);
         void GetTextureDescriptorLayoutBindings(std::vector<VkDescriptorSetLayoutBinding>& descriptorSetLayoutBindings);
         void CreatePushConstantRanges();
         void CreatePipelineLayout();
+        VkShaderStageFlags GetResourceStageFlags() const;
         VkShaderModule CreateShaderModule(const std::vector<uint32_t>& spirvCode) const;
         VkPrimitiveTopology GetPrimitiveTopology(RenderingBasePrimitive primitive) const;
         VkPolygonMode GetPolygonMode(PolygonMode mode) const;
@@ -49,6 +53,7 @@ namespace LunaraEngine
         VkPipelineRasterizationStateCreateInfo m_Rasterizer{};
         VkPipelineMultisampleStateCreateInfo m_Multisampling{};
         VkPipelineColorBlendStateCreateInfo m_ColorBlending{};
+        VkPipelineDepthStencilStateCreateInfo m_DepthStencil{};
         VkPipelineDynamicStateCreateInfo m_DynamicState{};
         VkPipelineLayout m_Layout{};
 
@@ -7,15 +7,19 @@
 #include <LunaraEngine/Renderer/Vulkan/Buffer/StorageBuffer.hpp>
 #include <LunaraEngine/Renderer/Vulkan/Buffer/TextureBuffer.hpp>
 #include <LunaraEngine/Renderer/Vulkan/Buffer/Buffer.hpp>
+#include <LunaraEngine/Renderer/Vulkan/Buffer/TransientRingBuffer.hpp>
+#include <LunaraEngine/Renderer/Vulkan/BindlessTextureTable.hpp>
 #include <LunaraEngine/Core/Log.h>
+#include <LunaraEngine/Core/JobSystem.hpp>
 #include "Shader.hpp"
 #include <expected>
 #include <variant>
 #include <future>
-#include <execution>
 #include <vector>
 #include <numeric>
 #include <ranges>
+#include <algorithm>
+#include <cstring>
 
 namespace LunaraEngine
 {
@@ -38,6 +42,7 @@ namespace LunaraEngine
         CreateBuffers(info);
         CreateTextures();
         CreateDescriptorSets();
+        if (!m_TransientBindings.empty()) { m_RendererData->transientBuffer->Attach(this); }
     }
 
     void VulkanShader::ReadShaderSource(const ShaderInfo& info, std::map<size_t, std::vector<uint32_t>>& shaderSource)
@@ -49,8 +54,9 @@ namespace LunaraEngine
         }
         else
         {
+            const std::wstring& vertexName = info.vertexName.empty() ? info.name : info.vertexName;
             shaderSource[VK_SHADER_STAGE_VERTEX_BIT] =
-                    ReadFile(info.path / std::filesystem::path(info.name + L".vert.spv"));
+                    ReadFile(info.path / std::filesystem::path(vertexName + L".vert.spv"));
             shaderSource[VK_SHADER_STAGE_FRAGMENT_BIT] =
                     ReadFile(info.path / std::filesystem::path(info.name + L".frag.spv"));
         }
@@ -63,17 +69,25 @@ namespace LunaraEngine
         if (m_Pipeline != nullptr)
         {
             vkDeviceWaitIdle(m_RendererData->device);
+            if (!m_TransientBindings.empty()) { m_RendererData->transientBuffer->Detach(this); }
             vkDestroyDescriptorPool(m_RendererData->device, m_DescriptorPool, nullptr);
-            delete (GraphicsPipeline*) m_Pipeline;
+            delete m_Pipeline;
             m_Pipeline = nullptr;
+            for (auto slot: m_BindlessSlots) { m_RendererData->bindlessTextures->Release(slot); }
+            m_BindlessSlots.clear();
             for (auto& resource: m_Resources)
             {
                 for (auto& [binding, buffers]: resource)
                 {
                     if (std::holds_alternative<BufferResourceList>(buffers))
                     {
-                        for (auto buffer: std::get<BufferResourceList>(buffers))
+                        if (std::ranges::contains(m_SharedBindings, binding)) { continue; }
+                        // Persistent resources put the same buffer in every frame slot
+                        auto& bufferList = std::get<BufferResourceList>(buffers);
+                        bufferList.erase(std::ranges::unique(bufferList).begin(), bufferList.end());
+                        for (auto buffer: bufferList)
                         {
+                            if (buffer == nullptr) { continue; }
                             if (buffer->GetResourceType() == BufferResourceType::UniformBuffer)
                             {
                                 delete (VulkanUniformBuffer*) buffer;
@@ -203,6 +217,7 @@ namespace LunaraEngine
 
     void* VulkanShader::GetBuffer(ShaderBinding binding)
     {
+        if (IsTransient(binding)) { return nullptr; }
         if (auto result = FindSetLocation(BufferResourceType::Buffer); result.has_value())
         {
             return std::get<BufferResourceList>(
@@ -221,6 +236,11 @@ namespace LunaraEngine
         return nullptr;
     }
 
+    uint32_t VulkanShader::GetFallbackTextureSlot() const
+    {
+        return m_RendererData->bindlessTextures->GetFallbackSlot();
+    }
+
     VkPipeline VulkanShader::GetPipeline() const { return m_Pipeline->GetPipeline(); }
 
     VkPipelineLayout VulkanShader::GetPipelineLayout() const { return m_Pipeline->GetLayout(); }
@@ -245,9 +265,32 @@ namespace LunaraEngine
                 auto& bufferList = std::get<BufferResourceList>(
                         m_Resources[resource.layout.set][std::to_underlying(resource.layout.binding)]);
 
+                // Transient resources live in the renderer ring buffer, only the binding is tracked
+                if (resource.usage == BufferResourceUsage::Transient)
+                {
+                    if (resource.length * resource.stride > TransientRingBuffer::MAX_BINDING_RANGE)
+                    {
+                        throw std::runtime_error("transient buffer resource exceeds the maximum binding range!");
+                    }
+                    m_TransientBindings.push_back(std::to_underlying(resource.layout.binding));
+                    continue;
+                }
+
                 // Resize buffer list to have buffer for each frame
                 bufferList.resize(m_RendererData->maxFramesInFlight);
 
+                // Shared resources are attached later from another shader through ShareBuffer
+                if (resource.usage == BufferResourceUsage::Shared) { continue; }
+
+                // State carried between frames lives in a single buffer referenced by every frame
+                if (resource.usage == BufferResourceUsage::Persistent &&
+                    resource.type == BufferResourceType::StorageBuffer)
+                {
+                    std::ranges::fill(bufferList, new VulkanStorageBuffer(m_RendererData, nullptr, resource.length,
+                                                                          resource.stride, resource.usage));
+                    continue;
+                }
+
                 // Crate buffer for each frame
                 std::ranges::for_each(bufferList, [&](auto& buffer) {
                     switch (resource.type)
@@ -256,7 +299,8 @@ namespace LunaraEngine
                             buffer = new VulkanUniformBuffer(m_RendererData, nullptr, resource.length, resource.stride);
                             break;
                         case BufferResourceType::StorageBuffer:
-                            buffer = new VulkanStorageBuffer(m_RendererData, nullptr, resource.length, resource.stride);
+                            buffer = new VulkanStorageBuffer(
+                                    m_RendererData, nullptr, resource.length, resource.stride, resource.usage);
                             break;
                         default:
                             break;
@@ -264,6 +308,8 @@ namespace LunaraEngine
                 });
             }
         }
+        std::ranges::sort(m_TransientBindings);
+        m_DynamicOffsets.resize(m_TransientBindings.size());
     }
 
     void VulkanShader::CreateTextures()
@@ -288,8 +334,9 @@ namespace LunaraEngine
             auto& textureList = std::get<TextureResourceList>(
                     m_Resources[resource.layout.set][std::to_underlying(resource.layout.binding)]);
 
-            // Resize buffer list to have buffer for each frame
-            textureList.resize(m_RendererData->maxFramesInFlight);
+            // Resize buffer list to have buffer for each frame, bindless arrays keep one buffer per texture instead
+            const bool isBindless = resource.textureType == TextureResourceType::Texture2DBindlessArray;
+            textureList.resize(isBindless ? resource.textureNames.size() : m_RendererData->maxFramesInFlight);
 
             // Allocate texture buffer handle for each frame
             std::ranges::for_each(textureList, [&](auto& buffer) {
@@ -308,13 +355,24 @@ namespace LunaraEngine
             std::vector<std::expected<TextureDataView, std::error_code>> readTextureDataResults;
             readTextureDataResults.resize(resource.textureNames.size());
 
-            // Read textures asynchronously
-            auto indices = std::views::iota(size_t{0}, resource.textureNames.size());
-            std::for_each(std::execution::par, indices.begin(), indices.end(), [&](size_t i) {
-                readTextureDataResults[i] = TextureReader::Read(
-                        std::filesystem::path(resource.path), std::wstring(resource.textureNames[i]));
-                LOG_INFO("Loaded texture: %ls", resource.textureNames[i].data());
-            });
+            // Read textures asynchronously, one texture per job
+            JobSystem::ParallelFor(
+                    resource.textureNames.size(),
+                    [&](size_t begin, size_t end) {
+                        for (size_t i = begin; i < end; i++)
+                        {
+                            readTextureDataResults[i] = TextureReader::Read(
+                                    std::filesystem::path(resource.path), std::wstring(resource.textureNames[i]));
+                            LOG_INFO("Loaded texture: %ls", resource.textureNames[i].data());
+                        }
+                    },
+                    1);
+
+            if (isBindless)
+            {
+                CreateBindlessTextures(resource, textureList, readTextureDataResults);
+                continue;
+            }
 
             // Extract pixel data from results
             auto values = readTextureDataResults | std::views::filter([](const auto& result) {
@@ -349,6 +407,44 @@ namespace LunaraEngine
         }
     }
 
+    void VulkanShader::CreateBindlessTextures(
+            const TextureResource& resource, TextureResourceList& textureList,
+            std::vector<std::expected<TextureDataView, std::error_code>>& textureData)
+    {
+        for (size_t i = 0; i < textureList.size(); i++)
+        {
+            if (!textureData[i].has_value())
+            {
+                LOG_ERROR("%s", textureData[i].error().message().data());
+                throw std::runtime_error("failed to read bindless texture!");
+            }
+
+            // Textures are always loaded with 4 channels, sizes may differ between textures
+            TextureInfo textureInfo = TextureReader::GetInfo(resource.path, resource.textureNames[i]);
+            textureInfo.format = TextureFormat::RGBA;
+
+            VulkanTextureBuffer* vulkanTexture = static_cast<VulkanTextureBuffer*>(textureList[i]);
+            vulkanTexture->Create(m_RendererData, m_RendererData->gfxQueue, textureInfo, &*textureData[i]);
+
+            auto slot =
+                    m_RendererData->bindlessTextures->Register(vulkanTexture->GetView(), vulkanTexture->GetSampler());
+            if (!slot.has_value())
+            {
+                LOG_ERROR("%s", slot.error().c_str());
+                throw std::runtime_error("failed to register bindless texture!");
+            }
+            m_BindlessSlots.push_back(*slot);
+        }
+    }
+
+    bool VulkanShader::IsBindlessSet(size_t location) const
+    {
+        return std::ranges::any_of(p_Info.resources.textureResources, [location](const TextureResource& resource) {
+            return resource.layout.set == location &&
+                   resource.textureType == TextureResourceType::Texture2DBindlessArray;
+        });
+    }
+
     void VulkanShader::CreateDescriptorSets()
     {
         std::map<VkDescriptorType, uint32_t> descriptorCountMap;
@@ -358,12 +454,17 @@ namespace LunaraEngine
             if (resource.type == BufferResourceType::UniformBuffer ||
                 resource.type == BufferResourceType::StorageBuffer)
             {
-                auto type = PipelineBuilder::GetDescriptorType(resource.type);
+                auto type = PipelineBuilder::GetDescriptorType(resource);
                 descriptorCountMap[type] += m_RendererData->maxFramesInFlight;
             }
         }
 
-        for (const auto& resource: p_Info.resources.textureResources)
+        // Bindless textures live in the renderer wide table and don't take space in this pool
+        auto boundTextures =
+                p_Info.resources.textureResources | std::views::filter([](const TextureResource& resource) {
+                    return resource.textureType != TextureResourceType::Texture2DBindlessArray;
+                });
+        for (const auto& resource: boundTextures)
         {
             auto type = PipelineBuilder::GetDescriptorType(resource.resourceType);
             descriptorCountMap[type] += m_RendererData->maxFramesInFlight;
@@ -385,7 +486,7 @@ namespace LunaraEngine
         // maximum descriptors in pool
         descriptorPoolInfo.pPoolSizes = poolSizes.data();
         // maximum number of descriptor sets
-        if (p_Info.resources.textureResources.size() > 0)
+        if (!std::ranges::empty(boundTextures))
         {
             // 2x number of frames in flight ( one for textures and one for buffers)
             descriptorPoolInfo.maxSets = 2 * m_RendererData->maxFramesInFlight;
@@ -430,6 +531,12 @@ namespace LunaraEngine
 
         for (const auto& [location, type]: m_SetTypes)
         {
+            if (type == BufferResourceType::Texture && IsBindlessSet(location))
+            {
+                m_DescriptorSets[type] = std::vector(m_RendererData->maxFramesInFlight,
+                                                     m_RendererData->bindlessTextures->GetDescriptorSet());
+                continue;
+            }
             auto layouts = getLayouts(location, m_RendererData->maxFramesInFlight);
             auto sets = allocateSets(layouts, m_RendererData->maxFramesInFlight);
             m_DescriptorSets[type] = sets;
@@ -469,6 +576,9 @@ namespace LunaraEngine
         };
 
         auto updateTextureSets = [&](size_t setIndex) -> std::expected<bool, std::string> {
+            // Bindless descriptors are written once when the textures are registered
+            if (IsBindlessSet(setIndex)) { return true; }
+
             std::ranges::for_each(p_Info.resources.textureResources, [&](const TextureResource& resource) {
                 VulkanTextureBuffer* textureBuffer = static_cast<VulkanTextureBuffer*>(std::get<TextureResourceList>(
                         m_Resources[setIndex][(size_t) resource.layout.binding])[frameIndex]);
@@ -518,15 +628,25 @@ namespace LunaraEngine
             std::ranges::for_each(p_Info.resources.bufferResources, [&](const BufferResource& resource) {
                 if (resource.type == BufferResourceType::PushConstant) { return; }
 
+                VkBuffer buffer = VK_NULL_HANDLE;
+                if (resource.usage == BufferResourceUsage::Transient)
+                {
+                    buffer = m_RendererData->transientBuffer->GetBuffer(frameIndex);
+                }
+                else if (auto resourceBuffer = std::get<BufferResourceList>(
+                                 m_Resources[setIndex][(size_t) resource.layout.binding])[frameIndex])
+                {
+                    buffer = resourceBuffer->GetHandle();
+                }
+                // A shared binding that was never attached has nothing to point at yet
+                if (buffer == VK_NULL_HANDLE) { return; }
                 bufferInfos.push_back(VkDescriptorBufferInfo{
-                        .buffer = std::get<BufferResourceList>(
-                                          m_Resources[setIndex][(size_t) resource.layout.binding])[frameIndex]
-                                          ->GetHandle(),
+                        .buffer = buffer,
                         .offset = 0,
                         .range = resource.length * resource.stride,
                 });
                 bufferDescriptorBindings.push_back((uint32_t) resource.layout.binding);
-                bufferDescriptorTypes.push_back(PipelineBuilder::GetDescriptorType(resource.type));
+                bufferDescriptorTypes.push_back(PipelineBuilder::GetDescriptorType(resource));
             });
 
             for (size_t j = 0; j < bufferDescriptorBindings.size(); j++)
@@ -550,6 +670,111 @@ namespace LunaraEngine
         FindSetLocation(BufferResourceType::Buffer).and_then(updateBufferSets).transform_error(logError);
     }
 
+    bool VulkanShader::ShareBuffer(ShaderBinding binding, Shader* source, ShaderBinding sourceBinding)
+    {
+        auto* sourceShader = static_cast<VulkanShader*>(source);
+        const BufferResource* resource = FindBufferResource(binding);
+        const BufferResource* sourceResource = sourceShader ? sourceShader->FindBufferResource(sourceBinding) : nullptr;
+        if (resource == nullptr || sourceResource == nullptr || resource->usage != BufferResourceUsage::Shared ||
+            sourceShader->IsTransient(sourceBinding))
+        {
+            LOG_ERROR("Failed to share buffer %s", resource ? resource->name.data() : "");
+            return false;
+        }
+        if (resource->length * resource->stride > sourceResource->length * sourceResource->stride)
+        {
+            LOG_ERROR("Shared buffer %s is larger than its source %s", resource->name.data(),
+                      sourceResource->name.data());
+            return false;
+        }
+
+        auto set = FindSetLocation(BufferResourceType::Buffer);
+        auto sourceSet = sourceShader->FindSetLocation(BufferResourceType::Buffer);
+        if (!set.has_value() || !sourceSet.has_value()) { return false; }
+
+        // Both shaders reference the same per frame buffers, the source keeps ownership
+        std::get<BufferResourceList>(m_Resources[*set][std::to_underlying(binding)]) =
+                std::get<BufferResourceList>(sourceShader->m_Resources[*sourceSet][std::to_underlying(sourceBinding)]);
+        if (!std::ranges::contains(m_SharedBindings, std::to_underlying(binding)))
+        {
+            m_SharedBindings.push_back(std::to_underlying(binding));
+        }
+
+        // The descriptor sets were written before the buffers were attached
+        for (uint32_t i = 0; i < m_RendererData->maxFramesInFlight; i++) { UpdateBufferDescriptorSets(i); }
+        return true;
+    }
+
+    const BufferResource* VulkanShader::FindBufferResource(ShaderBinding binding) const
+    {
+        auto it = std::ranges::find_if(p_Info.resources.bufferResources, [binding](const BufferResource& resource) {
+            return resource.type != BufferResourceType::PushConstant && resource.layout.binding == binding;
+        });
+        return it != p_Info.resources.bufferResources.end() ? &*it : nullptr;
+    }
+
+    bool VulkanShader::IsTransient(ShaderBinding binding) const
+    {
+        return std::ranges::binary_search(m_TransientBindings, std::to_underlying(binding));
+    }
+
+    size_t VulkanShader::GetTransientUploadSize(ShaderBinding binding, size_t count, size_t offset) const
+    {
+        const BufferResource* resource = FindBufferResource(binding);
+        if (resource == nullptr || !IsTransient(binding)) { return 0; }
+        return (offset + count) * resource->stride;
+    }
+
+    bool VulkanShader::UploadTransient(ShaderBinding binding, const uint8_t* data, size_t count, size_t offset)
+    {
+        const BufferResource* resource = FindBufferResource(binding);
+        if (resource == nullptr || !IsTransient(binding)) { return false; }
+
+        if (offset + count > resource->length)
+        {
+            LOG_ERROR("Transient upload to %s exceeds its length %zu", resource->name.data(), resource->length);
+            return false;
+        }
+
+        // Instances are indexed from the start of the binding, so the range up to the offset is reserved too
+        size_t size = GetTransientUploadSize(binding, count, offset);
+        auto allocation = m_RendererData->transientBuffer->Allocate(size);
+        if (!allocation.has_value())
+        {
+            // Only a frame that outgrew the reservation made at its start gets here, the next frame grows
+            LOG_ERROR("%s The %zu bytes for %s are dropped with their draw", allocation.error().c_str(), size,
+                      resource->name.data());
+            return false;
+        }
+        std::memcpy(allocation->data + offset * resource->stride, data, count * resource->stride);
+
+        auto index = std::ranges::lower_bound(m_TransientBindings, std::to_underlying(binding)) -
+                     m_TransientBindings.begin();
+        m_DynamicOffsets[(size_t) index] = static_cast<uint32_t>(allocation->offset);
+        return true;
+    }
+
+    void VulkanShader::BindTransientBuffers(VkCommandBuffer commandBuffer)
+    {
+        if (m_TransientBindings.empty()) { return; }
+
+        if (auto result = FindSetLocation(BufferResourceType::Buffer); result.has_value())
+        {
+            vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, GetPipelineLayout(),
+                                    static_cast<uint32_t>(*result), 1,
+                                    &m_DescriptorSets[BufferResourceType::Buffer][m_RendererData->currentFrame],
+                                    static_cast<uint32_t>(m_DynamicOffsets.size()), m_DynamicOffsets.data());
+        }
+    }
+
+    void VulkanShader::ResetDynamicOffsets() { std::ranges::fill(m_DynamicOffsets, 0); }
+
+    std::span<const uint32_t> VulkanShader::GetDynamicOffsets(BufferResourceType type) const
+    {
+        if (type != BufferResourceType::Buffer) { return {}; }
+        return m_DynamicOffsets;
+    }
+
     std::vector<uint32_t> VulkanShader::ReadFile(std::filesystem::path name)
     {
 
@@ -5,6 +5,7 @@
 #include <variant>
 #include <expected>
 #include <string>
+#include <span>
 
 namespace LunaraEngine
 {
@@ -43,6 +44,13 @@ namespace LunaraEngine
         virtual void* GetBuffer(ShaderBinding binding) override;
         virtual void* GetTexture(ShaderBinding binding) override;
 
+        virtual const std::vector<uint32_t>& GetBindlessTextureSlots() const override { return m_BindlessSlots; }
+        virtual uint32_t GetFallbackTextureSlot() const override;
+
+        virtual bool ShareBuffer(ShaderBinding binding, Shader* source, ShaderBinding sourceBinding) override;
+
+        bool IsComputeShader() const { return p_Info.isComputeShader; }
+
         VkPipeline GetPipeline() const;
         VkPipelineLayout GetPipelineLayout() const;
 
@@ -53,6 +61,14 @@ namespace LunaraEngine
         void UpdateBufferDescriptorSets(uint32_t frameIndex);
         void UpdateTextureDescriptorSets(uint32_t frameIndex);
 
+        bool IsTransient(ShaderBinding binding) const;
+        // Ring buffer bytes UploadTransient takes for the range, zero for bindings that are not transient
+        size_t GetTransientUploadSize(ShaderBinding binding, size_t count, size_t offset = 0) const;
+        bool UploadTransient(ShaderBinding binding, const uint8_t* data, size_t count, size_t offset = 0);
+        void BindTransientBuffers(VkCommandBuffer commandBuffer);
+        void ResetDynamicOffsets();
+        std::span<const uint32_t> GetDynamicOffsets(BufferResourceType type) const;
+
     public:
         static VkFormat GetBufferResourceFormat(BufferResourceFormatT format, BufferResourceDataTypeT type);
         static std::string GetBufferResourceType(BufferResourceType type);
@@ -68,9 +84,13 @@ namespace LunaraEngine
         void LogTextureResource(const TextureResource& resource);
         void CreateBuffers(const ShaderInfo& info);
         void CreateTextures();
+        void CreateBindlessTextures(const TextureResource& resource, TextureResourceList& textureList,
+                                    std::vector<std::expected<TextureDataView, std::error_code>>& textureData);
+        bool IsBindlessSet(size_t location) const;
         void CreateDescriptorSets();
         size_t FindUniformAttributeOffset(std::string_view name);
         VulkanUniformBuffer* GetUniformBuffer(size_t frame);
+        const BufferResource* FindBufferResource(ShaderBinding binding) const;
 
     private:
         static std::vector<uint32_t> ReadFile(std::filesystem::path name);
@@ -92,6 +112,10 @@ namespace LunaraEngine
                 m_Resources;// set -> binding -> resource list for each frame
 
         std::map<BufferResourceType, std::vector<VkDescriptorSet>> m_DescriptorSets;
+        std::vector<uint32_t> m_BindlessSlots;// slots in the renderer bindless table, one per texture
+        std::vector<size_t> m_TransientBindings;// sorted, dynamic offsets follow binding order
+        std::vector<size_t> m_SharedBindings;   // owned by another shader, never destroyed here
+        std::vector<uint32_t> m_DynamicOffsets;
         VkDescriptorPool m_DescriptorPool{};
         Pipeline* m_Pipeline{};
         size_t m_UniformBinding{};
@@ -1,6 +1,7 @@
 #include <LunaraEngine/Renderer/Vulkan/Common.hpp>
 #include <LunaraEngine/Renderer/Vulkan/SwapChain.hpp>
 #include <algorithm>
+#include <array>
 #include <stdexcept>
 
 namespace LunaraEngine
@@ -73,8 +74,9 @@ namespace LunaraEngine
         }
     }
 
-    SwapChain::SwapChain(VkDevice device, VkPhysicalDevice physicalDevice, VkSurfaceKHR surface)
-        : m_device(device), m_physicalDevice(physicalDevice), m_surface(surface)
+    SwapChain::SwapChain(VkDevice device, VkPhysicalDevice physicalDevice, VkSurfaceKHR surface,
+                         bool depthAttachment)
+        : m_device(device), m_physicalDevice(physicalDevice), m_surface(surface), m_UseDepth(depthAttachment)
     {}
 
     SwapChain::~SwapChain()
@@ -88,6 +90,7 @@ namespace LunaraEngine
         }
         if (m_renderPass != VK_NULL_HANDLE) { vkDestroyRenderPass(m_device, m_renderPass, nullptr); }
         for (auto imageView: m_ImageViews) { vkDestroyImageView(m_device, imageView, nullptr); }
+        DestroyDepthResources();
         if (m_swapChain != VK_NULL_HANDLE) { vkDestroySwapchainKHR(m_device, m_swapChain, nullptr); }
     }
 
@@ -97,6 +100,7 @@ namespace LunaraEngine
         for (auto imageView: m_ImageViews) { vkDestroyImageView(m_device, imageView, nullptr); }
         m_ImageViews.clear();
         m_Images.clear();
+        DestroyDepthResources();
         if (m_swapChain != VK_NULL_HANDLE) { vkDestroySwapchainKHR(m_device, m_swapChain, nullptr); }
 
         SwapChainSupportDetails swapChainSupport =
@@ -155,6 +159,7 @@ namespace LunaraEngine
         vkGetSwapchainImagesKHR(m_device, m_swapChain, &imageCount, m_Images.data());
 
         CreateImageViews();
+        if (m_UseDepth) { CreateDepthResources(); }
         CreateRenderPass();
         CreateFrameBuffers();
     }
@@ -212,17 +217,50 @@ namespace LunaraEngine
         colorAttachmentRef.attachment = 0;
         colorAttachmentRef.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
 
+        // Depth only lives for the duration of the pass, it is cleared on load and never stored
+        VkAttachmentDescription depthAttachment{};
+        depthAttachment.format = m_DepthFormat;
+        depthAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
+        depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        depthAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+        depthAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+        depthAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        depthAttachment.finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+        VkAttachmentReference depthAttachmentRef{};
+        depthAttachmentRef.attachment = 1;
+        depthAttachmentRef.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
         VkSubpassDescription subpass{};
         subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
 
         subpass.colorAttachmentCount = 1;
         subpass.pColorAttachments = &colorAttachmentRef;
+        subpass.pDepthStencilAttachment = m_UseDepth ? &depthAttachmentRef : nullptr;
+
+        // The previous frame may still be testing against the shared depth image
+        VkSubpassDependency dependency{};
+        dependency.srcSubpass = VK_SUBPASS_EXTERNAL;
+        dependency.dstSubpass = 0;
+        dependency.srcStageMask =
+                VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+        dependency.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+        dependency.dstStageMask =
+                VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+        dependency.dstAccessMask =
+                VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+        std::array<VkAttachmentDescription, 2> attachments = {colorAttachment, depthAttachment};
+
         VkRenderPassCreateInfo renderPassInfo{};
         renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-        renderPassInfo.attachmentCount = 1;
-        renderPassInfo.pAttachments = &colorAttachment;
+        renderPassInfo.attachmentCount = m_UseDepth ? 2 : 1;
+        renderPassInfo.pAttachments = attachments.data();
         renderPassInfo.subpassCount = 1;
         renderPassInfo.pSubpasses = &subpass;
+        renderPassInfo.dependencyCount = m_UseDepth ? 1 : 0;
+        renderPassInfo.pDependencies = &dependency;
 
         if (vkCreateRenderPass(m_device, &renderPassInfo, nullptr, &(m_renderPass)) != VK_SUCCESS)
         {
@@ -235,13 +273,14 @@ namespace LunaraEngine
         m_swapChainFrameBuffer.resize(m_ImageViews.size());
         for (size_t i = 0; i < m_ImageViews.size(); i++)
         {
-            VkImageView attachments = m_ImageViews[i];
+            // Every frame buffer shares the one depth image, frames are serialized by the subpass dependency
+            std::array<VkImageView, 2> attachments = {m_ImageViews[i], m_DepthImageView};
 
             VkFramebufferCreateInfo framebufferInfo{};
             framebufferInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
             framebufferInfo.renderPass = m_renderPass;
-            framebufferInfo.attachmentCount = 1;
-            framebufferInfo.pAttachments = &attachments;
+            framebufferInfo.attachmentCount = m_UseDepth ? 2 : 1;
+            framebufferInfo.pAttachments = attachments.data();
             framebufferInfo.width = m_extent.width;
             framebufferInfo.height = m_extent.height;
             framebufferInfo.layers = 1;
@@ -253,5 +292,81 @@ namespace LunaraEngine
         }
     }
 
+    VkFormat SwapChain::FindDepthFormat() const
+    {
+        for (VkFormat format: {VK_FORMAT_D32_SFLOAT, VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D24_UNORM_S8_UINT})
+        {
+            VkFormatProperties properties;
+            vkGetPhysicalDeviceFormatProperties(m_physicalDevice, format, &properties);
+            if (properties.optimalTilingFeatures & VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT) { return format; }
+        }
+        throw std::runtime_error("failed to find supported depth format!");
+    }
+
+    void SwapChain::CreateDepthResources()
+    {
+        m_DepthFormat = FindDepthFormat();
+
+        VkImageCreateInfo imageInfo{};
+        imageInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        imageInfo.imageType = VK_IMAGE_TYPE_2D;
+        imageInfo.extent.width = m_extent.width;
+        imageInfo.extent.height = m_extent.height;
+        imageInfo.extent.depth = 1;
+        imageInfo.mipLevels = 1;
+        imageInfo.arrayLayers = 1;
+        imageInfo.format = m_DepthFormat;
+        imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+        imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+        imageInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+        imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+        imageInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+        if (vkCreateImage(m_device, &imageInfo, nullptr, &m_DepthImage) != VK_SUCCESS)
+        {
+            throw std::runtime_error("failed to create depth image!");
+        }
+
+        VkMemoryRequirements memoryRequirements;
+        vkGetImageMemoryRequirements(m_device, m_DepthImage, &memoryRequirements);
+
+        VkMemoryAllocateInfo allocInfo{};
+        allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+        allocInfo.allocationSize = memoryRequirements.size;
+        allocInfo.memoryTypeIndex = FindMemoryType(
+                memoryRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_physicalDevice);
+
+        if (vkAllocateMemory(m_device, &allocInfo, nullptr, &m_DepthMemory) != VK_SUCCESS)
+        {
+            throw std::runtime_error("failed to allocate depth image memory!");
+        }
+        vkBindImageMemory(m_device, m_DepthImage, m_DepthMemory, 0);
+
+        VkImageViewCreateInfo viewInfo{};
+        viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        viewInfo.image = m_DepthImage;
+        viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        viewInfo.format = m_DepthFormat;
+        viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+        viewInfo.subresourceRange.baseMipLevel = 0;
+        viewInfo.subresourceRange.levelCount = 1;
+        viewInfo.subresourceRange.baseArrayLayer = 0;
+        viewInfo.subresourceRange.layerCount = 1;
+
+        if (vkCreateImageView(m_device, &viewInfo, nullptr, &m_DepthImageView) != VK_SUCCESS)
+        {
+            throw std::runtime_error("failed to create depth image view!");
+        }
+    }
+
+    void SwapChain::DestroyDepthResources()
+    {
+        if (m_DepthImageView != VK_NULL_HANDLE) { vkDestroyImageView(m_device, m_DepthImageView, nullptr); }
+        if (m_DepthImage != VK_NULL_HANDLE) { vkDestroyImage(m_device, m_DepthImage, nullptr); }
+        if (m_DepthMemory != VK_NULL_HANDLE) { vkFreeMemory(m_device, m_DepthMemory, nullptr); }
+        m_DepthImageView = VK_NULL_HANDLE;
+        m_DepthImage = VK_NULL_HANDLE;
+        m_DepthMemory = VK_NULL_HANDLE;
+    }
 
 }// namespace LunaraEngine
\ No newline at end of file
@@ -11,7 +11,8 @@ namespace LunaraEngine
     class SwapChain
     {
     public:
-        SwapChain(VkDevice device, VkPhysicalDevice physicalDevice, VkSurfaceKHR surface);
+        SwapChain(VkDevice device, VkPhysicalDevice physicalDevice, VkSurfaceKHR surface,
+                  bool depthAttachment = false);
         ~SwapChain();
 
     public:
@@ -29,12 +30,17 @@ namespace LunaraEngine
         [[nodiscard]] auto GetImageView(uint32_t index) const { return m_ImageViews[index]; }
         [[nodiscard]] auto GetRenderPass() const { return m_renderPass; }
         [[nodiscard]] auto GetFrameBuffer(uint32_t index) const { return m_swapChainFrameBuffer[index]; }
+        [[nodiscard]] auto HasDepthAttachment() const { return m_UseDepth; }
+        [[nodiscard]] auto GetDepthFormat() const { return m_DepthFormat; }
 
         // clang-format on
     private:
         void CreateImageViews();
         void CreateRenderPass();
         void CreateFrameBuffers();
+        void CreateDepthResources();
+        void DestroyDepthResources();
+        VkFormat FindDepthFormat() const;
 
     private:
         VkDevice m_device{};
@@ -47,5 +53,11 @@ namespace LunaraEngine
         std::vector<VkImage> m_Images;
         std::vector<VkImageView> m_ImageViews;
         std::vector<VkFramebuffer> m_swapChainFrameBuffer;
+
+        bool m_UseDepth{};
+        VkFormat m_DepthFormat{VK_FORMAT_UNDEFINED};
+        VkImage m_DepthImage{};
+        VkDeviceMemory m_DepthMemory{};
+        VkImageView m_DepthImageView{};
     };
 }// namespace LunaraEngine
\ No newline at end of file
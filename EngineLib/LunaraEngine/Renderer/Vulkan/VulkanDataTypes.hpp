@@ -27,6 +27,8 @@ namespace LunaraEngine
     const std::array<const char*, 1> g_SwapChainExtensions = {VK_KHR_SWAPCHAIN_EXTENSION_NAME};
 
     class SwapChain;
+    class BindlessTextureTable;
+    class TransientRingBuffer;
 
     struct RendererDataType {
         LunaraEngine::Window* window;
@@ -43,6 +45,8 @@ namespace LunaraEngine
         Queue computeQueue;
         SwapChain* swapChain;
         CommandPool* commandPool;
+        BindlessTextureTable* bindlessTextures;
+        TransientRingBuffer* transientBuffer;
         uint32_t currentFrame;
         uint32_t imageIndex;
         uint32_t maxFramesInFlight;
@@ -119,9 +119,18 @@ namespace LunaraEngine
         }
         VkPhysicalDeviceFeatures deviceFeatures{};
 
+        // Descriptor indexing for the bindless texture table
+        VkPhysicalDeviceVulkan12Features vulkan12Features{};
+        vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+        vulkan12Features.descriptorIndexing = VK_TRUE;
+        vulkan12Features.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+        vulkan12Features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+        vulkan12Features.descriptorBindingPartiallyBound = VK_TRUE;
+        vulkan12Features.runtimeDescriptorArray = VK_TRUE;
+
         VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamicRenderingFeature = {
                 .sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR,
-                .pNext = NULL,
+                .pNext = &vulkan12Features,
                 .dynamicRendering = VK_TRUE,
         };
 
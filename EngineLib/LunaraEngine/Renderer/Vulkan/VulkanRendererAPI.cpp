@@ -50,6 +50,8 @@ Includes
 #include <LunaraEngine/Renderer/Vulkan/Buffer/VertexBuffer.hpp>
 #include <LunaraEngine/Renderer/Vulkan/Shader.hpp>
 #include <LunaraEngine/Renderer/Vulkan/VulkanRendererCommands.hpp>
+#include <LunaraEngine/Renderer/Vulkan/BindlessTextureTable.hpp>
+#include <LunaraEngine/Renderer/Vulkan/Buffer/TransientRingBuffer.hpp>
 #include <LunaraEngine/Renderer/Buffer/IndexBuffer.hpp>
 #include <LunaraEngine/Renderer/Buffer/VertexBuffer.hpp>
 #include <LunaraEngine/Renderer/Shader.hpp>
@@ -99,6 +101,8 @@ namespace LunaraEngine
                         {RendererCommandType::BeginFrame, VulkanRendererCommand::BeginFrame},
                         {RendererCommandType::Present, VulkanRendererCommand::Present},
                         {RendererCommandType::DrawQuadBatch, VulkanRendererCommand::DrawQuadBatch},
+                        {RendererCommandType::Dispatch, VulkanRendererCommand::Dispatch},
+                        {RendererCommandType::FillBuffer, VulkanRendererCommand::FillBuffer},
                     };
 
         std::array<DispatchFunction, static_cast<size_t>(RendererCommandType::Count)> table;
@@ -119,6 +123,12 @@ namespace LunaraEngine
 
     size_t VulkanRendererAPI::GetHeight() const { return m_RendererData->surfaceExtent.height; }
 
+    uint32_t VulkanRendererAPI::GetCurrentFrame() const { return m_RendererData->currentFrame; }
+
+    uint32_t VulkanRendererAPI::GetFramesInFlight() const { return m_RendererData->maxFramesInFlight; }
+
+    bool VulkanRendererAPI::HasDepthAttachment() const { return m_RendererData->swapChain->HasDepthAttachment(); }
+
     void VulkanRendererAPI::HandleCommand(const RendererCommand* command, const RendererCommandType type)
     {
         static constexpr auto dispatchTable = MakeDispatchableTable();
@@ -130,6 +140,11 @@ namespace LunaraEngine
         std::invoke(dispatchTable[index], m_RendererData.get(), command);
     }
 
+    void VulkanRendererAPI::RecordStagedUploads(std::span<const RendererCommand* const> commands)
+    {
+        VulkanRendererCommand::RecordStagedUploads(m_RendererData.get(), commands);
+    }
+
     void VulkanRendererAPI::Present() { throw std::runtime_error("Not implemented"); }
 
     void VulkanRendererAPI::Init(const RendererAPIConfig& config)
@@ -141,8 +156,8 @@ namespace LunaraEngine
         CreateWindow();
         VulkanInitializer::Initialize(m_RendererData.get());
 
-        m_RendererData->swapChain =
-                new SwapChain(m_RendererData->device, m_RendererData->physicalDevice, m_RendererData->vkSurface);
+        m_RendererData->swapChain = new SwapChain(m_RendererData->device, m_RendererData->physicalDevice,
+                                                  m_RendererData->vkSurface, m_Config.depthAttachment);
         m_RendererData->swapChain->Create(m_RendererData->surfaceExtent);
 
         m_RendererData->maxFramesInFlight = static_cast<uint32_t>(m_RendererData->swapChain->GetImages().size());
@@ -150,11 +165,18 @@ namespace LunaraEngine
         m_RendererData->commandPool = new CommandPool(
                 m_RendererData->device, m_RendererData->gfxQueue.GetIndex(), m_RendererData->maxFramesInFlight);
         VulkanInitializer::CreateSyncObjects(m_RendererData.get());
+
+        m_RendererData->bindlessTextures =
+                new BindlessTextureTable(m_RendererData->device, m_RendererData->physicalDevice);
+        m_RendererData->bindlessTextures->CreateFallbackTexture(m_RendererData.get());
+        m_RendererData->transientBuffer = new TransientRingBuffer(m_RendererData.get());
     }
 
     void VulkanRendererAPI::Destroy()
     {
         vkDeviceWaitIdle(m_RendererData->device);
+        delete m_RendererData->transientBuffer;
+        delete m_RendererData->bindlessTextures;
         delete m_RendererData->commandPool;
         delete m_RendererData->swapChain;
         VulkanInitializer::Goodbye(m_RendererData.get());
@@ -66,8 +66,12 @@ namespace LunaraEngine
         virtual void HandleCommand(const RendererCommand* command,
                                    const RendererCommandType type = RendererCommandType::None) override;
         virtual void HandleCommand(const RendererCommandType type) override;
+        virtual void RecordStagedUploads(std::span<const RendererCommand* const> commands) override;
         virtual size_t GetWidth() const override;
         virtual size_t GetHeight() const override;
+        virtual uint32_t GetCurrentFrame() const override;
+        virtual uint32_t GetFramesInFlight() const override;
+        virtual bool HasDepthAttachment() const override;
 
     private:
         void CreateWindow();
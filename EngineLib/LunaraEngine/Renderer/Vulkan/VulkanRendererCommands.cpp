@@ -38,6 +38,8 @@
 Includes
 ***********************************************************************************************************************/
 #include <stdexcept>
+#include <algorithm>
+#include <array>
 #include <vulkan/vulkan.h>
 #include <LunaraEngine/Core/Log.h>
 #include <LunaraEngine/Renderer/Vulkan/VulkanRendererCommands.hpp>
@@ -45,6 +47,7 @@ Includes
 #include <LunaraEngine/Renderer/Vulkan/Buffer/IndexBuffer.hpp>
 #include <LunaraEngine/Renderer/Vulkan/Buffer/VertexBuffer.hpp>
 #include <LunaraEngine/Renderer/Vulkan/Buffer/StorageBuffer.hpp>
+#include <LunaraEngine/Renderer/Vulkan/Buffer/TransientRingBuffer.hpp>
 #include <LunaraEngine/Renderer/Vulkan/Shader.hpp>
 #include <LunaraEngine/Renderer/Buffer/IndexBuffer.hpp>
 #include <LunaraEngine/Renderer/Buffer/VertexBuffer.hpp>
@@ -60,14 +63,20 @@ namespace LunaraEngine
         VulkanShader* shader = (VulkanShader*) (arg->shader);
 
         const auto& buffer = rendererData->commandPool->GetBuffer(rendererData->currentFrame);
-        vkCmdBindPipeline(buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, shader->GetPipeline());
+        const auto bindPoint =
+                shader->IsComputeShader() ? VK_PIPELINE_BIND_POINT_COMPUTE : VK_PIPELINE_BIND_POINT_GRAPHICS;
+        vkCmdBindPipeline(buffer, bindPoint, shader->GetPipeline());
         if (arg->push_constants)
         {
-            vkCmdPushConstants(buffer, shader->GetPipelineLayout(), VK_SHADER_STAGE_VERTEX_BIT, 0, 128,
-                               (void*) &arg->push_constants);
+            vkCmdPushConstants(buffer, shader->GetPipelineLayout(),
+                               shader->IsComputeShader() ? VK_SHADER_STAGE_COMPUTE_BIT : VK_SHADER_STAGE_VERTEX_BIT, 0,
+                               128, (void*) &arg->push_constants);
         }
 
+        // The sets are written at creation, by ShareBuffer and when the transient buffer grows, never here since
+        // writing a bound set that is not UPDATE_AFTER_BIND invalidates the command buffer
         // LOG_DEBUG("Binding Descriptor sets");
+        shader->ResetDynamicOffsets();
         for (auto& [type, frameSets]: shader->GetDescriptorSets())
         {
             // LOG_DEBUG("\tType: %zu", std::to_underlying(type));
@@ -80,11 +89,11 @@ namespace LunaraEngine
             }
             // LOG_DEBUG("\tLocation: %zu", *result);
 
-            vkCmdBindDescriptorSets(buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, shader->GetPipelineLayout(),
-                                    static_cast<uint32_t>(*result), 1, &frameSets[rendererData->currentFrame], 0,
-                                    nullptr);
+            auto dynamicOffsets = shader->GetDynamicOffsets(type);
+            vkCmdBindDescriptorSets(buffer, bindPoint, shader->GetPipelineLayout(),
+                                    static_cast<uint32_t>(*result), 1, &frameSets[rendererData->currentFrame],
+                                    static_cast<uint32_t>(dynamicOffsets.size()), dynamicOffsets.data());
         }
-        shader->UpdateBufferDescriptorSets(rendererData->currentFrame);
     }
 
     void VulkanRendererCommand::DrawQuad(RendererDataType* rendererData, const RendererCommand* command)
@@ -163,18 +172,33 @@ namespace LunaraEngine
     void VulkanRendererCommand::DrawQuadBatch(RendererDataType* rendererData, const RendererCommand* command)
     {
         auto arg = static_cast<const RendererCommandDrawBatch*>(command);
+        auto shader = std::static_pointer_cast<VulkanShader>(arg->uploadList.GetShader().lock());
 
-
+        // Only the live range of each list is copied, the rest of the buffer is left as is
+        bool hasTransient = false;
         for (const auto& upload: arg->uploadList)
         {
-            const auto& [storageBuffer, data] = upload;
-            VulkanStorageBuffer* batchStorage = (VulkanStorageBuffer*) (storageBuffer);
-            auto size = data.size();
-            auto stride = batchStorage->GetStride();
-            batchStorage->Upload(data.data(), size, stride);
+            const auto& [storageBuffer, data, offset, binding] = upload;
+            if (data.empty()) { continue; }
+            if (shader && shader->IsTransient(binding))
+            {
+                if (!shader->UploadTransient(binding, data.data(), data.size(), offset)) { return; }
+                hasTransient = true;
+                continue;
+            }
+
+            // The list may have been built before the frame started, resolve the buffer of the recorded frame
+            VulkanStorageBuffer* batchStorage = (VulkanStorageBuffer*) (shader ? shader->GetBuffer(binding)
+                                                                               : storageBuffer);
+            // Persistent buffers are owned by compute passes, host data never overwrites them. Static buffers were
+            // already copied at the start of the frame by RecordStagedUploads
+            if (batchStorage == nullptr || batchStorage->IsDeviceLocal()) { continue; }
+            batchStorage->Upload(offset * batchStorage->GetStride(), data.data(), data.size(),
+                                 batchStorage->GetStride());
         }
 
         const auto& buffer = rendererData->commandPool->GetBuffer(rendererData->currentFrame);
+        if (hasTransient) { shader->BindTransientBuffers(buffer); }
 
         VkViewport viewport{};
         viewport.x = 0.0f;
@@ -190,21 +214,124 @@ namespace LunaraEngine
         scissor.extent = rendererData->surfaceExtent;
         vkCmdSetScissorWithCount(buffer, 1, &scissor);
 
+        if (arg->indirect && shader)
+        {
+            auto* indirectBuffer = (VulkanStorageBuffer*) shader->GetBuffer(arg->indirectBinding);
+            if (indirectBuffer == nullptr) { return; }
+            vkCmdDrawIndirect(buffer, indirectBuffer->GetHandle(), 0, 1, sizeof(VkDrawIndirectCommand));
+            return;
+        }
+
         vkCmdDraw(buffer, 6, (uint32_t) arg->count, 0, (uint32_t) arg->offset);
     }
 
+    void VulkanRendererCommand::RecordStagedUploads(RendererDataType* rendererData,
+                                                    std::span<const RendererCommand* const> commands)
+    {
+        std::vector<VulkanStorageBuffer*> stagedBuffers;
+        VkDeviceSize transientSize = 0;
+        const VkDeviceSize transientAlignment = rendererData->transientBuffer->GetAlignment();
+        for (const RendererCommand* command: commands)
+        {
+            if (command->GetType() != RendererCommandType::DrawQuadBatch) { continue; }
+
+            auto arg = static_cast<const RendererCommandDrawBatch*>(command);
+            auto shader = std::static_pointer_cast<VulkanShader>(arg->uploadList.GetShader().lock());
+            for (const auto& [storageBuffer, data, offset, binding]: arg->uploadList)
+            {
+                if (data.empty()) { continue; }
+                if (shader && shader->IsTransient(binding))
+                {
+                    VkDeviceSize size = shader->GetTransientUploadSize(binding, data.size(), offset);
+                    transientSize += (size + transientAlignment - 1) / transientAlignment * transientAlignment;
+                    continue;
+                }
+
+                VulkanStorageBuffer* batchStorage = (VulkanStorageBuffer*) (shader ? shader->GetBuffer(binding)
+                                                                                   : storageBuffer);
+                if (batchStorage == nullptr || !batchStorage->IsDeviceLocal() || batchStorage->IsPersistent())
+                {
+                    continue;
+                }
+
+                batchStorage->Stage(offset * batchStorage->GetStride(), data.data(), data.size(),
+                                    batchStorage->GetStride());
+                if (std::ranges::find(stagedBuffers, batchStorage) == stagedBuffers.end())
+                {
+                    stagedBuffers.push_back(batchStorage);
+                }
+            }
+        }
+
+        // Nothing was drawn from the transient buffer yet, a frame larger than the last ones grows it here instead
+        // of dropping draws until the next frame
+        rendererData->transientBuffer->Reserve(rendererData->currentFrame, transientSize);
+
+        // Copies cannot be recorded inside a render pass, they go ahead of every pass of the frame instead
+        VulkanStorageBuffer::RecordPendingCopies(rendererData->commandPool->GetBuffer(rendererData->currentFrame),
+                                                 stagedBuffers);
+    }
+
+    void VulkanRendererCommand::Dispatch(RendererDataType* rendererData, const RendererCommand* command)
+    {
+        auto arg = static_cast<const RendererCommandDispatch*>(command);
+        if (arg->groupCountX == 0 || arg->groupCountY == 0 || arg->groupCountZ == 0) { return; }
+
+        const auto& buffer = rendererData->commandPool->GetBuffer(rendererData->currentFrame);
+        vkCmdDispatch(buffer, arg->groupCountX, arg->groupCountY, arg->groupCountZ);
+
+        // Results are consumed as draw parameters and as vertex shader inputs of the following passes
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+        vkCmdPipelineBarrier(buffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT |
+                                     VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0, 1, &barrier, 0, nullptr, 0, nullptr);
+    }
+
+    void VulkanRendererCommand::FillBuffer(RendererDataType* rendererData, const RendererCommand* command)
+    {
+        auto arg = static_cast<const RendererCommandFillBuffer*>(command);
+        auto* storage = (VulkanStorageBuffer*) (arg->shader ? arg->shader->GetBuffer(arg->binding) : nullptr);
+        if (storage == nullptr) { return; }
+
+        const auto& buffer = rendererData->commandPool->GetBuffer(rendererData->currentFrame);
+
+        // Persistent buffers may still be read by the draws of the previous frame
+        if (storage->IsPersistent())
+        {
+            vkCmdPipelineBarrier(buffer,
+                                 VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT |
+                                         VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                                 VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 0, nullptr);
+        }
+        vkCmdFillBuffer(buffer, storage->GetHandle(), arg->offset, arg->size, arg->value);
+
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+        vkCmdPipelineBarrier(buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1,
+                             &barrier, 0, nullptr, 0, nullptr);
+    }
+
     void VulkanRendererCommand::BeginRenderPass(RendererDataType* rendererData, const RendererCommand* command)
     {
         (void) command;
         const auto& buffer = rendererData->commandPool->GetBuffer(rendererData->currentFrame);
-        buffer.BeginRecording();
         VkRenderPassBeginInfo renderPassInfo = {};
         renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
         renderPassInfo.framebuffer = rendererData->swapChain->GetFrameBuffer(rendererData->imageIndex);
         renderPassInfo.renderArea.offset = {0, 0};
         renderPassInfo.renderArea.extent = rendererData->surfaceExtent;
-        renderPassInfo.clearValueCount = 1;
-        renderPassInfo.pClearValues = &rendererData->clearValue;
+        // Depth clears to the far plane, anything drawn in front of it passes the first test
+        std::array<VkClearValue, 2> clearValues{};
+        clearValues[0] = rendererData->clearValue;
+        clearValues[1].depthStencil = {1.0f, 0};
+        renderPassInfo.clearValueCount = rendererData->swapChain->HasDepthAttachment() ? 2 : 1;
+        renderPassInfo.pClearValues = clearValues.data();
         renderPassInfo.renderPass = rendererData->swapChain->GetRenderPass();
         vkCmdBeginRenderPass(buffer, &renderPassInfo, VK_SUBPASS_CONTENTS_INLINE);
     }
@@ -228,8 +355,14 @@ namespace LunaraEngine
 
         vkResetFences(rendererData->device, 1, &(rendererData->inFlightFence[rendererData->currentFrame]));
 
+        // The fence has signaled, transient allocations of this frame can be reused
+        rendererData->transientBuffer->Reset(rendererData->currentFrame);
+
         vkResetCommandBuffer(rendererData->commandPool->GetBuffer(rendererData->currentFrame),
                              /*VkCommandBufferResetFlagBits*/ 0);
+
+        // Recording starts here so compute and transfer work can be issued before the render pass begins
+        rendererData->commandPool->GetBuffer(rendererData->currentFrame).BeginRecording();
     }
 
     void VulkanRendererCommand::Present(RendererDataType* rendererData, const RendererCommand* command)
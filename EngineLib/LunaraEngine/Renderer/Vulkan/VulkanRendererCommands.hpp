@@ -40,6 +40,7 @@
 Includes
 ***********************************************************************************************************************/
 #include "VulkanDataTypes.hpp"
+#include <span>
 
 namespace LunaraEngine
 {
@@ -57,11 +58,16 @@ namespace LunaraEngine
         static void DrawIndexed(RendererDataType* rendererData, const RendererCommand* command);
         static void DrawInstanced(RendererDataType* rendererData, const RendererCommand* command);
         static void DrawQuadBatch(RendererDataType* rendererData, const RendererCommand* command);
+        static void Dispatch(RendererDataType* rendererData, const RendererCommand* command);
+        static void FillBuffer(RendererDataType* rendererData, const RendererCommand* command);
         static void BeginRenderPass(RendererDataType* rendererData, const RendererCommand* command);
         static void EndRenderPass(RendererDataType* rendererData, const RendererCommand* command);
         static void BeginFrame(RendererDataType* rendererData, const RendererCommand* command);
         static void Present(RendererDataType* rendererData, const RendererCommand* command);
         static void Nop(RendererDataType* rendererData, const RendererCommand* command);
+        // Writes the uploads into static buffers to their staging copies and records the copies into the frame
+        static void RecordStagedUploads(RendererDataType* rendererData,
+                                        std::span<const RendererCommand* const> commands);
     };
 
 }// namespace LunaraEngine
\ No newline at end of file
@@ -10,16 +10,27 @@ layout(set = 0, binding = 0) uniform UniformBuffer
     mat4 view;
     mat4 projection;
     float zoom;
+    float time;
 }
 
 ubo;
 
-layout(set = 0, binding = 1) readonly buffer positionBuffer { vec3 positions[]; };
+layout(set = 0, binding = 1) readonly buffer positionBuffer { vec4 positions[]; };
 
 layout(set = 0, binding = 2) readonly buffer sizeBuffer { vec2 sizes[]; };
 
 layout(set = 0, binding = 3) readonly buffer textureIndexBuffer { uint textureIndices[]; };
 
+struct Animation
+{
+    uint startFrame;
+    uint frameCount;
+    float fps;
+    float startTime;
+};
+
+layout(set = 0, binding = 4) readonly buffer animationBuffer { Animation animations[]; };
+
 uint getVertexID() { return gl_VertexIndex % 6u; }
 
 uint getCurrentQuadIndex() { return gl_InstanceIndex; }
@@ -47,12 +58,24 @@ vec2 getTextureCoord(uint vertexID)
     return vertices[vertexID];
 }
 
+uint getTextureNumber(uint quadIndex)
+{
+    Animation animation = animations[quadIndex];
+    if (animation.frameCount == 0u) { return textureIndices[quadIndex]; }
+
+    // Frames sit in consecutive texture slots, before its start time the animation holds the first one
+    uint frame = uint(max(ubo.time - animation.startTime, 0.0) * animation.fps);
+    return animation.startFrame + frame % animation.frameCount;
+}
+
 void main()
 {
     uint index = getCurrentQuadIndex();
     vec4 outPosition = ubo.projection * ubo.view * ubo.model * vec4(getVertex(getVertexID(), index), 0.0, 1.0);
+    // w carries the depth of sorted quads, zero keeps unsorted quads in front of everything
+    outPosition.z = positions[index].w * outPosition.w;
     gl_Position = outPosition;
     fragColor = vec3(0, 0, 0);
     outTexCoords = getTextureCoord(getVertexID());
-    textureNumber = uint(textureIndices[index]);
+    textureNumber = getTextureNumber(index);
 }
\ No newline at end of file
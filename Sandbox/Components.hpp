@@ -0,0 +1,23 @@
+#pragma once
+#include <LunaraEngine/Core/CommonTypes.hpp>
+
+// Collision layers of the sandbox colliders
+enum CollisionLayer : u32
+{
+    COLLISION_LAYER_PLAYER = 1 << 0,
+    COLLISION_LAYER_WALL = 1 << 1,
+    COLLISION_LAYER_PICKUP = 1 << 2,
+    COLLISION_LAYER_ENEMY = 1 << 3,
+};
+
+// Walks between two x coordinates
+struct Patrol {
+    f32 minX{};
+    f32 maxX{};
+    f32 speed{};
+};
+
+// Velocity comes from the keyboard
+struct PlayerInput {
+    f32 speed{};
+};
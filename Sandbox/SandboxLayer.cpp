@@ -3,6 +3,7 @@
 #include <glm/ext/matrix_transform.hpp>
 #include <glm/ext/matrix_clip_space.hpp>
 #include <print>
+#include <algorithm>
 
 void SandboxLayer::Init(const LunaraEngine::ApplicationConfig& config)
 {
@@ -36,19 +37,64 @@ void SandboxLayer::Init(const LunaraEngine::ApplicationConfig& config)
     batch_renderer_sprites.push_back(wall_sprite);
 
     m_BatchRenderer = std::make_shared<BatchRenderer>();
-    m_BatchRenderer->Create(config, batch_renderer_sprites);
+    m_BatchRenderer->Create(config, batch_renderer_sprites, QuadInstanceFormat::Separate);
+    m_BatchRenderer->EnableCulling(64.0f);
+    m_BatchRenderer->EnableSorting();
 
-    m_Player.SetAnimationFrameCount((u32) sonic_walking_sprites.size());
-    m_Player.SetSpriteSheetIndex((u32) coin_sprites.size());
+    // Flipbooks step at 10 frames per second
+    constexpr f32 animationFps = 10.0f;
+    const u32 playerFirstFrame = (u32) coin_sprites.size();
+    const u32 enemyFirstFrame = playerFirstFrame + (u32) sonic_walking_sprites.size();
+    const u32 wallTexture = (u32) batch_renderer_sprites.size() - 1;
 
-    m_Enemy.SetAnimationFrameCount((u32) enemy_sprites.size());
-    m_Enemy.SetSpriteSheetIndex((u32) sonic_walking_sprites.size() + (u32) coin_sprites.size());
+    // Moving entities are simulated at the fixed tick and drawn between their last two positions
+    m_Player = m_World.CreateEntity(
+            Transform{{500.0f, 450.0f, 0.0f}}, PreviousTransform{{500.0f, 450.0f, 0.0f}}, Velocity{},
+            Sprite{{200.0f, 200.0f}, 0, {playerFirstFrame, (u32) sonic_walking_sprites.size(), animationFps, 0.0f}},
+            Collider{{}, {200.0f, 200.0f}, COLLISION_LAYER_PLAYER, COLLISION_LAYER_WALL}, PlayerInput{1000.0f});
 
-    m_Wall.SetSpriteSheetIndex((u32) batch_renderer_sprites.size() - 1);
+    m_World.CreateEntity(Transform{{100.0f, 0.0f, 0.0f}}, PreviousTransform{{100.0f, 0.0f, 0.0f}},
+                         Velocity{{100.0f, 0.0f}},
+                         Sprite{{100.0f, 100.0f}, 0, {enemyFirstFrame, (u32) enemy_sprites.size(), animationFps, 0.0f}},
+                         Collider{{}, {100.0f, 100.0f}, COLLISION_LAYER_ENEMY, COLLISION_LAYER_PLAYER},
+                         Patrol{0.0f, 200.0f, 100.0f});
 
-    m_Coin.SetSpriteSheetIndex(0);
-    m_Coin.SetAnimationFrameCount((u32) coin_sprites.size());
-    // ParticleSystem::Create(config);
+    m_World.CreateEntity(Transform{{400.0f, 400.0f, 0.0f}},
+                         Sprite{{50.0f, 50.0f}, 0, {0, (u32) coin_sprites.size(), animationFps, 0.0f}},
+                         Collider{{}, {50.0f, 50.0f}, COLLISION_LAYER_PICKUP, COLLISION_LAYER_PLAYER});
+
+    // The wall never moves, it is drawn as a retained sprite and only takes part in collisions
+    const glm::vec3 wallPosition{250.0f, 250.0f, 0.0f};
+    const glm::vec2 wallSize{100.0f, 50.0f};
+    m_World.CreateEntity(Transform{wallPosition}, Collider{{}, wallSize, COLLISION_LAYER_WALL, COLLISION_LAYER_PLAYER});
+    m_WallSprite = m_BatchRenderer->CreateSprite(wallPosition, wallSize, wallTexture);
+
+    // Ground strip on the first layer and a wall border around the map on the second one
+    std::vector<std::wstring_view> tile_sprites = {L"world_tileset_sprites/world_tileset_r0_c0.png",
+                                                   L"world_tileset_sprites/world_tileset_r1_c0.png", wall_sprite};
+    constexpr u32 mapSize = 256;
+    constexpr u32 groundRow = 20;
+    m_TileMap = std::make_shared<TileMap>(config, tile_sprites, mapSize, mapSize, 32.0f, 2);
+    for (u32 x = 0; x < mapSize; x++)
+    {
+        m_TileMap->SetTile(0, x, groundRow, 1);
+        for (u32 y = groundRow + 1; y < mapSize; y++) { m_TileMap->SetTile(0, x, y, 2); }
+
+        m_TileMap->SetTile(1, x, 0, 3);
+        m_TileMap->SetTile(1, x, mapSize - 1, 3);
+        m_TileMap->SetTile(1, 0, x, 3);
+        m_TileMap->SetTile(1, mapSize - 1, x, 3);
+    }
+
+    // Only the border walls block movement, the ground is drawn behind the entities
+    m_TileCollision.Create(mapSize, mapSize, 32.0f);
+    m_TileCollision.SetSolid(0, 0, mapSize, 1, true);
+    m_TileCollision.SetSolid(0, mapSize - 1, mapSize, 1, true);
+    m_TileCollision.SetSolid(0, 0, 1, mapSize, true);
+    m_TileCollision.SetSolid(mapSize - 1, 0, 1, mapSize, true);
+
+    // Particles are simulated by a compute pass and drawn straight from device memory
+    ParticleSystem::Create(config, ParticleSimulation::GPU);
 }
 
 void SandboxLayer::Destroy()
@@ -58,48 +104,56 @@ void SandboxLayer::Destroy()
     //m_BatchRenderer->Destroy();
 }
 
+void SandboxLayer::OnFixedUpdate(float dt)
+{
+    using namespace LunaraEngine;
+
+    Systems::StorePreviousTransforms(m_World);
+    UpdatePlayerInput();
+    UpdatePatrols();
+    Systems::Move(m_World, dt);
+    ResolveTileCollisions(dt);
+    ResolveWallCollisions();
+}
+
 void SandboxLayer::OnUpdate(float dt)
 {
     using namespace LunaraEngine;
 
-    // ParticleSystem::GetInstance()->Update(dt);
+    ParticleSystem::GetInstance()->Update(dt);
 
     Renderer::Clear(Color4{0.0f, 0.0f, 0.0f, 1.0f});
 
+    // Compute work has to be recorded outside of the render pass
+    Renderer::CullRetainedSprites(m_BatchRenderer, m_Camera);
+    ParticleSystem::Simulate();
+
     Renderer::BeginRenderPass();
     elapsedTime += dt;
-    m_PlayerDt = dt;
-
-    m_Coin.Draw(m_BatchRenderer);
-    m_Player.Draw(m_BatchRenderer);
-    m_Enemy.Draw(m_BatchRenderer);
-    m_Wall.Draw(m_BatchRenderer);
-    if (m_Collider.AABB(m_Player.GetPosition(), m_Player.GetEntity().width, m_Player.GetEntity().height,
-                        m_Wall.GetPosition(), m_Wall.GetWallSize().width, m_Wall.GetWallSize().height))
+
+    m_BatchRenderer->SetCullRect(m_Camera);
+    m_BatchRenderer->SetTime(elapsedTime);
+    Systems::DrawSprites(m_World, *m_BatchRenderer, Application::GetInterpolationAlpha());
+
+    auto tileMapShader = m_TileMap->GetShader();
+    if (!tileMapShader.expired())
     {
-        if (m_Player.GetDirection() == static_cast<u32>(FacingDirection::Down))
-        {
-            m_Player.SetPosition(m_Player.GetPosition() - glm::vec3{0.0f, 1.0f, 0.0f});
-        }
-        if(m_Player.GetDirection() == static_cast<u32>(FacingDirection::Up))
-        {
-            m_Player.SetPosition(m_Player.GetPosition() - glm::vec3{0.0f, -1.0f, 0.0f});
-        }
-           if (m_Player.GetDirection() == static_cast<u32>(FacingDirection::Left))
-        {
-            m_Player.SetPosition(m_Player.GetPosition() - glm::vec3{-1.0f, 0.0f, 0.0f});
-        }
-        if(m_Player.GetDirection() == static_cast<u32>(FacingDirection::Right))
-        {
-            m_Player.SetPosition(m_Player.GetPosition() - glm::vec3{1.0f, 0.0f, 0.0f});
-        }
+        auto shaderPtr = tileMapShader.lock().get();
+        Renderer::BindShader(shaderPtr, (void*) nullptr);
+        m_Camera.Upload(shaderPtr);
+
+        Renderer::DrawTileMap(m_TileMap, m_Camera);
     }
-    // if (m_PlayerCollider.Intersection()) { m_Player.SetPlayerColor({1.0f, 0.0f, 0.0f, 1.0f}); }
-    // else { m_Player.SetPlayerColor({1.0f, 1.0f, 1.0f, 1.0f}); }
 
-    if (m_Enemy.HasReachedPointX(m_Enemy.GetPosition().x, 200.0f)) { dir = -1.0f; }
-    if (m_Enemy.HasReachedPointX(m_Enemy.GetPosition().x, 0.0f)) { dir = 1.0f; }
-    m_Enemy.Move(dir * 1.0f, 0.0f, 0.0f, dt);
+    auto retainedShader = m_BatchRenderer->GetRetainedShader();
+    if (!retainedShader.expired())
+    {
+        auto shaderPtr = retainedShader.lock().get();
+        Renderer::BindShader(shaderPtr, (void*) nullptr);
+        m_Camera.Upload(shaderPtr);
+
+        Renderer::DrawRetainedSprites(m_BatchRenderer);
+    }
 
     auto shader = m_BatchRenderer->GetShader();
     if (!shader.expired())
@@ -111,53 +165,30 @@ void SandboxLayer::OnUpdate(float dt)
         Renderer::DrawQuadBatch(m_BatchRenderer);
     }
 
-    // auto particleShader = ParticleSystem::GetShader();
-    // if (!particleShader.expired())
-    // {
-    //     auto shaderPtr = particleShader.lock().get();
-    //     Renderer::BindShader(shaderPtr, (void*) nullptr);
-    //     m_Camera.Upload(shaderPtr);
-    //     Renderer::PushCommand(ParticleSystem::CreateDrawCommand());
-    // }
+    auto particleShader = ParticleSystem::GetShader();
+    if (!particleShader.expired())
+    {
+        auto shaderPtr = particleShader.lock().get();
+        Renderer::BindShader(shaderPtr, (void*) nullptr);
+        m_Camera.Upload(shaderPtr);
+        Renderer::PushCommand(ParticleSystem::CreateDrawCommand());
+    }
 
     Renderer::EndRenderPass();
 
     //Flush command buffer for drawing
     Renderer::Flush();
 
-    m_Player.UpdateAnimation(dt);
-    m_Coin.UpdateAnimation(dt);
-    m_Enemy.UpdateAnimation(dt);
-
     //Play audio test
     if (!LunaraEngine::AudioManager::IsAudioPlaying("AudioTest"))
     {
         LunaraEngine::AudioManager::PlayAudio("AudioTest");
     }
 
-    if (m_PressedKeys[KEY_W])
-    {
-        m_Player.Move(0.0f, -1.0f, 0.0f, dt);
-        m_Player.SetDirection(FacingDirection::Up);
-    }
-    if (m_PressedKeys[KEY_S])
-    {
-        m_Player.Move(0.0f, 1.0f, 0.0f, dt);
-        m_Player.SetDirection(FacingDirection::Down);
-    }
-    if (m_PressedKeys[KEY_A])
-    {
-        m_Player.Move(-1.0f, 0.0f, 0.0f, dt);
-        m_Player.SetDirection(FacingDirection::Left);
-    }
-    if (m_PressedKeys[KEY_D])
-    {
-        m_Player.Move(1.0f, 0.0f, 0.0f, dt);
-        m_Player.SetDirection(FacingDirection::Right);
-    }
     if (m_PressedKeys[KEY_O])
     {
-        LOG_INFO("PlayerDirection: %f %f", m_Player.GetPosition().x, m_Player.GetPosition().y);
+        const glm::vec3& position = m_World.GetComponent<Transform>(m_Player)->position;
+        LOG_INFO("PlayerPosition: %f %f", position.x, position.y);
     }
     if (m_PressedKeys[KEY_L])
     {
@@ -174,6 +205,97 @@ void SandboxLayer::OnUpdate(float dt)
     else if (m_PressedKeys[KEY_F]) { LOG_INFO("FPS: %f", 1.0f / dt); }
 }
 
+void SandboxLayer::UpdatePlayerInput()
+{
+    using namespace LunaraEngine;
+
+    glm::vec2 direction{};
+    if (m_PressedKeys[KEY_W]) { direction.y -= 1.0f; }
+    if (m_PressedKeys[KEY_S]) { direction.y += 1.0f; }
+    if (m_PressedKeys[KEY_A]) { direction.x -= 1.0f; }
+    if (m_PressedKeys[KEY_D]) { direction.x += 1.0f; }
+
+    m_World.ForEach<Velocity, const PlayerInput>([direction](Entity, Velocity& velocity, const PlayerInput& input) {
+        velocity.value = direction * input.speed;
+    });
+}
+
+void SandboxLayer::UpdatePatrols()
+{
+    using namespace LunaraEngine;
+
+    m_World.ForEach<const Transform, Velocity, const Patrol>(
+            [](Entity, const Transform& transform, Velocity& velocity, const Patrol& patrol) {
+                if (transform.position.x >= patrol.maxX) { velocity.value.x = -patrol.speed; }
+                else if (transform.position.x <= patrol.minX) { velocity.value.x = patrol.speed; }
+            });
+}
+
+void SandboxLayer::ResolveTileCollisions(float dt)
+{
+    using namespace LunaraEngine;
+
+    // The move is replayed from the previous position so fast movers stop at the first wall tile on their way
+    m_World.ForEach<Transform, const Velocity, const Collider>(
+            [this, dt](Entity, Transform& transform, const Velocity& velocity, const Collider& collider) {
+                if ((collider.mask & COLLISION_LAYER_WALL) == 0) { return; }
+
+                glm::vec2 displacement = velocity.value * dt;
+                Transform previous{transform.position - glm::vec3(displacement, 0.0f)};
+                TileSweepResult result =
+                        m_TileCollision.Sweep(AABB::FromRect(collider.GetBounds(previous)), displacement);
+                transform.position = previous.position + glm::vec3(result.displacement, 0.0f);
+            });
+}
+
+void SandboxLayer::ResolveWallCollisions()
+{
+    using namespace LunaraEngine;
+
+    // All colliders go through the broadphase, only the pairs it reports are tested against each other
+    m_ColliderEntities.clear();
+    m_ColliderBounds.clear();
+    m_ColliderLayers.clear();
+    m_ColliderMasks.clear();
+    m_World.ForEach<const Transform, const Collider>(
+            [this](Entity entity, const Transform& transform, const Collider& collider) {
+                m_ColliderEntities.push_back(entity);
+                m_ColliderBounds.push_back(collider.GetBounds(transform));
+                m_ColliderLayers.push_back(collider.layer);
+                m_ColliderMasks.push_back(collider.mask);
+            });
+    m_Broadphase.Clear();
+    m_Broadphase.Insert(m_ColliderBounds, m_ColliderLayers, m_ColliderMasks);
+    m_Broadphase.FindPairs(m_CollisionPairs);
+
+    // Moving colliders are pushed out of the walls along the axis of the smallest overlap
+    for (const BroadphasePair& pair: m_CollisionPairs)
+    {
+        Entity mover = m_ColliderEntities[pair.a];
+        Entity wall = m_ColliderEntities[pair.b];
+        if ((m_ColliderLayers[pair.b] & COLLISION_LAYER_WALL) == 0) { std::swap(mover, wall); }
+
+        auto* wallCollider = m_World.GetComponent<Collider>(wall);
+        auto* collider = m_World.GetComponent<Collider>(mover);
+        if ((wallCollider->layer & COLLISION_LAYER_WALL) == 0 || (collider->mask & COLLISION_LAYER_WALL) == 0 ||
+            !m_World.HasComponent<Velocity>(mover))
+        {
+            continue;
+        }
+
+        // The mover may already have been pushed by another wall this frame
+        Transform& transform = *m_World.GetComponent<Transform>(mover);
+        FRect a = collider->GetBounds(transform);
+        FRect b = wallCollider->GetBounds(*m_World.GetComponent<Transform>(wall));
+        f32 overlapX = std::min(a.x + a.w, b.x + b.w) - std::max(a.x, b.x);
+        f32 overlapY = std::min(a.y + a.h, b.y + b.h) - std::max(a.y, b.y);
+        if (overlapX <= 0.0f || overlapY <= 0.0f) { continue; }
+
+        if (overlapX < overlapY) { transform.position.x += a.x + a.w * 0.5f < b.x + b.w * 0.5f ? -overlapX : overlapX; }
+        else { transform.position.y += a.y + a.h * 0.5f < b.y + b.h * 0.5f ? -overlapY : overlapY; }
+    }
+}
+
 void SandboxLayer::OnMouseMoveEvent(uint32_t width, uint32_t height)
 {
     this->x = width;
@@ -1,10 +1,7 @@
 #pragma once
 
 #include <LunaraEngine/Engine.hpp>
-#include <Entities/Player/Player.hpp>
-#include <Entities/Coin/Coin.hpp>
-#include <Entities/Enemies/Enemy.hpp>
-#include <StaticEntities/Wall.hpp>
+#include "Components.hpp"
 #include <vector>
 
 class SandboxLayer: public LunaraEngine::Layer
@@ -19,6 +16,8 @@ public:
 
     virtual void OnAttach() override {}
 
+    virtual void OnFixedUpdate(float dt) override;
+
     virtual void OnUpdate(float dt) override;
 
     virtual void OnDetach() override {}
@@ -47,25 +46,35 @@ public:
 
     virtual void End() override {}
 
+private:
+    void UpdatePlayerInput();
+    void UpdatePatrols();
+    void ResolveTileCollisions(float dt);
+    void ResolveWallCollisions();
+
 private:
     LunaraEngine::Window* m_Window;
     LunaraEngine::Font m_Font;
     uint32_t x{}, y{};
 
-    Player m_Player = {{500.0f, 450.0f, 0.0f}, {200.0f, 200.0f}, FacingDirection::Down};
-    Enemy m_Enemy = {{100.0f, 0.0f, 0.0f}, {100.0f, 100.0f}, FacingDirection::Right};
-    Coin m_Coin = {{400.0f, 400.0f, 0.0f}, {50.0f, 50.0f}, FacingDirection::Down};
-    Wall m_Wall = {{250.0f, 250.0f, 0.0f}, {100.0f, 50.0f}};
+    LunaraEngine::World m_World;
+    LunaraEngine::Entity m_Player{};
+    LunaraEngine::SpriteHandle m_WallSprite{};
 
-    LunaraEngine::RectCollisions m_Collider;
+    LunaraEngine::SpatialHash m_Broadphase{128.0f};
+    std::vector<LunaraEngine::Entity> m_ColliderEntities;
+    std::vector<LunaraEngine::FRect> m_ColliderBounds;
+    std::vector<u32> m_ColliderLayers;
+    std::vector<u32> m_ColliderMasks;
+    std::vector<LunaraEngine::BroadphasePair> m_CollisionPairs;
     LunaraEngine::Camera m_Camera = {{1280.0f, 720.0f, 0}};
     float zoom{1.0f};
     std::map<uint32_t, uint8_t> m_PressedKeys{};
 
     std::shared_ptr<LunaraEngine::Shader> m_BatchQuadShader;
     std::shared_ptr<LunaraEngine::BatchRenderer> m_BatchRenderer;
+    std::shared_ptr<LunaraEngine::TileMap> m_TileMap;
+    LunaraEngine::TileCollisionLayer m_TileCollision;
 
     float elapsedTime{};
-    float m_PlayerDt{};
-    f32 dir = 1.0f;
 };
\ No newline at end of file
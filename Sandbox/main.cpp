@@ -11,6 +11,7 @@ int main()
             .windowName = "Example Game",
             .initialWidth = 1280,
             .initialHeight = 720,
+            .fixedTickRate = 60,
     });
     LunaraEngine::LayerStack::PushLayer<SandboxLayer>("Sandbox");
     LunaraEngine::Application::Run();
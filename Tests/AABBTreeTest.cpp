@@ -0,0 +1,262 @@
+#include <LunaraEngine/Physics/AABBTree.hpp>
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace LunaraEngine;
+
+namespace
+{
+    constexpr size_t STEP_COUNT = 6000;
+    constexpr size_t QUERIES_PER_STEP = 4;
+    constexpr float WORLD_EXTENT = 1000.0f;
+
+    bool s_Failed = false;
+
+    void Check(bool condition, const char* message)
+    {
+        if (condition) { return; }
+        std::printf("FAILED: %s\n", message);
+        s_Failed = true;
+    }
+
+    struct Proxy {
+        uint32_t id{};
+        AABB bounds{};
+    };
+
+    class Scene
+    {
+    public:
+        explicit Scene(uint32_t seed) : m_Random(seed) {}
+
+    public:
+        float Uniform(float min, float max) { return std::uniform_real_distribution<float>(min, max)(m_Random); }
+
+        size_t Index(size_t count) { return std::uniform_int_distribution<size_t>(0, count - 1)(m_Random); }
+
+        AABB MakeBox(float maxSize)
+        {
+            glm::vec2 min{Uniform(-WORLD_EXTENT, WORLD_EXTENT), Uniform(-WORLD_EXTENT, WORLD_EXTENT)};
+            return AABB{min, min + glm::vec2{Uniform(0.5f, maxSize), Uniform(0.5f, maxSize)}};
+        }
+
+    private:
+        std::mt19937 m_Random;
+    };
+
+    // The tree answers for the fat boxes, so brute force runs over the fat boxes it reports for every proxy
+    std::vector<uint32_t> QueryBruteForce(const AABBTree& tree, const std::vector<Proxy>& proxies, const AABB& box)
+    {
+        std::vector<uint32_t> found;
+        for (const auto& proxy: proxies)
+        {
+            if (tree.GetFatBounds(proxy.id).Overlaps(box)) { found.push_back(proxy.id); }
+        }
+        std::ranges::sort(found);
+        return found;
+    }
+
+    std::vector<uint32_t> Query(const AABBTree& tree, const AABB& box)
+    {
+        std::vector<uint32_t> found;
+        tree.Query(box, [&](uint32_t proxy) {
+            found.push_back(proxy);
+            return true;
+        });
+        std::ranges::sort(found);
+        return found;
+    }
+
+    // Every proxy the segment passes through, the callback never clips the ray
+    std::vector<uint32_t> RayCast(const AABBTree& tree, glm::vec2 origin, glm::vec2 translation)
+    {
+        std::vector<uint32_t> found;
+        tree.RayCast(origin, translation, [&](uint32_t proxy, float maxFraction) {
+            found.push_back(proxy);
+            return maxFraction;
+        });
+        std::ranges::sort(found);
+        return found;
+    }
+
+    // Clipping the ray to every hit has to end at the closest one
+    float RayCastClosest(const AABBTree& tree, glm::vec2 origin, glm::vec2 translation)
+    {
+        glm::vec2 inverse = glm::vec2(1.0f) / translation;
+        float closest = 1.0f;
+        tree.RayCast(origin, translation, [&](uint32_t proxy, float maxFraction) {
+            float fraction = AABBTree::IntersectSegment(tree.GetFatBounds(proxy), origin, inverse, maxFraction);
+            if (fraction >= 0.0f) { closest = std::min(closest, fraction); }
+            return fraction;
+        });
+        return closest;
+    }
+
+    void RayCastBruteForce(const AABBTree& tree, const std::vector<Proxy>& proxies, glm::vec2 origin,
+                           glm::vec2 translation, std::vector<uint32_t>& found, float& closest)
+    {
+        glm::vec2 inverse = glm::vec2(1.0f) / translation;
+        found.clear();
+        closest = 1.0f;
+        for (const auto& proxy: proxies)
+        {
+            float fraction = AABBTree::IntersectSegment(tree.GetFatBounds(proxy.id), origin, inverse, 1.0f);
+            if (fraction < 0.0f) { continue; }
+            found.push_back(proxy.id);
+            closest = std::min(closest, fraction);
+        }
+        std::ranges::sort(found);
+    }
+
+    // A tree balanced by rotations stays within a small factor of the optimal height
+    bool IsLogarithmic(const AABBTree& tree)
+    {
+        auto optimal = (int32_t) std::bit_width(tree.GetProxyCount());
+        return tree.GetHeight() <= 2 * optimal + 1;
+    }
+
+    void CheckTree(const AABBTree& tree, const std::vector<Proxy>& proxies, Scene& scene, bool& queriesMatch,
+                   bool& raysMatch, bool& closestMatches)
+    {
+        std::vector<uint32_t> found;
+        float closest{};
+        for (size_t i = 0; i < QUERIES_PER_STEP; i++)
+        {
+            AABB box = scene.MakeBox(200.0f);
+            queriesMatch = queriesMatch && Query(tree, box) == QueryBruteForce(tree, proxies, box);
+
+            // Axis aligned rays take the branch of the slab test that only checks the origin
+            glm::vec2 origin{scene.Uniform(-WORLD_EXTENT, WORLD_EXTENT), scene.Uniform(-WORLD_EXTENT, WORLD_EXTENT)};
+            glm::vec2 translation{scene.Uniform(-800.0f, 800.0f), scene.Uniform(-800.0f, 800.0f)};
+            if (i == 1) { translation.x = 0.0f; }
+            if (i == 2) { translation.y = 0.0f; }
+
+            RayCastBruteForce(tree, proxies, origin, translation, found, closest);
+            raysMatch = raysMatch && RayCast(tree, origin, translation) == found;
+            closestMatches = closestMatches && RayCastClosest(tree, origin, translation) == closest;
+        }
+    }
+
+    // Proxies are created, moved and destroyed at random, every step is checked against brute force
+    void TestRandomOperations()
+    {
+        Scene scene(4321);
+        AABBTree tree;
+        std::vector<Proxy> proxies;
+
+        bool queriesMatch = true;
+        bool raysMatch = true;
+        bool closestMatches = true;
+        bool fatContainsBounds = true;
+        bool balanced = true;
+        bool countMatches = true;
+        for (size_t step = 0; step < STEP_COUNT; step++)
+        {
+            float operation = scene.Uniform(0.0f, 1.0f);
+            // Grows the tree for the first half and shrinks it for the second so both paths see a large tree
+            float createShare = step < STEP_COUNT / 2 ? 0.5f : 0.2f;
+            if (proxies.empty() || operation < createShare)
+            {
+                AABB bounds = scene.MakeBox(60.0f);
+                proxies.push_back({tree.CreateProxy(bounds, (uint32_t) step), bounds});
+            }
+            else if (operation < 0.75f)
+            {
+                // Most proxies drift inside their fat box, some jump across the world
+                Proxy& proxy = proxies[scene.Index(proxies.size())];
+                glm::vec2 displacement{scene.Uniform(-3.0f, 3.0f), scene.Uniform(-3.0f, 3.0f)};
+                if (operation < createShare + 0.05f) { displacement *= 200.0f; }
+                proxy.bounds.min += displacement;
+                proxy.bounds.max += displacement;
+                tree.MoveProxy(proxy.id, proxy.bounds, displacement);
+            }
+            else
+            {
+                size_t index = scene.Index(proxies.size());
+                tree.DestroyProxy(proxies[index].id);
+                proxies[index] = proxies.back();
+                proxies.pop_back();
+            }
+
+            for (const auto& proxy: proxies)
+            {
+                fatContainsBounds = fatContainsBounds && tree.GetFatBounds(proxy.id).Contains(proxy.bounds);
+            }
+            balanced = balanced && IsLogarithmic(tree);
+            countMatches = countMatches && tree.GetProxyCount() == proxies.size();
+            CheckTree(tree, proxies, scene, queriesMatch, raysMatch, closestMatches);
+        }
+
+        Check(queriesMatch, "queries differ from brute force");
+        Check(raysMatch, "ray casts differ from brute force");
+        Check(closestMatches, "clipped ray casts did not end at the closest hit");
+        Check(fatContainsBounds, "fat box does not contain the proxy bounds");
+        Check(balanced, "tree height is not logarithmic in the proxy count");
+        Check(countMatches, "proxy count differs from the live proxies");
+    }
+
+    // Proxies inserted in sorted order are the worst case for an unbalanced tree
+    void TestSortedInsertion()
+    {
+        AABBTree tree(0.0f);
+        bool balanced = true;
+        for (uint32_t i = 0; i < 4096; i++)
+        {
+            float x = (float) i * 2.0f;
+            tree.CreateProxy(AABB{{x, 0.0f}, {x + 1.0f, 1.0f}}, i);
+            balanced = balanced && IsLogarithmic(tree);
+        }
+        Check(balanced, "tree height is not logarithmic for sorted insertion");
+    }
+
+    bool Throws(auto&& function)
+    {
+        try
+        {
+            function();
+        }
+        catch (const std::runtime_error&)
+        {
+            return true;
+        }
+        return false;
+    }
+
+    // Inner nodes, free nodes and indices past the node array are rejected instead of corrupting the tree
+    void TestInvalidProxy()
+    {
+        AABBTree tree;
+        uint32_t a = tree.CreateProxy(AABB{{0.0f, 0.0f}, {1.0f, 1.0f}}, 0);
+        uint32_t b = tree.CreateProxy(AABB{{5.0f, 0.0f}, {6.0f, 1.0f}}, 1);
+
+        bool rejected = true;
+        for (uint32_t node = 0; node < 8; node++)
+        {
+            if (node == a || node == b) { continue; }
+            rejected = rejected && Throws([&]() { tree.DestroyProxy(node); });
+            rejected = rejected && Throws([&]() { tree.MoveProxy(node, AABB{{0.0f, 0.0f}, {1.0f, 1.0f}}); });
+        }
+        Check(rejected, "a node that is not a proxy was accepted");
+
+        tree.DestroyProxy(a);
+        Check(Throws([&]() { tree.MoveProxy(a, AABB{{0.0f, 0.0f}, {1.0f, 1.0f}}); }),
+              "moving a destroyed proxy did not throw");
+        Check(tree.GetProxyCount() == 1 && Query(tree, AABB{{-100.0f, -100.0f}, {100.0f, 100.0f}}) ==
+                                                   std::vector<uint32_t>{b},
+              "rejected proxies changed the tree");
+    }
+}// namespace
+
+int main()
+{
+    TestRandomOperations();
+    TestSortedInsertion();
+    TestInvalidProxy();
+
+    if (s_Failed) { return 1; }
+    std::printf("AABB tree tests passed\n");
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include <LunaraEngine/Core/JobSystem.hpp>
+#include <atomic>
+#include <cstdio>
+#include <vector>
+
+using namespace LunaraEngine;
+
+namespace
+{
+    constexpr uint32_t WORKER_COUNT = 4;
+    constexpr size_t CHAIN_LENGTH = 10'000;
+    constexpr size_t CHAIN_COUNT = 8;
+    constexpr size_t FAN_OUT = 256;
+
+    bool s_Failed = false;
+
+    void Check(bool condition, const char* message)
+    {
+        if (condition) { return; }
+        std::printf("FAILED: %s\n", message);
+        s_Failed = true;
+    }
+
+    // Every job depends on the one before it, so they have to run strictly in order whatever worker picks them up
+    void TestChain()
+    {
+        std::vector<JobCounter> counters(CHAIN_LENGTH);
+        std::atomic<size_t> next{};
+        std::atomic<size_t> outOfOrder{};
+        for (size_t i = 0; i < CHAIN_LENGTH; i++)
+        {
+            JobSystem::Run(
+                    [&next, &outOfOrder, i]() {
+                        if (next.fetch_add(1, std::memory_order_acq_rel) != i) { outOfOrder++; }
+                    },
+                    &counters[i], i > 0 ? &counters[i - 1] : nullptr);
+        }
+        JobSystem::Wait(counters.back());
+
+        Check(next.load() == CHAIN_LENGTH, "chain did not run every job");
+        Check(outOfOrder.load() == 0, "chain ran jobs out of order");
+    }
+
+    // Chains are started from inside jobs on every worker and interleave with each other
+    void TestNestedChains()
+    {
+        std::vector<std::vector<JobCounter>> counters(CHAIN_COUNT);
+        std::vector<std::atomic<size_t>> progress(CHAIN_COUNT);
+        std::atomic<size_t> outOfOrder{};
+        JobCounter started;
+        for (size_t chain = 0; chain < CHAIN_COUNT; chain++)
+        {
+            counters[chain] = std::vector<JobCounter>(CHAIN_LENGTH / CHAIN_COUNT);
+            JobSystem::Run(
+                    [&, chain]() {
+                        auto& links = counters[chain];
+                        for (size_t i = 0; i < links.size(); i++)
+                        {
+                            JobSystem::Run(
+                                    [&, chain, i]() {
+                                        if (progress[chain].fetch_add(1, std::memory_order_acq_rel) != i)
+                                        {
+                                            outOfOrder++;
+                                        }
+                                    },
+                                    &links[i], i > 0 ? &links[i - 1] : nullptr);
+                        }
+                    },
+                    &started);
+        }
+        JobSystem::Wait(started);
+        for (auto& links: counters) { JobSystem::Wait(links.back()); }
+
+        for (auto& count: progress) { Check(count.load() == CHAIN_LENGTH / CHAIN_COUNT, "nested chain incomplete"); }
+        Check(outOfOrder.load() == 0, "nested chain ran jobs out of order");
+    }
+
+    // More jobs wait on a single slow job than there are workers, none of them may hold a worker while waiting
+    void TestFanOut()
+    {
+        JobCounter gate;
+        JobCounter dependents;
+        std::atomic<bool> gateDone{};
+        std::atomic<size_t> early{};
+        std::atomic<size_t> ran{};
+        JobSystem::Run(
+                [&gateDone]() {
+                    JobCounter inner;
+                    for (size_t i = 0; i < FAN_OUT; i++) { JobSystem::Run([]() {}, &inner); }
+                    JobSystem::Wait(inner);
+                    gateDone.store(true, std::memory_order_release);
+                },
+                &gate);
+        for (size_t i = 0; i < FAN_OUT; i++)
+        {
+            JobSystem::Run(
+                    [&]() {
+                        if (!gateDone.load(std::memory_order_acquire)) { early++; }
+                        ran++;
+                    },
+                    &dependents, &gate);
+        }
+        JobSystem::Wait(dependents);
+
+        Check(ran.load() == FAN_OUT, "dependent jobs did not all run");
+        Check(early.load() == 0, "dependent job started before its dependency finished");
+    }
+}// namespace
+
+int main()
+{
+    JobSystem::Init(WORKER_COUNT);
+    TestChain();
+    TestNestedChains();
+    TestFanOut();
+    JobSystem::Destroy();
+
+    if (s_Failed) { return 1; }
+    std::printf("Job system tests passed\n");
+    return 0;
+}
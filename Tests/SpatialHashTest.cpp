@@ -0,0 +1,168 @@
+#include <LunaraEngine/Physics/SpatialHash.hpp>
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace LunaraEngine;
+
+namespace
+{
+    constexpr size_t QUERY_COUNT = 200;
+    constexpr uint32_t LAYER_COUNT = 4;
+
+    bool s_Failed = false;
+
+    void Check(bool condition, const char* message)
+    {
+        if (condition) { return; }
+        std::printf("FAILED: %s\n", message);
+        s_Failed = true;
+    }
+
+    struct Scene {
+        std::vector<FRect> bounds;
+        std::vector<uint32_t> layers;
+        std::vector<uint32_t> masks;
+    };
+
+    // Integer coordinates make boxes that only touch common, touching boxes don't overlap
+    FRect MakeBox(std::mt19937& random, float extent, float maxSize)
+    {
+        std::uniform_int_distribution<int> position((int) -extent, (int) extent);
+        std::uniform_int_distribution<int> size(1, (int) maxSize);
+        return FRect{(float) position(random), (float) position(random), (float) size(random), (float) size(random)};
+    }
+
+    Scene MakeScene(std::mt19937& random, size_t count, float extent, float maxSize)
+    {
+        std::uniform_int_distribution<uint32_t> layer(0, LAYER_COUNT - 1);
+        std::uniform_int_distribution<uint32_t> mask(0, (1u << LAYER_COUNT) - 1);
+        Scene scene;
+        for (size_t i = 0; i < count; i++)
+        {
+            scene.bounds.push_back(MakeBox(random, extent, maxSize));
+            scene.layers.push_back(1u << layer(random));
+            scene.masks.push_back(mask(random));
+        }
+        return scene;
+    }
+
+    std::vector<std::pair<uint32_t, uint32_t>> FindPairsBruteForce(const Scene& scene)
+    {
+        std::vector<std::pair<uint32_t, uint32_t>> pairs;
+        for (uint32_t a = 0; a < (uint32_t) scene.bounds.size(); a++)
+        {
+            for (uint32_t b = a + 1; b < (uint32_t) scene.bounds.size(); b++)
+            {
+                if ((scene.masks[a] & scene.layers[b]) == 0 && (scene.masks[b] & scene.layers[a]) == 0) { continue; }
+                if (SpatialHash::Overlaps(scene.bounds[a], scene.bounds[b])) { pairs.emplace_back(a, b); }
+            }
+        }
+        return pairs;
+    }
+
+    std::vector<uint32_t> QueryRegionBruteForce(const Scene& scene, const FRect& region, uint32_t mask)
+    {
+        std::vector<uint32_t> bodies;
+        for (uint32_t body = 0; body < (uint32_t) scene.bounds.size(); body++)
+        {
+            if ((scene.layers[body] & mask) != 0 && SpatialHash::Overlaps(region, scene.bounds[body]))
+            {
+                bodies.push_back(body);
+            }
+        }
+        return bodies;
+    }
+
+    // Pairs have to be unique and ordered, so the sorted result has to equal the brute force one exactly
+    void CheckPairs(SpatialHash& hash, const Scene& scene, const char* message)
+    {
+        std::vector<BroadphasePair> found;
+        hash.FindPairs(found);
+        std::vector<std::pair<uint32_t, uint32_t>> pairs;
+        for (auto pair: found) { pairs.emplace_back(pair.a, pair.b); }
+        std::ranges::sort(pairs);
+        Check(pairs == FindPairsBruteForce(scene), message);
+    }
+
+    void CheckQueries(SpatialHash& hash, const Scene& scene, std::mt19937& random, float extent, float maxSize,
+                      const char* message)
+    {
+        std::uniform_int_distribution<uint32_t> mask(1, (1u << LAYER_COUNT) - 1);
+        std::vector<uint32_t> bodies;
+        bool matches = true;
+        for (size_t i = 0; i < QUERY_COUNT; i++)
+        {
+            FRect region = MakeBox(random, extent, maxSize);
+            uint32_t queryMask = i % 2 == 0 ? SpatialHash::ALL_LAYERS : mask(random);
+            hash.QueryRegion(region, bodies, queryMask);
+            std::ranges::sort(bodies);
+            matches = matches && bodies == QueryRegionBruteForce(scene, region, queryMask);
+        }
+        Check(matches, message);
+    }
+
+    void TestScene(float cellSize, size_t count, float extent, float maxSize, const char* pairsMessage,
+                   const char* queryMessage, uint32_t seed = 1234)
+    {
+        std::mt19937 random(seed);
+        Scene scene = MakeScene(random, count, extent, maxSize);
+        SpatialHash hash(cellSize);
+        hash.Insert(scene.bounds, scene.layers, scene.masks);
+        CheckPairs(hash, scene, pairsMessage);
+        CheckQueries(hash, scene, random, extent, maxSize * 2.0f, queryMessage);
+
+        // Moving every body rebuilds the buckets from scratch
+        Scene moved = MakeScene(random, count, extent, maxSize);
+        moved.layers = scene.layers;
+        moved.masks = scene.masks;
+        hash.Update(moved.bounds);
+        CheckPairs(hash, moved, pairsMessage);
+        CheckQueries(hash, moved, random, extent, maxSize * 2.0f, queryMessage);
+    }
+
+    void TestSmallBoxes()
+    {
+        TestScene(64.0f, 2000, 2048.0f, 48.0f, "pairs of small boxes differ from brute force",
+                  "region queries over small boxes differ from brute force");
+    }
+
+    // Every box covers dozens of cells, pairs meet in many buckets but have to be reported once
+    void TestLargeBoxes()
+    {
+        TestScene(16.0f, 300, 512.0f, 256.0f, "pairs of boxes spanning many cells differ from brute force",
+                  "region queries over boxes spanning many cells differ from brute force");
+    }
+
+    // Thousands of cells per box share a bucket table sized to the cell count, so distinct cells of one body and
+    // of unrelated bodies keep landing in the same buckets
+    void TestBucketCollisions()
+    {
+        TestScene(0.25f, 200, 64.0f, 12.0f, "pairs with colliding buckets differ from brute force",
+                  "region queries with colliding buckets differ from brute force");
+    }
+
+    // A handful of bodies keeps the table at its minimum size, the few cells of a single body regularly share a
+    // bucket and must still list the body there once
+    void TestMinimumTable()
+    {
+        for (uint32_t seed = 0; seed < 100; seed++)
+        {
+            TestScene(1.0f, 3, 4.0f, 2.0f, "pairs in the minimum bucket table differ from brute force",
+                      "region queries in the minimum bucket table differ from brute force", seed);
+        }
+    }
+}// namespace
+
+int main()
+{
+    TestSmallBoxes();
+    TestLargeBoxes();
+    TestBucketCollisions();
+    TestMinimumTable();
+
+    if (s_Failed) { return 1; }
+    std::printf("Spatial hash tests passed\n");
+    return 0;
+}
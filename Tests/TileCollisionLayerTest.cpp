@@ -0,0 +1,334 @@
+#include <LunaraEngine/Physics/TileCollisionLayer.hpp>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using namespace LunaraEngine;
+
+namespace
+{
+    constexpr float TILE_SIZE = 16.0f;
+    const glm::vec2 ORIGIN{-40.0f, 24.0f};
+
+    bool s_Failed = false;
+
+    void Check(bool condition, const char* message)
+    {
+        if (condition) { return; }
+        std::printf("FAILED: %s\n", message);
+        s_Failed = true;
+    }
+
+    bool Near(float a, float b) { return std::abs(a - b) <= 1e-3f; }
+
+    // Boxes and points are written in tiles and converted to the world space of the layer
+    glm::vec2 ToWorld(glm::vec2 tiles) { return ORIGIN + tiles * TILE_SIZE; }
+
+    AABB TileBox(float minX, float minY, float maxX, float maxY)
+    {
+        return AABB{ToWorld({minX, minY}), ToWorld({maxX, maxY})};
+    }
+
+    // Rows wider than a word, so runs and walls can sit on both sides of every word boundary
+    constexpr uint32_t WIDTH = 200;
+    constexpr uint32_t HEIGHT = 40;
+
+    class Reference
+    {
+    public:
+        Reference() : m_Solid((size_t) WIDTH * HEIGHT) {}
+
+    public:
+        void Set(uint32_t x, uint32_t y, uint32_t width, uint32_t height, bool solid)
+        {
+            for (uint32_t row = y; row < std::min(y + height, HEIGHT); row++)
+            {
+                for (uint32_t column = x; column < std::min(x + width, WIDTH); column++)
+                {
+                    m_Solid[(size_t) row * WIDTH + column] = solid;
+                }
+            }
+        }
+
+        [[nodiscard]] bool IsSolid(int64_t x, int64_t y) const
+        {
+            return x >= 0 && y >= 0 && x < WIDTH && y < HEIGHT && m_Solid[(size_t) y * WIDTH + (size_t) x];
+        }
+
+        // Tile by tile over the half open extent of the box, in tiles
+        [[nodiscard]] bool Overlaps(glm::vec2 min, glm::vec2 max) const
+        {
+            for (auto y = (int64_t) std::floor(min.y); (float) y < max.y; y++)
+            {
+                for (auto x = (int64_t) std::floor(min.x); (float) x < max.x; x++)
+                {
+                    if (IsSolid(x, y)) { return true; }
+                }
+            }
+            return false;
+        }
+
+    private:
+        std::vector<bool> m_Solid;
+    };
+
+    // Runs are set and cleared word at a time, every tile has to match a plain per tile grid afterwards
+    void TestWordBoundaries()
+    {
+        TileCollisionLayer layer(WIDTH, HEIGHT, TILE_SIZE, ORIGIN);
+        Reference reference;
+
+        const uint32_t edges[] = {0, 1, 62, 63, 64, 65, 126, 127, 128, 129, 191, 192, 199};
+        std::mt19937 random(99);
+        std::uniform_int_distribution<size_t> edge(0, std::size(edges) - 1);
+        std::uniform_int_distribution<uint32_t> row(0, HEIGHT - 1);
+        std::uniform_int_distribution<uint32_t> rows(1, 4);
+        bool tilesMatch = true;
+        bool overlapsMatch = true;
+        for (size_t i = 0; i < 500; i++)
+        {
+            uint32_t x = edges[edge(random)];
+            uint32_t width = edges[edge(random)] + 1;
+            uint32_t y = row(random);
+            uint32_t height = rows(random);
+            bool solid = i % 3 != 2;
+            layer.SetSolid(x, y, width, height, solid);
+            reference.Set(x, y, width, height, solid);
+
+            for (uint32_t ty = 0; ty < HEIGHT; ty++)
+            {
+                for (uint32_t tx = 0; tx < WIDTH; tx++)
+                {
+                    tilesMatch = tilesMatch && layer.IsSolid(tx, ty) == reference.IsSolid(tx, ty);
+                }
+            }
+
+            // Boxes start and end on the word boundaries, on tile edges and between them
+            for (size_t j = 0; j < 8; j++)
+            {
+                float minX = (float) edges[edge(random)] + (j % 2 == 0 ? 0.0f : 0.5f);
+                float maxX = minX + (float) edges[edge(random)] * 0.5f + 0.5f;
+                float minY = (float) row(random) + (j % 4 < 2 ? 0.0f : 0.25f);
+                float maxY = minY + (float) rows(random);
+                overlapsMatch = overlapsMatch && layer.Overlaps(TileBox(minX, minY, maxX, maxY)) ==
+                                                         reference.Overlaps({minX, minY}, {maxX, maxY});
+            }
+        }
+        Check(tilesMatch, "word wise SetSolid differs from a per tile grid");
+        Check(overlapsMatch, "Overlaps differs from a per tile check");
+
+        // A single wall tile on each side of a word boundary stops boxes coming from either direction
+        const uint32_t walls[] = {63, 64, 127, 128};
+        bool stopped = true;
+        for (uint32_t wall: walls)
+        {
+            layer.Clear();
+            layer.SetSolid(wall, 5, true);
+
+            AABB left = TileBox((float) wall - 10.5f, 5.25f, (float) wall - 10.0f, 5.75f);
+            TileSweepResult right = layer.Sweep(left, glm::vec2{30.0f * TILE_SIZE, 0.0f});
+            float wallMin = ToWorld({(float) wall, 0.0f}).x;
+            stopped = stopped && right.hitX && Near(left.max.x + right.displacement.x, wallMin);
+
+            AABB beyond = TileBox((float) wall + 11.0f, 5.25f, (float) wall + 11.5f, 5.75f);
+            TileSweepResult back = layer.Sweep(beyond, glm::vec2{-30.0f * TILE_SIZE, 0.0f});
+            stopped = stopped && back.hitX && Near(beyond.min.x + back.displacement.x, wallMin + TILE_SIZE);
+
+            // A box spanning the boundary moving down finds the wall through either word of the row
+            AABB above = TileBox((float) wall - 0.5f, 1.0f, (float) wall + 0.5f, 2.0f);
+            TileSweepResult down = layer.Sweep(above, glm::vec2{0.0f, 10.0f * TILE_SIZE});
+            stopped = stopped && down.hitY && Near(above.max.y + down.displacement.y, ToWorld({0, 5.0f}).y);
+        }
+        Check(stopped, "walls next to a word boundary did not stop the box");
+
+        // A box spanning several rows stops at the nearest wall of any row, the nearest one is in the first row
+        // scanned so the later rows must not move the stop further out
+        layer.Clear();
+        layer.SetSolid(63, 5, true);
+        layer.SetSolid(64, 6, true);
+        layer.SetSolid(128, 7, true);
+        AABB tall = TileBox(10.0f, 5.0f, 11.0f, 8.0f);
+        TileSweepResult right = layer.Sweep(tall, glm::vec2{150.0f * TILE_SIZE, 0.0f});
+        Check(right.hitX && Near(tall.max.x + right.displacement.x, ToWorld({63.0f, 0.0f}).x),
+              "box spanning several rows passed the nearest wall moving right");
+
+        layer.Clear();
+        layer.SetSolid(128, 5, true);
+        layer.SetSolid(64, 6, true);
+        layer.SetSolid(63, 7, true);
+        AABB tallBeyond = TileBox(180.0f, 5.0f, 181.0f, 8.0f);
+        TileSweepResult left = layer.Sweep(tallBeyond, glm::vec2{-150.0f * TILE_SIZE, 0.0f});
+        Check(left.hitX && Near(tallBeyond.min.x + left.displacement.x, ToWorld({129.0f, 0.0f}).x),
+              "box spanning several rows passed the nearest wall moving left");
+        layer.SetSolid(128, 5, false);
+        TileSweepResult leftPastFar = layer.Sweep(tallBeyond, glm::vec2{-150.0f * TILE_SIZE, 0.0f});
+        Check(leftPastFar.hitX && Near(tallBeyond.min.x + leftPastFar.displacement.x, ToWorld({65.0f, 0.0f}).x),
+              "box spanning several rows passed the nearest wall across a word boundary");
+    }
+
+    // A box resting on the floor must neither count as overlapping it nor stick to it when moving sideways
+    void TestRestingOnEdge()
+    {
+        TileCollisionLayer layer(WIDTH, HEIGHT, TILE_SIZE, ORIGIN);
+        layer.SetSolid(0, 10, WIDTH, 1, true);
+
+        AABB resting = TileBox(20.0f, 9.0f, 21.0f, 10.0f);
+        Check(!layer.Overlaps(resting), "box ending on the floor edge overlaps the floor");
+
+        TileSweepResult fall = layer.Sweep(resting, glm::vec2{0.0f, 4.0f});
+        Check(fall.hitY && fall.displacement.y == 0.0f, "box resting on the floor moved into it");
+
+        TileSweepResult slide = layer.Sweep(resting, glm::vec2{40.0f, 0.0f});
+        Check(!slide.hitX && slide.displacement.x == 40.0f, "box resting on the floor cannot slide along it");
+
+        // Sinking less than the tolerance is treated as resting, the box can still slide and jump off
+        AABB sunk = resting;
+        sunk.min.y += TILE_SIZE / 2048.0f;
+        sunk.max.y += TILE_SIZE / 2048.0f;
+        Check(!layer.Overlaps(sunk), "box within the edge tolerance overlaps the floor");
+        TileSweepResult sunkSlide = layer.Sweep(sunk, glm::vec2{-40.0f, 0.0f});
+        Check(!sunkSlide.hitX && sunkSlide.displacement.x == -40.0f, "box within the edge tolerance sticks");
+        TileSweepResult sunkFall = layer.Sweep(sunk, glm::vec2{0.0f, 4.0f});
+        Check(sunkFall.hitY && sunkFall.displacement.y == 0.0f, "box within the edge tolerance sank further");
+        TileSweepResult jump = layer.Sweep(sunk, glm::vec2{0.0f, -20.0f});
+        Check(!jump.hitY && jump.displacement.y == -20.0f, "box within the edge tolerance cannot jump off");
+
+        // Sinking further than the tolerance is an overlap
+        AABB deep = resting;
+        deep.max.y += TILE_SIZE / 256.0f;
+        Check(layer.Overlaps(deep), "box sunk past the edge tolerance does not overlap the floor");
+
+        // Positions accumulated in small steps land next to the edge rather than on it, a tile size that is not a
+        // power of two makes the rounding visible
+        TileCollisionLayer uneven(WIDTH, HEIGHT, 0.3f, {0.1f, 0.7f});
+        uneven.SetSolid(0, 10, WIDTH, 1, true);
+        AABB box{{3.0f, 0.9f}, {3.2f, 1.1f}};
+        bool landed = false;
+        bool sunkIn = false;
+        bool stuck = false;
+        for (int frame = 0; frame < 400; frame++)
+        {
+            TileSweepResult result = uneven.Sweep(box, glm::vec2{0.013f, 0.017f});
+            box.min += result.displacement;
+            box.max += result.displacement;
+            landed = landed || result.hitY;
+            sunkIn = sunkIn || uneven.Overlaps(box);
+            stuck = stuck || result.hitX;
+        }
+        Check(landed, "box falling in many small steps never reached the floor");
+        Check(!sunkIn, "box landing after many small steps ends up inside the floor");
+        Check(!stuck, "box landing after many small steps stuck to the floor");
+    }
+
+    // A box much thinner than the wall it moves through in one step still stops at the wall
+    void TestTunnelling()
+    {
+        TileCollisionLayer layer(WIDTH, HEIGHT, TILE_SIZE, ORIGIN);
+        layer.SetSolid(100, 0, 1, HEIGHT, true);
+        layer.SetSolid(0, 30, WIDTH, 1, true);
+
+        AABB box = TileBox(10.0f, 5.4f, 10.1f, 5.5f);
+        TileSweepResult right = layer.Sweep(box, glm::vec2{1000.0f * TILE_SIZE, 0.0f});
+        Check(right.hitX && Near(box.max.x + right.displacement.x, ToWorld({100.0f, 0}).x),
+              "fast box tunnelled through a wall moving right");
+
+        AABB far = TileBox(190.0f, 5.4f, 190.1f, 5.5f);
+        TileSweepResult left = layer.Sweep(far, glm::vec2{-1000.0f * TILE_SIZE, 0.0f});
+        Check(left.hitX && Near(far.min.x + left.displacement.x, ToWorld({101.0f, 0}).x),
+              "fast box tunnelled through a wall moving left");
+
+        TileSweepResult down = layer.Sweep(box, glm::vec2{0.0f, 1000.0f * TILE_SIZE});
+        Check(down.hitY && Near(box.max.y + down.displacement.y, ToWorld({0, 30.0f}).y),
+              "fast box tunnelled through a floor moving down");
+
+        AABB below = TileBox(10.0f, 35.0f, 10.1f, 35.1f);
+        TileSweepResult up = layer.Sweep(below, glm::vec2{0.0f, -1000.0f * TILE_SIZE});
+        Check(up.hitY && Near(below.min.y + up.displacement.y, ToWorld({0, 31.0f}).y),
+              "fast box tunnelled through a ceiling moving up");
+
+        // Both axes at once, x is resolved first and stops at the wall before y drops onto the floor
+        TileSweepResult diagonal = layer.Sweep(box, glm::vec2{1000.0f, 1000.0f} * TILE_SIZE);
+        Check(diagonal.hitX && diagonal.hitY && Near(box.max.x + diagonal.displacement.x, ToWorld({100.0f, 0}).x) &&
+                      Near(box.max.y + diagonal.displacement.y, ToWorld({0, 30.0f}).y),
+              "fast diagonal box tunnelled through the wall or the floor");
+
+        TileRayHit hit;
+        Check(layer.RayCast(ToWorld({10.5f, 5.5f}), glm::vec2{1000.0f * TILE_SIZE, 0.0f}, hit) && hit.x == 100 &&
+                      Near(hit.point.x, ToWorld({100.0f, 0}).x),
+              "long ray tunnelled through a wall");
+    }
+
+    // Boxes and rays coming from outside the grid enter it and stop at the first solid tile, outside tiles are empty
+    void TestOutsideGrid()
+    {
+        TileCollisionLayer layer(WIDTH, HEIGHT, TILE_SIZE, ORIGIN);
+        layer.SetSolid(3, 0, 1, HEIGHT, true);
+        layer.SetSolid(WIDTH - 4, 0, 1, HEIGHT, true);
+        layer.SetSolid(0, 3, WIDTH, 1, true);
+        layer.SetSolid(0, HEIGHT - 4, WIDTH, 1, true);
+
+        AABB west = TileBox(-20.0f, 10.25f, -19.5f, 10.75f);
+        TileSweepResult east = layer.Sweep(west, glm::vec2{40.0f * TILE_SIZE, 0.0f});
+        Check(east.hitX && Near(west.max.x + east.displacement.x, ToWorld({3.0f, 0}).x),
+              "SweepX from left of the grid missed the first wall");
+
+        AABB eastBox = TileBox(WIDTH + 20.0f, 10.25f, WIDTH + 20.5f, 10.75f);
+        TileSweepResult westward = layer.Sweep(eastBox, glm::vec2{-40.0f * TILE_SIZE, 0.0f});
+        Check(westward.hitX && Near(eastBox.min.x + westward.displacement.x, ToWorld({WIDTH - 3.0f, 0}).x),
+              "SweepX from right of the grid missed the last wall");
+
+        AABB north = TileBox(10.25f, -20.0f, 10.75f, -19.5f);
+        TileSweepResult south = layer.Sweep(north, glm::vec2{0.0f, 40.0f * TILE_SIZE});
+        Check(south.hitY && Near(north.max.y + south.displacement.y, ToWorld({0, 3.0f}).y),
+              "SweepY from above the grid missed the first floor");
+
+        AABB southBox = TileBox(10.25f, HEIGHT + 20.0f, 10.75f, HEIGHT + 20.5f);
+        TileSweepResult northward = layer.Sweep(southBox, glm::vec2{0.0f, -40.0f * TILE_SIZE});
+        Check(northward.hitY && Near(southBox.min.y + northward.displacement.y, ToWorld({0, HEIGHT - 3.0f}).y),
+              "SweepY from below the grid missed the last floor");
+
+        // Motion that stays outside the grid or ends before the wall is never blocked
+        TileSweepResult outside = layer.Sweep(north, glm::vec2{500.0f, -500.0f});
+        Check(!outside.hitX && !outside.hitY, "sweep outside the grid was blocked");
+        TileSweepResult early = layer.Sweep(west, glm::vec2{10.0f * TILE_SIZE, 0.0f});
+        Check(!early.hitX && early.displacement.x == 10.0f * TILE_SIZE, "sweep ending before the grid was blocked");
+
+        TileRayHit hit;
+        Check(layer.RayCast(ToWorld({-20.0f, 10.5f}), glm::vec2{40.0f * TILE_SIZE, 0.0f}, hit) && hit.x == 3 &&
+                      hit.y == 10 && hit.normal == glm::vec2{-1.0f, 0.0f} && Near(hit.fraction, 23.0f / 40.0f),
+              "ray from left of the grid missed the first wall");
+        Check(layer.RayCast(ToWorld({WIDTH + 20.0f, 10.5f}), glm::vec2{-40.0f * TILE_SIZE, 0.0f}, hit) &&
+                      hit.x == WIDTH - 4 && hit.normal == glm::vec2{1.0f, 0.0f},
+              "ray from right of the grid missed the last wall");
+        Check(layer.RayCast(ToWorld({10.5f, -20.0f}), glm::vec2{0.0f, 40.0f * TILE_SIZE}, hit) && hit.y == 3 &&
+                      hit.normal == glm::vec2{0.0f, -1.0f},
+              "ray from above the grid missed the first floor");
+        Check(layer.RayCast(ToWorld({-10.5f, -9.5f}), glm::vec2{30.0f, 30.0f} * TILE_SIZE, hit) &&
+                      ((hit.x == 3 && hit.normal.x == -1.0f) || (hit.y == 3 && hit.normal.y == -1.0f)),
+              "diagonal ray from outside the grid missed the corner walls");
+
+        Check(!layer.RayCast(ToWorld({-20.0f, 10.5f}), glm::vec2{-40.0f * TILE_SIZE, 0.0f}, hit),
+              "ray leaving the grid hit a tile");
+        Check(!layer.RayCast(ToWorld({-20.0f, -20.0f}), glm::vec2{40.0f * TILE_SIZE, 0.0f}, hit),
+              "ray passing above the grid hit a tile");
+        Check(!layer.RayCast(ToWorld({-20.0f, 10.5f}), glm::vec2{20.0f * TILE_SIZE, 0.0f}, hit),
+              "ray ending before the grid hit a tile");
+
+        Check(layer.RayCast(ToWorld({3.5f, 10.5f}), glm::vec2{10.0f, 0.0f}, hit) && hit.fraction == 0.0f &&
+                      hit.normal == glm::vec2{0.0f},
+              "ray starting inside a solid tile did not hit at its origin");
+    }
+}// namespace
+
+int main()
+{
+    TestWordBoundaries();
+    TestRestingOnEdge();
+    TestTunnelling();
+    TestOutsideGrid();
+
+    if (s_Failed) { return 1; }
+    std::printf("Tile collision layer tests passed\n");
+    return 0;
+}
@@ -19,13 +19,11 @@ def compile_shader(project_root, shader_name, version_name):
     print(f"🎯 Compiling shader stages for {shader_base}...")
     
     glslc_path = Path(f"{project_root}/Vendor/vulkan/{version_name}/x86_64/bin/glslc")
-    vertex_shader = Path(project_root + f"/Assets/Shaders/{shader_base}.vert")
-    fragment_shader = Path(project_root + f"/Assets/Shaders/{shader_base}.frag")
-    vertex_output = Path(project_root + f"/Assets/Shaders/bin/{shader_base}.vert.spv")
-    fragment_output = Path(project_root + f"/Assets/Shaders/bin/{shader_base}.frag.spv")
-    
-    subprocess.run([str(glslc_path), "-O", str(vertex_shader), "-o", str(vertex_output)])
-    subprocess.run([str(glslc_path), "-O", str(fragment_shader), "-o", str(fragment_output)])
+    for stage in ("vert", "frag", "comp"):
+        stage_shader = Path(project_root + f"/Assets/Shaders/{shader_base}.{stage}")
+        stage_output = Path(project_root + f"/Assets/Shaders/bin/{shader_base}.{stage}.spv")
+        if stage_shader.is_file():
+            subprocess.run([str(glslc_path), "-O", str(stage_shader), "-o", str(stage_output)])
 
 def compile_shaders(project_root, version_name):
     """Compile all shaders in the project root."""
@@ -33,7 +31,7 @@ def compile_shaders(project_root, version_name):
     bin_dir.mkdir(parents=True, exist_ok=True)
 
     print("🛠️ Starting shader compilation...")
-    shader_files = list(Path(project_root + "/Assets/Shaders").glob("*.frag")) + list(Path(project_root + "/Assets/Shaders").glob("*.vert"))
+    shader_files = list(Path(project_root + "/Assets/Shaders").glob("*.frag")) + list(Path(project_root + "/Assets/Shaders").glob("*.vert")) + list(Path(project_root + "/Assets/Shaders").glob("*.comp"))
     for shader_file in shader_files:
         if shader_file.is_file():
             print(f"🔹 Compiling {shader_file.name}")
@@ -69,7 +67,7 @@ def main():
     print("🚀 Compiling shaders")
 
     # List shader files
-    shader_files = list(Path(project_root + "/Assets/Shaders").glob("*.frag")) + list(Path(project_root + "/Assets/Shaders").glob("*.vert"))
+    shader_files = list(Path(project_root + "/Assets/Shaders").glob("*.frag")) + list(Path(project_root + "/Assets/Shaders").glob("*.vert")) + list(Path(project_root + "/Assets/Shaders").glob("*.comp"))
     if not shader_files:
         print("No shader files found.")
     else:
@@ -8,8 +8,11 @@ compile_shader() {
     local shader_base="${shader_name%.*}"  # Remove extension
 
     echo "🎯 Compiling shader stages for $shader_base..."
-    "$HOME/vulkan/$versionName/x86_64/bin/glslc" -O "$project_root/Assets/Shaders/$shader_base.vert" -o "$project_root/Assets/Shaders/bin/$shader_base.vert.spv"
-    "$HOME/vulkan/$versionName/x86_64/bin/glslc" -O "$project_root/Assets/Shaders/$shader_base.frag" -o "$project_root/Assets/Shaders/bin/$shader_base.frag.spv"
+    for stage in vert frag comp; do
+        if [ -f "$project_root/Assets/Shaders/$shader_base.$stage" ]; then
+            "$HOME/vulkan/$versionName/x86_64/bin/glslc" -O "$project_root/Assets/Shaders/$shader_base.$stage" -o "$project_root/Assets/Shaders/bin/$shader_base.$stage.spv"
+        fi
+    done
 }
 
 compile_shaders() {
@@ -17,7 +20,7 @@ compile_shaders() {
     mkdir -p "$project_root/Assets/Shaders/bin"
 
     echo "🛠️ Starting shader compilation..."
-    for file in "$project_root/Assets/Shaders/"*.{frag,vert}; do
+    for file in "$project_root/Assets/Shaders/"*.{frag,vert,comp}; do
         if [ -f "$file" ]; then
             shader_file="$(basename "$file")"
             echo "🔹 Compiling $shader_file"
@@ -36,7 +39,7 @@ if [ -z "$1" ]; then
 fi
 
 echo "📂 Files found:"
-ls "$1/Assets/Shaders/"*.{frag,vert} 2>/dev/null || echo "No shader files found."
+ls "$1/Assets/Shaders/"*.{frag,vert,comp} 2>/dev/null || echo "No shader files found."
 
 compile_shaders "$1"
 